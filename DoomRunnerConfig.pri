@@ -0,0 +1,68 @@
+#-------------------------------------------------
+#
+# Build configuration shared by the application and the tests
+#
+#-------------------------------------------------
+
+#-- compiler options -----------------------------
+
+CONFIG += c++17
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which has been marked as deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+#DEFINES += QT_DEPRECATED_WARNINGS
+QMAKE_CXXFLAGS += -Wno-deprecated-declarations  # commenting-out the above doesn't work
+
+# You can also make your code fail to compile if you use deprecated APIs.
+# In order to do so, uncomment the following line.
+# You can also select to disable deprecated APIs only up to a certain version of Qt.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+# Some Qt headers use deprecated C++ features and generate tons of warnings.
+# This will silence them and prevent them from shadowing our own potentially important warnings.
+QMAKE_CXXFLAGS += -Wno-deprecated-copy
+QMAKE_CXXFLAGS += -Wno-attributes
+
+QMAKE_CXXFLAGS += -Wno-comment
+
+INCLUDEPATH += $$PWD/Sources
+
+
+#-- build type variables -------------------------
+
+CONFIG(debug, debug|release) {
+	DEFINES += DEBUG
+	DEFINES += IS_DEBUG_BUILD=true
+} else {
+	DEFINES += NDEBUG  # to disable asserts
+	DEFINES += IS_DEBUG_BUILD=false
+}
+
+win32 {
+	DEFINES += IS_WINDOWS=true
+	DEFINES += IS_MACOS=false
+} else: macx {
+	DEFINES += IS_WINDOWS=false
+	DEFINES += IS_MACOS=true
+} else {
+	DEFINES += IS_WINDOWS=false
+	DEFINES += IS_MACOS=false
+}
+
+
+#-- libraries ------------------------------------
+
+win32: LIBS += -lole32 -luuid -ldwmapi -lversion
+
+
+#-- user configuration ---------------------------
+
+# add "CONFIG+=flatpak" to the qmake command to activate this
+flatpak {
+	DEFINES += FLATPAK_BUILD
+	DEFINES += IS_FLATPAK_BUILD=true
+} else {
+	DEFINES += IS_FLATPAK_BUILD=false
+}
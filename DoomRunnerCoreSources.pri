@@ -0,0 +1,69 @@
+#-------------------------------------------------
+#
+# Sources that don't depend on Qt Widgets: the launch command generation and everything it needs.
+# They are shared by the application and the tests, the tests that don't need the GUI link only these.
+#
+#-------------------------------------------------
+
+HEADERS += \
+	$$PWD/Sources/DataModels/AModelItem.hpp \
+	$$PWD/Sources/Utils/AsyncPathChecker.hpp \
+	$$PWD/Sources/Utils/ContainerUtils.hpp \
+	$$PWD/Sources/Utils/DoomModBundles.hpp \
+	$$PWD/Sources/Utils/EnumTraits.hpp \
+	$$PWD/Sources/Utils/ErrorHandling.hpp \
+	$$PWD/Sources/Utils/ExeReader.hpp \
+	$$PWD/Sources/Utils/ExeReaderTypes.hpp \
+	$$PWD/Sources/Utils/FileInfoCache.hpp \
+	$$PWD/Sources/Utils/FileInfoCacheTypes.hpp \
+	$$PWD/Sources/Utils/FileSystemUtils.hpp \
+	$$PWD/Sources/Utils/FileSystemUtilsTypes.hpp \
+	$$PWD/Sources/Utils/JsonUtils.hpp \
+	$$PWD/Sources/Utils/LangUtils.hpp \
+	$$PWD/Sources/Utils/MiscUtils.hpp \
+	$$PWD/Sources/Utils/OSUtils.hpp \
+	$$PWD/Sources/Utils/OSUtilsTypes.hpp \
+	$$PWD/Sources/Utils/PtrList.hpp \
+	$$PWD/Sources/Utils/StringUtils.hpp \
+	$$PWD/Sources/Utils/TrigramIndex.hpp \
+	$$PWD/Sources/Utils/TypeTraits.hpp \
+	$$PWD/Sources/Utils/Version.hpp \
+	$$PWD/Sources/Utils/WADReader.hpp \
+	$$PWD/Sources/Utils/WADReaderTypes.hpp \
+	$$PWD/Sources/Utils/WindowsUtils.hpp \
+	$$PWD/Sources/CommonTypes.hpp \
+	$$PWD/Sources/DoomFiles.hpp \
+	$$PWD/Sources/EngineTraits.hpp \
+	$$PWD/Sources/Essential.hpp \
+	$$PWD/Sources/LaunchCommandBuilder.hpp \
+	$$PWD/Sources/LaunchStatistics.hpp \
+	$$PWD/Sources/UserData.hpp \
+
+SOURCES += \
+	$$PWD/Sources/Utils/AsyncPathChecker.cpp \
+	$$PWD/Sources/Utils/ContainerUtils.cpp \
+	$$PWD/Sources/Utils/DoomModBundles.cpp \
+	$$PWD/Sources/Utils/ErrorHandling.cpp \
+	$$PWD/Sources/Utils/ExeReader.cpp \
+	$$PWD/Sources/Utils/ExeReaderTypes.cpp \
+	$$PWD/Sources/Utils/FileInfoCache.cpp \
+	$$PWD/Sources/Utils/FileInfoCacheTypes.cpp \
+	$$PWD/Sources/Utils/FileSystemUtils.cpp \
+	$$PWD/Sources/Utils/FileSystemUtilsTypes.cpp \
+	$$PWD/Sources/Utils/LangUtils.cpp \
+	$$PWD/Sources/Utils/JsonUtils.cpp \
+	$$PWD/Sources/Utils/MiscUtils.cpp \
+	$$PWD/Sources/Utils/OSUtils.cpp \
+	$$PWD/Sources/Utils/OSUtilsTypes.cpp \
+	$$PWD/Sources/Utils/PtrList.cpp \
+	$$PWD/Sources/Utils/StringUtils.cpp \
+	$$PWD/Sources/Utils/TrigramIndex.cpp \
+	$$PWD/Sources/Utils/TypeTraitsTest.cpp \
+	$$PWD/Sources/Utils/Version.cpp \
+	$$PWD/Sources/Utils/WADReader.cpp \
+	$$PWD/Sources/Utils/WADReaderTypes.cpp \
+	$$PWD/Sources/Utils/WindowsUtils.cpp \
+	$$PWD/Sources/DoomFiles.cpp \
+	$$PWD/Sources/EngineTraits.cpp \
+	$$PWD/Sources/LaunchCommandBuilder.cpp \
+	$$PWD/Sources/LaunchStatistics.cpp \
@@ -0,0 +1,99 @@
+#-------------------------------------------------
+#
+# Sources of the user interface shared by the application and the tests, everything except main.cpp,
+# the rest is in DoomRunnerCoreSources.pri
+#
+#-------------------------------------------------
+
+HEADERS += \
+	$$PWD/Sources/DataModels/GenericListModel.hpp \
+	$$PWD/Sources/DataModels/MapPackTreeModel.hpp \
+	$$PWD/Sources/DataModels/ModelCommon.hpp \
+	$$PWD/Sources/Dialogs/AboutDialog.hpp \
+	$$PWD/Sources/Dialogs/CompatOptsDialog.hpp \
+	$$PWD/Sources/Dialogs/DialogCommon.hpp \
+    $$PWD/Sources/Dialogs/DMBEditor.hpp \
+	$$PWD/Sources/Dialogs/EngineDialog.hpp \
+	$$PWD/Sources/Dialogs/GameOptsDialog.hpp \
+	$$PWD/Sources/Dialogs/LaunchStatsDialog.hpp \
+	$$PWD/Sources/Dialogs/NewConfigDialog.hpp \
+	$$PWD/Sources/Dialogs/OptionsStorageDialog.hpp \
+	$$PWD/Sources/Dialogs/OwnFileDialog.hpp \
+	$$PWD/Sources/Dialogs/ProcessOutputWindow.hpp \
+	$$PWD/Sources/Dialogs/SetupDialog.hpp \
+	$$PWD/Sources/Dialogs/WADDescViewer.hpp \
+	$$PWD/Sources/Utils/BulkFileImporter.hpp \
+	$$PWD/Sources/Utils/EventFilters.hpp \
+	$$PWD/Sources/Utils/FileCacheWarmer.hpp \
+	$$PWD/Sources/Utils/FileIconProvider.hpp \
+	$$PWD/Sources/Utils/PathCheckUtils.hpp \
+	$$PWD/Sources/Utils/StandardOutput.hpp \
+	$$PWD/Sources/Utils/TimeStats.hpp \
+	$$PWD/Sources/Utils/WidgetUtils.hpp \
+	$$PWD/Sources/Widgets/CachingItemDelegate.hpp \
+	$$PWD/Sources/Widgets/ExtendedListView.hpp \
+	$$PWD/Sources/Widgets/ExtendedTreeView.hpp \
+	$$PWD/Sources/Widgets/ExtendedViewCommon.hpp \
+	$$PWD/Sources/Widgets/ExtendedViewCommon.impl.hpp \
+	$$PWD/Sources/Widgets/FuzzySearchPanel.hpp \
+	$$PWD/Sources/Widgets/RightClickableLabel.hpp \
+	$$PWD/Sources/Widgets/RightClickableButton.hpp \
+	$$PWD/Sources/Widgets/RightClickableWidget.hpp \
+	$$PWD/Sources/Widgets/RightClickableWidget.impl.hpp \
+	$$PWD/Sources/Widgets/SearchPanel.hpp \
+	$$PWD/Sources/AppVersion.hpp \
+	$$PWD/Sources/MainWindowPtr.hpp \
+	$$PWD/Sources/MainWindow.hpp \
+	$$PWD/Sources/OptionsSerializer.hpp \
+	$$PWD/Sources/Themes.hpp \
+	$$PWD/Sources/UpdateChecker.hpp \
+
+SOURCES += \
+	$$PWD/Sources/DataModels/GenericListModel.cpp \
+	$$PWD/Sources/DataModels/MapPackTreeModel.cpp \
+	$$PWD/Sources/Dialogs/AboutDialog.cpp \
+	$$PWD/Sources/Dialogs/CompatOptsDialog.cpp \
+	$$PWD/Sources/Dialogs/DialogCommon.cpp \
+    $$PWD/Sources/Dialogs/DMBEditor.cpp \
+	$$PWD/Sources/Dialogs/EngineDialog.cpp \
+	$$PWD/Sources/Dialogs/GameOptsDialog.cpp \
+	$$PWD/Sources/Dialogs/LaunchStatsDialog.cpp \
+	$$PWD/Sources/Dialogs/NewConfigDialog.cpp \
+	$$PWD/Sources/Dialogs/OptionsStorageDialog.cpp \
+	$$PWD/Sources/Dialogs/OwnFileDialog.cpp \
+	$$PWD/Sources/Dialogs/ProcessOutputWindow.cpp \
+	$$PWD/Sources/Dialogs/SetupDialog.cpp \
+	$$PWD/Sources/Dialogs/WADDescViewer.cpp \
+	$$PWD/Sources/Utils/BulkFileImporter.cpp \
+	$$PWD/Sources/Utils/EventFilters.cpp \
+	$$PWD/Sources/Utils/FileCacheWarmer.cpp \
+	$$PWD/Sources/Utils/FileIconProvider.cpp \
+	$$PWD/Sources/Utils/PathCheckUtils.cpp \
+	$$PWD/Sources/Utils/StandardOutput.cpp \
+	$$PWD/Sources/Utils/WidgetUtils.cpp \
+	$$PWD/Sources/Widgets/CachingItemDelegate.cpp \
+	$$PWD/Sources/Widgets/ExtendedListView.cpp \
+	$$PWD/Sources/Widgets/ExtendedTreeView.cpp \
+	$$PWD/Sources/Widgets/FuzzySearchPanel.cpp \
+	$$PWD/Sources/Widgets/RightClickableLabel.cpp \
+	$$PWD/Sources/Widgets/RightClickableButton.cpp \
+	$$PWD/Sources/Widgets/SearchPanel.cpp \
+	$$PWD/Sources/MainWindow.cpp \
+	$$PWD/Sources/OptionsSerializer.cpp \
+	$$PWD/Sources/Themes.cpp \
+	$$PWD/Sources/UpdateChecker.cpp \
+	$$PWD/Sources/UserData.cpp \
+
+FORMS += \
+	$$PWD/Forms/AboutDialog.ui \
+	$$PWD/Forms/CompatOptsDialog.ui \
+    $$PWD/Forms/DMBEditor.ui \
+	$$PWD/Forms/EngineDialog.ui \
+	$$PWD/Forms/GameOptsDialog.ui \
+	$$PWD/Forms/LaunchStatsDialog.ui \
+	$$PWD/Forms/MainWindow.ui \
+	$$PWD/Forms/NewConfigDialog.ui \
+	$$PWD/Forms/OptionsStorageDialog.ui \
+	$$PWD/Forms/ProcessOutputWindow.ui \
+	$$PWD/Forms/SetupDialog.ui \
+	$$PWD/Forms/WADDescViewer.ui \
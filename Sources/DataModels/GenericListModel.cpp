@@ -30,6 +30,8 @@ void AListModel::finishEditingItemData( int row, int count, const QVector<int> &
 	if (count < 0)
 		count = this->rowCount();
 
+	invalidateDisplayCache();
+
 	const QModelIndex firstChangedIndex = createIndex( row, /*column*/0 );
 	const QModelIndex lastChangedIndex = createIndex( row + count - 1, /*column*/0 );
 
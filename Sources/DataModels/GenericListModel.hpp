@@ -17,13 +17,16 @@
 #include "Utils/JsonUtils.hpp"         // for mimeData, dropMimeData
 #include "Utils/FileSystemUtils.hpp"   // PathConvertor
 #include "Utils/ErrorHandling.hpp"     // LoggingComponent
+#include "Utils/StringUtils.hpp"       // makeNaturalSortKey
 #include "Themes.hpp"                  // separator colors
 
 #include <QAbstractListModel>
 #include <QList>
 #include <QVector>
+#include <QHash>
 #include <QString>
 #include <QStringView>
+#include <QStringList>
 #include <QMimeData>
 #include <QUrl>
 #include <QFileInfo>
@@ -33,6 +36,10 @@
 #include <functional>
 #include <memory>
 #include <vector>
+#include <optional>
+#include <iterator>  // size
+#include <algorithm>
+#include <type_traits>
 #include <stdexcept>
 
 
@@ -54,6 +61,91 @@
 // They derive from Qt's abstract model classes and implement their abstract virtual methods.
 
 
+//======================================================================================================================
+/// Lookup table from a persistent item ID to the item's index in a list, shared by the list implementations.
+/** The table is built lazily on the first lookup and the owning list invalidates it on every operation
+  * that may change the order of the items or their IDs, including non-const access to the items.
+  * An item can still be modified through a reference obtained before the table was built, so a lookup whose result
+  * doesn't match the current items rebuilds the table and tries again. This covers both an item whose ID changed
+  * and an item that has been given the searched ID. */
+
+class ItemIDIndex {
+
+	mutable QHash< QString, qsize_t > _indexes;
+	mutable bool _isValid = false;
+
+ public:
+
+	void invalidate()  { _isValid = false; }
+
+	/// Returns the index of the first item with such ID, or -1 if there is none.
+	/** A miss rebuilds the table, unless it was just built, so it costs as much as a linear search. */
+	template< typename List >  // List::Item must have getID() method
+	qsize_t find( const List & list, const QString & itemID ) const
+	{
+		const bool isFresh = !_isValid;
+		if (isFresh)
+			rebuild( list );
+
+		auto iter = _indexes.constFind( itemID );
+		if (iter != _indexes.constEnd() && *iter < list.size() && list[ *iter ].getID() == itemID)
+			return *iter;
+
+		if (isFresh)  // the table has just been built from the current items, so there really is no such item
+			return -1;
+
+		// the items were modified behind our back
+		rebuild( list );
+		iter = _indexes.constFind( itemID );
+		return iter != _indexes.constEnd() ? *iter : -1;
+	}
+
+ private:
+
+	template< typename List >
+	void rebuild( const List & list ) const
+	{
+		_indexes.clear();
+		_indexes.reserve( list.size() );
+		for (qsize_t idx = list.size() - 1; idx >= 0; --idx)  // backwards, so that the first of duplicate IDs wins
+			_indexes.insert( list[ idx ].getID(), idx );
+		_isValid = true;
+	}
+
+};
+
+
+//======================================================================================================================
+// sorting helpers
+
+namespace impl {
+
+/// Sorts a range of items by keys computed only once per item, instead of twice in each of the O(n*log(n)) comparisons.
+/** The sort is stable, so the items with equal keys keep their original order. */
+template< typename Iter, typename MakeSortKey >
+void sortByPrecomputedKeys( Iter begin, Iter end, const MakeSortKey & makeSortKey )
+{
+	using Item = std::remove_reference_t< decltype( *begin ) >;
+	using Key = std::decay_t< std::invoke_result_t< MakeSortKey, const Item & > >;
+
+	std::vector< std::pair< Key, Iter > > keyedItems;
+	keyedItems.reserve( size_t( end - begin ) );
+	for (Iter iter = begin; iter != end; ++iter)
+		keyedItems.emplace_back( makeSortKey( *iter ), iter );
+
+	std::stable_sort( keyedItems.begin(), keyedItems.end(), []( const auto & a, const auto & b ) { return a.first < b.first; } );
+
+	// move the items out in the new order and then back, a single pass over all of them
+	std::vector< std::remove_const_t< Item > > sortedItems;
+	sortedItems.reserve( keyedItems.size() );
+	for (auto & keyedItem : keyedItems)
+		sortedItems.push_back( std::move( *keyedItem.second ) );
+	std::move( sortedItems.begin(), sortedItems.end(), begin );
+}
+
+} // namespace impl
+
+
 //======================================================================================================================
 /// A trivial wrapper around PtrList.
 /** One of the possible list implementations for the ListModel variants. */
@@ -62,6 +154,7 @@ template< typename Item_ >
 class DirectList {
 
 	PtrList< Item_ > _list;
+	ItemIDIndex _idIndex;
 
  public:
 
@@ -74,10 +167,10 @@ class DirectList {
 
 	//-- wrapper functions for manipulating the list -------------------------------------------------------------------
 
-	      auto & list()                                { return _list; }
+	      auto & list()                                { _idIndex.invalidate(); return _list; }
 	const auto & list() const                          { return _list; }
-	void updateList( const Container &  list )         { _list = list; }
-	void assignList(       Container && list )         { _list = std::move(list); }
+	void updateList( const Container &  list )         { _idIndex.invalidate(); _list = list; }
+	void assignList(       Container && list )         { _idIndex.invalidate(); _list = std::move(list); }
 
 	// content access
 
@@ -88,44 +181,44 @@ class DirectList {
 	auto size() const                                  { return _list.size(); }
 	auto isEmpty() const                               { return _list.isEmpty(); }
 
-	      auto & operator[]( qsize_t idx )             { return _list[ idx ]; }
+	      auto & operator[]( qsize_t idx )             { _idIndex.invalidate(); return _list[ idx ]; }
 	const auto & operator[]( qsize_t idx ) const       { return _list[ idx ]; }
 
-	      iterator begin()                             { return _list.begin(); }
+	      iterator begin()                             { _idIndex.invalidate(); return _list.begin(); }
 	const_iterator begin() const                       { return _list.begin(); }
 	const_iterator cbegin() const                      { return _list.cbegin(); }
-	      iterator end()                               { return _list.end(); }
+	      iterator end()                               { _idIndex.invalidate(); return _list.end(); }
 	const_iterator end() const                         { return _list.end(); }
 	const_iterator cend() const                        { return _list.cend(); }
 
-	      auto & first()                               { return _list.first(); }
+	      auto & first()                               { _idIndex.invalidate(); return _list.first(); }
 	const auto & first() const                         { return _list.first(); }
-	      auto & last()                                { return _list.last(); }
+	      auto & last()                                { _idIndex.invalidate(); return _list.last(); }
 	const auto & last() const                          { return _list.last(); }
 
 	// list modification
 
 	void reserve( qsize_t size )                       { _list.reserve( size ); }
-	void resize( qsize_t size )                        { _list.resize( size ); }
+	void resize( qsize_t size )                        { _idIndex.invalidate(); _list.resize( size ); }
 
-	void clear()                                       { _list.clear(); }
+	void clear()                                       { _idIndex.invalidate(); _list.clear(); }
 
-	void append( const Item &  item )                  { _list.append( item ); }
-	void append(       Item && item )                  { _list.append( std::move(item) ); }
-	void prepend( const Item &  item )                 { _list.prepend( item ); }
-	void prepend(       Item && item )                 { _list.prepend( std::move(item) ); }
-	void insert( qsize_t idx, const Item &  item )     { _list.insert( idx, item ); }
-	void insert( qsize_t idx,       Item && item )     { _list.insert( idx, std::move(item) ); }
+	void append( const Item &  item )                  { _idIndex.invalidate(); _list.append( item ); }
+	void append(       Item && item )                  { _idIndex.invalidate(); _list.append( std::move(item) ); }
+	void prepend( const Item &  item )                 { _idIndex.invalidate(); _list.prepend( item ); }
+	void prepend(       Item && item )                 { _idIndex.invalidate(); _list.prepend( std::move(item) ); }
+	void insert( qsize_t idx, const Item &  item )     { _idIndex.invalidate(); _list.insert( idx, item ); }
+	void insert( qsize_t idx,       Item && item )     { _idIndex.invalidate(); _list.insert( idx, std::move(item) ); }
 
-	void removeAt( qsize_t idx )                       { _list.removeAt( idx ); }
+	void removeAt( qsize_t idx )                       { _idIndex.invalidate(); _list.removeAt( idx ); }
 
-	void move( qsize_t from, qsize_t to )              { _list.move( from, to ); }
-	void moveToFront( qsize_t from )                   { _list.move( from, 0 ); }
-	void moveToBack( qsize_t from )                    { _list.move( from, size() - 1 ); }
+	void move( qsize_t from, qsize_t to )              { _idIndex.invalidate(); _list.move( from, to ); }
+	void moveToFront( qsize_t from )                   { _idIndex.invalidate(); _list.move( from, 0 ); }
+	void moveToBack( qsize_t from )                    { _idIndex.invalidate(); _list.move( from, size() - 1 ); }
 
 	template< typename Range, REQUIRES( types::is_range_of< Range, Item > ) >
-	void insertMultiple( qsize_t where, Range && range ) { _list.insertMultiple( where, std::forward< Range >( range ) ); }
-	void removeCountAt( qsize_t idx, qsize_t cnt ) { _list.removeCountAt( idx, cnt ); }
+	void insertMultiple( qsize_t where, Range && range ) { _idIndex.invalidate(); _list.insertMultiple( where, std::forward< Range >( range ) ); }
+	void removeCountAt( qsize_t idx, qsize_t cnt ) { _idIndex.invalidate(); _list.removeCountAt( idx, cnt ); }
 
 	//-- custom access helpers -----------------------------------------------------------------------------------------
 
@@ -138,19 +231,32 @@ class DirectList {
 		std::sort( begin(), end(), isLessThan );
 	}
 
+	/// Sorts the items by keys that are computed only once per item.
+	template< typename MakeSortKey,
+		std::enable_if_t< std::is_invocable_v< MakeSortKey, const Item & >, int > = 0 >
+	void sortByKey( const MakeSortKey & makeSortKey )
+	{
+		impl::sortByPrecomputedKeys( begin(), end(), makeSortKey );
+	}
+
 	void sortByID()
 	{
-		sortBy( []( const Item & i1, const Item & i2 ) { return i1.getID() < i2.getID(); } );
+		sortByKey( []( const Item & item ) { return makeNaturalSortKey( item.getID() ); } );
 	}
 
+	// lookup
+
+	/// Returns the index of the item with such persistent ID, or -1 if there is none. Amortized O(1).
+	qsize_t findIndexByID( const QString & itemID ) const  { return _idIndex.find( *this, itemID ); }
+
 	// low-level pointer manipulation for implementing optimized high-level operations
 
-	std::unique_ptr< Item > takePtr( qsize_t idx )               { return _list.takePtr( idx ); }
-	void assignPtr( qsize_t idx, std::unique_ptr< Item > ptr )   { _list.assignPtr( idx, std::move(ptr) ); }
+	std::unique_ptr< Item > takePtr( qsize_t idx )               { _idIndex.invalidate(); return _list.takePtr( idx ); }
+	void assignPtr( qsize_t idx, std::unique_ptr< Item > ptr )   { _idIndex.invalidate(); _list.assignPtr( idx, std::move(ptr) ); }
 
-	void insertDefaults( qsize_t where, qsize_t count )          { _list.insertDefaults( where, count ); }
+	void insertDefaults( qsize_t where, qsize_t count )          { _idIndex.invalidate(); _list.insertDefaults( where, count ); }
 	template< typename PtrRange, REQUIRES( types::is_range_of< PtrRange, std::unique_ptr< Item > > ) >
-	void insertPtrs( qsize_t where, PtrRange && ptrs )           { _list.insertPtrs( where, std::forward< PtrRange >( ptrs ) ); }
+	void insertPtrs( qsize_t where, PtrRange && ptrs )           { _idIndex.invalidate(); _list.insertPtrs( where, std::forward< PtrRange >( ptrs ) ); }
 
 	bool isNull( qsize_t idx ) const                             { return _list.isNull( idx ); }
 
@@ -162,6 +268,149 @@ class DirectList {
 };
 
 
+//======================================================================================================================
+/// A wrapper around PtrList owned by someone else, for example a list stored inside another item.
+/** One of the possible list implementations for the ListModel variants.
+  * Allows a model to display and edit a list that is part of other data without keeping a copy that would need
+  * to be synchronized. Switching to another list is only a pointer assignment. */
+
+template< typename Item_ >
+class ExternalList {
+
+	PtrList< Item_ > _ownList;          ///< used when no external list is bound, so that the model always has something to operate on
+	PtrList< Item_ > * _list = &_ownList;
+	ItemIDIndex _idIndex;
+
+ public:
+
+	using Item = Item_;
+	using Container = PtrList< Item_ >;
+
+	ExternalList() = default;
+	ExternalList( const Container &  list ) : _ownList( list ) {}
+	ExternalList(       Container && list ) : _ownList( std::move(list) ) {}
+
+	// the pointer would point to the other object's own list
+	ExternalList( const ExternalList & ) = delete;
+	ExternalList & operator=( const ExternalList & ) = delete;
+
+	//-- binding -------------------------------------------------------------------------------------------------------
+
+	/// Makes all the following operations work directly with \p externalList, without copying its items.
+	/** The caller is responsible for calling unbindList() before the external list is destroyed.
+	  * The owning model must be inside startCompleteUpdate() and finishCompleteUpdate() when this is called. */
+	void bindList( Container & externalList )  { _idIndex.invalidate(); _list = &externalList; }
+
+	/// Detaches from the external list and continues with an empty list owned by this object.
+	void unbindList()                          { _idIndex.invalidate(); _ownList.clear(); _list = &_ownList; }
+
+	bool isBound() const                       { return _list != &_ownList; }
+	/// Only compares the address, so it's safe to call even if the list has already been destroyed.
+	bool isBoundTo( const Container * list ) const  { return _list == list; }
+
+	//-- wrapper functions for manipulating the list -------------------------------------------------------------------
+
+	      auto & list()                                { _idIndex.invalidate(); return *_list; }
+	const auto & list() const                          { return *_list; }
+	void updateList( const Container &  list )         { _idIndex.invalidate(); *_list = list; }
+	void assignList(       Container && list )         { _idIndex.invalidate(); *_list = std::move(list); }
+
+	// content access
+
+	using iterator = typename Container::iterator;
+	using const_iterator = typename Container::const_iterator;
+
+	auto count() const                                 { return _list->count(); }
+	auto size() const                                  { return _list->size(); }
+	auto isEmpty() const                               { return _list->isEmpty(); }
+
+	      auto & operator[]( qsize_t idx )             { _idIndex.invalidate(); return (*_list)[ idx ]; }
+	const auto & operator[]( qsize_t idx ) const       { return (*_list)[ idx ]; }
+
+	      iterator begin()                             { _idIndex.invalidate(); return _list->begin(); }
+	const_iterator begin() const                       { return _list->begin(); }
+	const_iterator cbegin() const                      { return _list->cbegin(); }
+	      iterator end()                               { _idIndex.invalidate(); return _list->end(); }
+	const_iterator end() const                         { return _list->end(); }
+	const_iterator cend() const                        { return _list->cend(); }
+
+	      auto & first()                               { _idIndex.invalidate(); return _list->first(); }
+	const auto & first() const                         { return _list->first(); }
+	      auto & last()                                { _idIndex.invalidate(); return _list->last(); }
+	const auto & last() const                          { return _list->last(); }
+
+	// list modification
+
+	void reserve( qsize_t size )                       { _list->reserve( size ); }
+	void resize( qsize_t size )                        { _idIndex.invalidate(); _list->resize( size ); }
+
+	void clear()                                       { _idIndex.invalidate(); _list->clear(); }
+
+	void append( const Item &  item )                  { _idIndex.invalidate(); _list->append( item ); }
+	void append(       Item && item )                  { _idIndex.invalidate(); _list->append( std::move(item) ); }
+	void prepend( const Item &  item )                 { _idIndex.invalidate(); _list->prepend( item ); }
+	void prepend(       Item && item )                 { _idIndex.invalidate(); _list->prepend( std::move(item) ); }
+	void insert( qsize_t idx, const Item &  item )     { _idIndex.invalidate(); _list->insert( idx, item ); }
+	void insert( qsize_t idx,       Item && item )     { _idIndex.invalidate(); _list->insert( idx, std::move(item) ); }
+
+	void removeAt( qsize_t idx )                       { _idIndex.invalidate(); _list->removeAt( idx ); }
+
+	void move( qsize_t from, qsize_t to )              { _idIndex.invalidate(); _list->move( from, to ); }
+	void moveToFront( qsize_t from )                   { _idIndex.invalidate(); _list->move( from, 0 ); }
+	void moveToBack( qsize_t from )                    { _idIndex.invalidate(); _list->move( from, size() - 1 ); }
+
+	template< typename Range, REQUIRES( types::is_range_of< Range, Item > ) >
+	void insertMultiple( qsize_t where, Range && range ) { _idIndex.invalidate(); _list->insertMultiple( where, std::forward< Range >( range ) ); }
+	void removeCountAt( qsize_t idx, qsize_t cnt ) { _idIndex.invalidate(); _list->removeCountAt( idx, cnt ); }
+
+	//-- custom access helpers -----------------------------------------------------------------------------------------
+
+	// sorting
+
+	template< typename IsLessThan,
+		std::enable_if_t< std::is_invocable_v< IsLessThan, const Item &, const Item & >, int > = 0 >
+	void sortBy( const IsLessThan & isLessThan )
+	{
+		std::sort( begin(), end(), isLessThan );
+	}
+
+	/// Sorts the items by keys that are computed only once per item.
+	template< typename MakeSortKey,
+		std::enable_if_t< std::is_invocable_v< MakeSortKey, const Item & >, int > = 0 >
+	void sortByKey( const MakeSortKey & makeSortKey )
+	{
+		impl::sortByPrecomputedKeys( begin(), end(), makeSortKey );
+	}
+
+	void sortByID()
+	{
+		sortByKey( []( const Item & item ) { return makeNaturalSortKey( item.getID() ); } );
+	}
+
+	// lookup
+
+	/// Returns the index of the item with such persistent ID, or -1 if there is none. Amortized O(1).
+	qsize_t findIndexByID( const QString & itemID ) const  { return _idIndex.find( *this, itemID ); }
+
+	// low-level pointer manipulation for implementing optimized high-level operations
+
+	std::unique_ptr< Item > takePtr( qsize_t idx )               { _idIndex.invalidate(); return _list->takePtr( idx ); }
+	void assignPtr( qsize_t idx, std::unique_ptr< Item > ptr )   { _idIndex.invalidate(); _list->assignPtr( idx, std::move(ptr) ); }
+
+	void insertDefaults( qsize_t where, qsize_t count )          { _idIndex.invalidate(); _list->insertDefaults( where, count ); }
+	template< typename PtrRange, REQUIRES( types::is_range_of< PtrRange, std::unique_ptr< Item > > ) >
+	void insertPtrs( qsize_t where, PtrRange && ptrs )           { _idIndex.invalidate(); _list->insertPtrs( where, std::forward< PtrRange >( ptrs ) ); }
+
+	bool isNull( qsize_t idx ) const                             { return _list->isNull( idx ); }
+
+	//-- special -------------------------------------------------------------------------------------------------------
+
+	/// Whether the list modification functions can be safely called.
+	bool canBeModified() const { return true; }
+
+};
+
+
 //======================================================================================================================
 /// A wrapper around PtrList allowing to temporarily filter the content present only items matching a specified criteria.
 /** One of the possible list implementations for the ListModel variants. */
@@ -171,6 +420,24 @@ class FilteredList {
 
 	PtrList< Item_ > _fullList;
 	QVector< Item_ * > _filteredList;
+	ItemIDIndex _idIndex;   ///< indexes into _filteredList
+
+	// state of the last search, allowing to only narrow down the results when the user types more characters
+	struct LastSearch
+	{
+		QString preparedPhrase;      ///< case-folded if the search was case-insensitive
+		bool caseSensitive = false;
+		bool isNarrowable = false;   ///< whether _filteredList contains the results of this search
+	};
+	LastSearch _lastSearch;
+	QRegularExpression _searchRegex;  ///< compiled only when the pattern changes
+
+	struct CachedSearchKey
+	{
+		QString sourceText;   ///< the edit string the key was made from, to detect renamed items
+		QString foldedText;
+	};
+	QHash< const Item_ *, CachedSearchKey > _searchKeys;  ///< case-folded edit strings for case-insensitive search
 
  public:
 
@@ -183,9 +450,9 @@ class FilteredList {
 
 	//-- wrapper functions for manipulating the list -------------------------------------------------------------------
 
-	      auto & fullList()                            { return _fullList; }
+	      auto & fullList()                            { _idIndex.invalidate(); return _fullList; }
 	const auto & fullList() const                      { return _fullList; }
-	      auto & filteredList()                        { return _filteredList; }
+	      auto & filteredList()                        { _idIndex.invalidate(); return _filteredList; }
 	const auto & filteredList() const                  { return _filteredList; }
 	void updateList( const Container &  list )         { _fullList = list; restore(); }
 	void assignList(       Container && list )         { _fullList = std::move(list); restore(); }
@@ -199,19 +466,19 @@ class FilteredList {
 	auto size() const                                  { return _filteredList.size(); }
 	auto isEmpty() const                               { return _filteredList.isEmpty(); }
 
-	      auto & operator[]( qsize_t idx )             { return *_filteredList[ idx ]; }
+	      auto & operator[]( qsize_t idx )             { _idIndex.invalidate(); return *_filteredList[ idx ]; }
 	const auto & operator[]( qsize_t idx ) const       { return *_filteredList[ idx ]; }
 
-	      iterator begin()                             { return DerefIterator( _filteredList.begin() ); }
+	      iterator begin()                             { _idIndex.invalidate(); return DerefIterator( _filteredList.begin() ); }
 	const_iterator begin() const                       { return DerefIterator( _filteredList.begin() ); }
 	const_iterator cbegin() const                      { return DerefIterator( _filteredList.cbegin() ); }
-	      iterator end()                               { return DerefIterator( _filteredList.end() ); }
+	      iterator end()                               { _idIndex.invalidate(); return DerefIterator( _filteredList.end() ); }
 	const_iterator end() const                         { return DerefIterator( _filteredList.end() ); }
 	const_iterator cend() const                        { return DerefIterator( _filteredList.cend() ); }
 
-	      auto & first()                               { return *_filteredList.first(); }
+	      auto & first()                               { _idIndex.invalidate(); return *_filteredList.first(); }
 	const auto & first() const                         { return *_filteredList.first(); }
-	      auto & last()                                { return *_filteredList.last(); }
+	      auto & last()                                { _idIndex.invalidate(); return *_filteredList.last(); }
 	const auto & last() const                          { return *_filteredList.last(); }
 
 	// list modification - only when the list is not filtered
@@ -281,6 +548,7 @@ class FilteredList {
 
 	void removeAt( qsize_t idx )
 	{
+		_idIndex.invalidate();
 		if (!isFiltered())
 		{
 			_fullList.removeAt( idx );
@@ -343,11 +611,25 @@ class FilteredList {
 		std::sort( begin(), end(), isLessThan );
 	}
 
+	/// Sorts the items by keys that are computed only once per item.
+	template< typename MakeSortKey,
+		std::enable_if_t< std::is_invocable_v< MakeSortKey, const Item & >, int > = 0 >
+	void sortByKey( const MakeSortKey & makeSortKey )
+	{
+		impl::sortByPrecomputedKeys( begin(), end(), makeSortKey );
+	}
+
 	void sortByID()
 	{
-		sortBy( []( const Item & i1, const Item & i2 ) { return i1.getID() < i2.getID(); } );
+		sortByKey( []( const Item & item ) { return makeNaturalSortKey( item.getID() ); } );
 	}
 
+	// lookup
+
+	/// Returns the index of the item with such persistent ID among the displayed items, or -1 if there is none.
+	/** Amortized O(1). */
+	qsize_t findIndexByID( const QString & itemID ) const  { return _idIndex.find( *this, itemID ); }
+
 	// low-level pointer manipulation for implementing optimized high-level operations
 
 	std::unique_ptr< Item > takePtr( qsize_t idx )
@@ -387,32 +669,73 @@ class FilteredList {
 	//-- searching/filtering -------------------------------------------------------------------------------------------
 
 	/// Filters the list model entries to display only those that match a given criteria.
+	/** When the phrase only extends the phrase of the previous search (the user types more characters),
+	  * only the current results are filtered, because no other item can match. */
 	void search( const QString & phrase, bool caseSensitive, bool useRegex )
 	{
-		clearButKeepAllocated( _filteredList );
+		_idIndex.invalidate();
 
 		if (useRegex)
 		{
-			QRegularExpression regex( phrase );
-			for (auto & item : _fullList)
-				if (!item.isSeparator && regex.isValid() && regex.match( item.getEditString() ).hasMatch())
-					_filteredList.append( &item );
+			// A regex extended by more characters can match more than before (for example "a" -> "a|b"),
+			// so the whole list must always be searched.
+			if (_searchRegex.pattern() != phrase)
+				_searchRegex.setPattern( phrase );
+
+			clearButKeepAllocated( _filteredList );
+			if (_searchRegex.isValid())
+				for (auto & item : _fullList)
+					if (!item.isSeparator && _searchRegex.match( item.getEditString() ).hasMatch())
+						_filteredList.append( &item );
+
+			_lastSearch.isNarrowable = false;
+			return;
+		}
+
+		const QString preparedPhrase = caseSensitive ? phrase : phrase.toCaseFolded();
+
+		auto matches = [&]( const Item & item )
+		{
+			return caseSensitive ? item.getEditString().contains( preparedPhrase, Qt::CaseSensitive )
+			                     : getFoldedSearchKey( item ).contains( preparedPhrase, Qt::CaseSensitive );
+		};
+
+		if (_lastSearch.isNarrowable && _lastSearch.caseSensitive == caseSensitive
+		 && preparedPhrase.contains( _lastSearch.preparedPhrase ))
+		{
+			// anything that contains the new phrase also contains the old one, so it's already in the results
+			qsize_t keptCount = 0;
+			for (Item * item : as_const( _filteredList ))
+				if (!item->isSeparator && matches( *item ))
+					_filteredList[ keptCount++ ] = item;
+			_filteredList.resize( keptCount );
 		}
 		else
 		{
-			Qt::CaseSensitivity caseSensitivity = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+			clearButKeepAllocated( _filteredList );
 			for (auto & item : _fullList)
-				if (!item.isSeparator && item.getEditString().contains( phrase, caseSensitivity ))
+				if (!item.isSeparator && matches( item ))
 					_filteredList.append( &item );
 		}
+
+		_lastSearch.preparedPhrase = preparedPhrase;
+		_lastSearch.caseSensitive = caseSensitive;
+		_lastSearch.isNarrowable = true;
 	}
 
 	/// Restores the list model to display the full unfiltered content.
 	void restore()
 	{
+		_idIndex.invalidate();
 		clearButKeepAllocated( _filteredList );
 		for (auto & item : _fullList)
 			_filteredList.append( &item );
+
+		_lastSearch.isNarrowable = false;
+
+		// drop the keys of the items that have been deleted in the meantime
+		if (_searchKeys.size() > _fullList.size())
+			_searchKeys.clear();
 	}
 
 	/// Whether the list is currently filtered or showing the full content.
@@ -432,8 +755,11 @@ class FilteredList {
 
  protected:
 
+	// Every modification goes through here, so it's also the place to invalidate the derived data.
 	void ensureCanBeModified()
 	{
+		_idIndex.invalidate();
+
 		if (!canBeModified())
 		{
 			::logLogicError( u"FilteredList" ) << "the list cannot be modified when it is filtered";
@@ -441,6 +767,18 @@ class FilteredList {
 		}
 	}
 
+	const QString & getFoldedSearchKey( const Item & item )
+	{
+		CachedSearchKey & key = _searchKeys[ &item ];
+		const QString & text = item.getEditString();
+		if (key.sourceText != text)  // new item or renamed since the last search (or a new item at the old address)
+		{
+			key.sourceText = text;
+			key.foldedText = text.toCaseFolded();
+		}
+		return key.foldedText;
+	}
+
 	// Takes addresses of {count} items starting at {where} in the _fullList and inserts them into _filteredList.
 	void insertUpdatedPtrs( qsize_t where, qsize_t count )
 	{
@@ -495,6 +833,51 @@ class DropTarget {
 };
 
 
+//======================================================================================================================
+/// MIME data produced by our list models.
+/** The formats that are cheap to make (source model pointer, row indexes) are stored right away, but the file URLs
+  * and the serialized items are made only when somebody actually asks for them, which never happens
+  * when the items are just being reordered by drag&drop within the same list.
+  * The lazy formats are made from copies of the items taken when the data were created, so they stay valid
+  * even when the source list is changed or rebound during a long drag or before a paste. */
+
+class ListModelMimeData : public QMimeData {
+
+	Q_OBJECT
+
+ public:
+
+	virtual QStringList formats() const override
+	{
+		return QMimeData::formats() + _lazyFormats;
+	}
+
+ protected:
+
+	void addLazyFormat( const QString & mimeType )  { _lazyFormats.append( mimeType ); }
+
+ #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+	virtual QVariant retrieveData( const QString & mimeType, QVariant::Type preferredType ) const override
+ #else
+	virtual QVariant retrieveData( const QString & mimeType, QMetaType preferredType ) const override
+ #endif
+	{
+		if (_lazyFormats.contains( mimeType ))
+			return makeLazyData( mimeType );
+		else
+			return QMimeData::retrieveData( mimeType, preferredType );
+	}
+
+	/// Produces the data of one of the formats added by addLazyFormat().
+	virtual QVariant makeLazyData( const QString & mimeType ) const = 0;
+
+ private:
+
+	QStringList _lazyFormats;
+
+};
+
+
 //======================================================================================================================
 /// Our own abstract list model.
 /** Contains code of our list models that doesn't depend on the template parameter Item. */
@@ -531,6 +914,13 @@ class AListModel : public QAbstractListModel, public ErrorReportingComponent, pu
 	/// Required for import format FileUrls to work properly.
 	void setPathConvertor( PathConvertor & pathConvertor ) { this->pathConvertor = &pathConvertor; }
 
+	/// Receives the (converted) paths of the dropped files and the row where they were dropped.
+	using BulkDropHandler = std::function< void ( QStringList paths, int row ) >;
+	/// When at least bulkDropMinCount files are dropped, they are passed to this handler instead of being inserted
+	/// right away, so that the owner can check and insert them in background without freezing the UI.
+	void setBulkDropHandler( BulkDropHandler handler ) { bulkDropHandler = std::move( handler ); }
+	static constexpr int bulkDropMinCount = 64;
+
 
 	//-- data change notifications -------------------------------------------------------------------------------------
 
@@ -572,6 +962,7 @@ class AListModel : public QAbstractListModel, public ErrorReportingComponent, pu
 	void finishReorderingItems()
 	{
 		_operInProgress = Operation::None;
+		invalidateDisplayCache();
 		emit QBaseModel::layoutChanged( {}, LayoutChangeHint::VerticalSortHint );
 	}
 
@@ -592,6 +983,7 @@ class AListModel : public QAbstractListModel, public ErrorReportingComponent, pu
 	void finishInsertingItems()
 	{
 		_operInProgress = Operation::None;
+		invalidateDisplayCache();
 		QBaseModel::endInsertRows();
 	}
 
@@ -603,6 +995,7 @@ class AListModel : public QAbstractListModel, public ErrorReportingComponent, pu
 	void finishRemovingItems()
 	{
 		_operInProgress = Operation::None;
+		invalidateDisplayCache();
 		QBaseModel::endRemoveRows();
 	}
 
@@ -614,9 +1007,19 @@ class AListModel : public QAbstractListModel, public ErrorReportingComponent, pu
 	void finishCompleteUpdate()
 	{
 		_operInProgress = Operation::None;
+		invalidateDisplayCache();
 		QBaseModel::endResetModel();
 	}
 
+	/// Makes the model re-read the display data of all items the next time the views ask for them.
+	/** The cached data are invalidated automatically by all the finish...() functions above, call this only
+	  * when the items were modified and the views are going to be updated some other way. */
+	void invalidateDisplayCache()
+	{
+		if (++_displayGeneration == 0)  // 0 is reserved for never filled cache entries
+			++_displayGeneration;
+	}
+
 	// Additionally, one of these should be called after finishing externally triggered modifications of the model,
 	// which means modifications requested by a view object via the QAbstractItemModel's methods
 	// (setData, insertRows, removeRows, ...), commonly due to some user action like drag&drop.
@@ -662,6 +1065,8 @@ class AListModel : public QAbstractListModel, public ErrorReportingComponent, pu
 
 	Operation _operInProgress = Operation::None;
 
+	uint _displayGeneration = 1;  ///< incremented on every modification, cached display data from older generations are outdated
+
  protected: // configuration
 
 	/// whether items have an icon
@@ -690,6 +1095,9 @@ class AListModel : public QAbstractListModel, public ErrorReportingComponent, pu
 	/// optional path convertor that will convert paths dropped from directory to absolute or relative
 	const PathConvertor * pathConvertor = nullptr;
 
+	/// optional handler of large file drops, see setBulkDropHandler()
+	BulkDropHandler bulkDropHandler;
+
 };
 
 
@@ -720,6 +1128,118 @@ class GenericListModel : public AListModel, public ListImpl {
 		return access;
 	}
 
+	//-- batch modifications -------------------------------------------------------------------------------------------
+
+	// These modify many items at once and notify the views only once for the whole batch,
+	// instead of letting them re-layout after every single item.
+
+	/// Re-arranges the items so that the item previously at row newOrder[i] ends up at row i.
+	/** \p newOrder must be a permutation of all the rows. The views are notified by a single layout change
+	  * and the persistent indexes (selection, current item, ...) follow their items to the new positions. */
+	void reorderItems( const QList<int> & newOrder )
+	{
+		const int itemCount = int( listImpl().size() );
+		if (newOrder.size() != itemCount)
+		{
+			reportLogicError( u"reorderItems", "Cannot reorder items",
+				"The new order has "%QString::number( newOrder.size() )%" rows, but the list has "%QString::number( itemCount )
+			);
+			return;
+		}
+		// A duplicated or missing row would leave a null pointer in the list and destroy some other item.
+		QVector< bool > isRowUsed( itemCount, false );
+		for (int oldRow : newOrder)
+		{
+			if (oldRow < 0 || oldRow >= itemCount || isRowUsed[ oldRow ])
+			{
+				reportLogicError( u"reorderItems", "Cannot reorder items",
+					"The new order is not a permutation of the rows, row "%QString::number( oldRow )%" is invalid or duplicated"
+				);
+				return;
+			}
+			isRowUsed[ oldRow ] = true;
+		}
+
+		AListModel::startReorderingItems();
+
+		// Move only the pointers to the items, and do it in a single pass instead of shifting the list for every item.
+		std::vector< std::unique_ptr< Item > > itemPtrs;  // cannot use QVector here because those require copyable objects
+		itemPtrs.reserve( size_t( itemCount ) );
+		for (int row = 0; row < itemCount; ++row)
+			itemPtrs.push_back( listImpl().takePtr( row ) );  // leaves null at row
+		for (int newRow = 0; newRow < itemCount; ++newRow)
+			listImpl().assignPtr( newRow, std::move( itemPtrs[ size_t( newOrder[ newRow ] ) ] ) );
+
+		// let the selection and the current item follow their items
+		QVector< int > newRowOf( itemCount );
+		for (int newRow = 0; newRow < itemCount; ++newRow)
+			newRowOf[ newOrder[ newRow ] ] = newRow;
+		const QModelIndexList oldIndexes = QBaseModel::persistentIndexList();
+		QModelIndexList newIndexes;
+		newIndexes.reserve( oldIndexes.size() );
+		for (const QModelIndex & oldIndex : oldIndexes)
+			newIndexes.append( AListModel::makeModelIndex( newRowOf[ oldIndex.row() ] ) );
+		QBaseModel::changePersistentIndexList( oldIndexes, newIndexes );
+
+		AListModel::finishReorderingItems();
+	}
+
+	/// Removes the items at the given rows, \p sortedRows must be in ascending order without duplicates.
+	/** Each contiguous range of rows is announced to the views as a single removal. When the rows are scattered
+	  * into too many ranges, the views are told to reload the whole list instead, which is cheaper for them
+	  * than re-laying out after each range. */
+	void removeItems( const QList<int> & sortedRows )
+	{
+		if (sortedRows.isEmpty())
+			return;
+
+		struct RowRange
+		{
+			int first;
+			int count;
+		};
+		QVector< RowRange > ranges;
+		for (int row : sortedRows)
+		{
+			if (!ranges.isEmpty() && ranges.last().first + ranges.last().count == row)
+				ranges.last().count++;
+			else
+				ranges.append({ row, 1 });
+		}
+
+		if (ranges.size() <= maxSeparatelyAnnouncedRanges)
+		{
+			// from the bottom, so that the rows of the remaining ranges stay valid
+			for (auto rangeIter = ranges.rbegin(); rangeIter != ranges.rend(); ++rangeIter)
+			{
+				AListModel::startRemovingItems( rangeIter->first, rangeIter->count );
+				listImpl().removeCountAt( rangeIter->first, rangeIter->count );
+				AListModel::finishRemovingItems();
+			}
+		}
+		else
+		{
+			AListModel::startCompleteUpdate();
+
+			// Take out the pointers to the remaining items and put them back, to avoid shifting the list after each removal.
+			const int itemCount = int( listImpl().size() );
+			std::vector< std::unique_ptr< Item > > keptPtrs;
+			keptPtrs.reserve( size_t( itemCount - sortedRows.size() ) );
+			int nextRemovedIdx = 0;
+			for (int row = 0; row < itemCount; ++row)
+			{
+				if (nextRemovedIdx < sortedRows.size() && sortedRows[ nextRemovedIdx ] == row)
+					nextRemovedIdx++;
+				else
+					keptPtrs.push_back( listImpl().takePtr( row ) );
+			}
+			listImpl().clear();
+			listImpl().insertPtrs( 0, std::move( keptPtrs ) );
+
+			AListModel::finishCompleteUpdate();
+		}
+	}
+
 	//-- implementation of QAbstractItemModel's virtual methods --------------------------------------------------------
 
 	public: virtual int rowCount( const QModelIndex & /*parent*/ = QModelIndex() ) const override
@@ -812,61 +1332,13 @@ class GenericListModel : public AListModel, public ListImpl {
 			return QVariant();
 		}
 
-		const Item & item = listImpl()[ index.row() ];
+		const int row = index.row();
+		const Item & item = listImpl()[ row ];
 
 		try
 		{
-			if (role == Qt::DisplayRole)
-			{
-				// Some UI elements may want to display only the Item name, some others a string constructed from multiple
-				// Item elements. This way we generalize from the way the display string is constructed from the Item.
-				return makeDisplayString( item );
-			}
-			else if (role == Qt::EditRole && canBeEdited( item ))
-			{
-				return item.getEditString();
-			}
-			else if (role == Qt::CheckStateRole && canBeChecked( item ))
-			{
-				return item.isChecked() ? Qt::Checked : Qt::Unchecked;
-			}
-			else if (role == Qt::ForegroundRole)
-			{
-				if (item.isSeparator)
-					return QBrush( themes::getCurrentPalette().separatorText );
-				else if (item.textColor)
-					return QBrush( *item.textColor );
-				else
-					return QVariant();  // default
-			}
-			else if (role == Qt::BackgroundRole)
-			{
-				if (item.isSeparator)
-					return QBrush( themes::getCurrentPalette().separatorBackground );
-				else if (item.backgroundColor)
-					return QBrush( *item.backgroundColor );
-				else
-					return QVariant();  // default
-			}
-			else if (role == Qt::TextAlignmentRole)
-			{
-				if (item.isSeparator)
-					return Qt::AlignHCenter;
-				else
-					return QVariant();  // default
-			}
-			else if (role == Qt::DecorationRole && canHaveIcon( item ))
-			{
-				return item.getIcon();
-			}
-			else if (role == Qt::UserRole)  // required for "Open File Location" action
-			{
-				return item.getFilePath();
-			}
-			else
-			{
-				return QVariant();
-			}
+			RoleHandler getRoleData = getRoleHandler( role );
+			return getRoleData ? (this->*getRoleData)( row, item ) : QVariant();
 		}
 		catch (const std::logic_error & e)
 		{
@@ -875,6 +1347,146 @@ class GenericListModel : public AListModel, public ListImpl {
 		}
 	}
 
+	/// Function that produces the data of a specific role for an item at a specific row.
+	private: using RoleHandler = QVariant (GenericListModel::*)( int row, const Item & item ) const;
+
+	private: static RoleHandler getRoleHandler( int role )
+	{
+		// The views ask for several roles of every visible row on every repaint. The Qt's standard roles are small
+		// consecutive numbers, so instead of a chain of comparisons they index a table that is built at compile time
+		// for every Item type.
+		static_assert( Qt::DisplayRole == 0 && Qt::CheckStateRole == 10, "Qt has changed the role numbers" );
+		static constexpr RoleHandler roleHandlers [] =
+		{
+			&GenericListModel::getDisplayData,        // Qt::DisplayRole
+			&GenericListModel::getDecorationData,     // Qt::DecorationRole
+			&GenericListModel::getEditData,           // Qt::EditRole
+			nullptr,                                  // Qt::ToolTipRole
+			nullptr,                                  // Qt::StatusTipRole
+			nullptr,                                  // Qt::WhatsThisRole
+			nullptr,                                  // Qt::FontRole
+			&GenericListModel::getTextAlignmentData,  // Qt::TextAlignmentRole
+			&GenericListModel::getBackgroundData,     // Qt::BackgroundRole
+			&GenericListModel::getForegroundData,     // Qt::ForegroundRole
+			&GenericListModel::getCheckStateData,     // Qt::CheckStateRole
+		};
+
+		if (role >= 0 && role < int( std::size( roleHandlers ) ))
+			return roleHandlers[ role ];
+		else if (role == Qt::UserRole)  // required for "Open File Location" action
+			return &GenericListModel::getFilePathData;
+		else
+			return nullptr;
+	}
+
+	private: QVariant getDisplayData( int row, const Item & item ) const
+	{
+		// Some UI elements may want to display only the Item name, some others a string constructed from multiple
+		// Item elements. This way we generalize from the way the display string is constructed from the Item.
+		return getCachedRowData( row, item ).displayString;
+	}
+
+	private: QVariant getDecorationData( int row, const Item & item ) const
+	{
+		if (!canHaveIcon( item ))
+			return QVariant();
+
+		// Asked only for the rows being painted (unless the view needs sizes of all rows),
+		// so the icons of the rows nobody scrolled to are never fetched.
+		CachedRowData & cached = getCachedRowData( row, item );
+		if (!cached.icon.isValid())
+			cached.icon = item.getIcon();
+		return cached.icon;
+	}
+
+	private: QVariant getEditData( int /*row*/, const Item & item ) const
+	{
+		return canBeEdited( item ) ? QVariant( item.getEditString() ) : QVariant();
+	}
+
+	private: QVariant getCheckStateData( int /*row*/, const Item & item ) const
+	{
+		return canBeChecked( item ) ? QVariant( item.isChecked() ? Qt::Checked : Qt::Unchecked ) : QVariant();
+	}
+
+	private: QVariant getForegroundData( int row, const Item & item ) const
+	{
+		CachedBrush & brush = getCachedRowData( row, item ).foreground;
+		if (item.isSeparator)
+			return brush.get( themes::getCurrentPalette().separatorText );
+		else
+			return brush.get( item.textColor );
+	}
+
+	private: QVariant getBackgroundData( int row, const Item & item ) const
+	{
+		CachedBrush & brush = getCachedRowData( row, item ).background;
+		if (item.isSeparator)
+			return brush.get( themes::getCurrentPalette().separatorBackground );
+		else
+			return brush.get( item.backgroundColor );
+	}
+
+	private: QVariant getTextAlignmentData( int /*row*/, const Item & item ) const
+	{
+		return item.isSeparator ? QVariant( Qt::AlignHCenter ) : QVariant();  // default
+	}
+
+	private: QVariant getFilePathData( int /*row*/, const Item & item ) const
+	{
+		return item.getFilePath();
+	}
+
+	/// Brush made from a color, re-made only when the color changes.
+	/** The colors are changed directly in the items by the code that marks the default or invalid entries,
+	  * without going through any of the model's notifications, and the separator colors change with the color scheme.
+	  * So instead of relying on an invalidation, the color is compared with the one the brush was made from. */
+	private: struct CachedBrush
+	{
+		bool isFilled = false;
+		std::optional< QColor > color;   ///< the color the brush was made from, empty means the default
+		QVariant brush;                  ///< QBrush or empty for the default
+
+		const QVariant & get( const std::optional< QColor > & currentColor )
+		{
+			if (!isFilled || currentColor != color)
+			{
+				brush = currentColor ? QVariant( QBrush( *currentColor ) ) : QVariant();
+				color = currentColor;
+				isFilled = true;
+			}
+			return brush;
+		}
+	};
+
+	private: struct CachedRowData
+	{
+		uint generation = 0;   ///< AListModel::_displayGeneration in which this was filled, 0 means never
+		QString displayString;
+		QVariant icon;         ///< QIcon, empty until the row is first asked for it
+		CachedBrush foreground;
+		CachedBrush background;
+	};
+
+	private: CachedRowData & getCachedRowData( int row, const Item & item ) const
+	{
+		// The rows are inserted or removed only within the start/finish functions, which also change the generation,
+		// so the entries that stay after resizing are always refilled.
+		if (_rowCache.size() != listImpl().size())
+			_rowCache.resize( listImpl().size() );
+
+		CachedRowData & cached = _rowCache[ row ];
+		if (cached.generation == _displayGeneration)
+			return cached;
+
+		cached.displayString = makeDisplayString( item );
+		cached.icon = QVariant();  // fetched on demand by getDecorationData()
+		// the brushes check their colors by themselves
+
+		cached.generation = _displayGeneration;
+		return cached;
+	}
+
 	public: virtual bool setData( const QModelIndex & index, const QVariant & value, int role ) override
 	{
 		if constexpr (isReadOnly())
@@ -926,7 +1538,68 @@ class GenericListModel : public AListModel, public ListImpl {
 		}
 	}
 
-	/// Serializes items at \p indexes into MIME data.
+	/// MIME data that hold copies of the dragged items and serialize them only when requested.
+	class MimeData : public ListModelMimeData {
+
+		PtrList< Item > _items;   ///< copies of the items taken when the drag started
+
+		// the lazily made formats, drop targets usually ask for the same format several times
+		mutable QVariant _urls;
+		mutable QVariant _json;
+
+	 public:
+
+		MimeData( PtrList< Item > && items )
+			: _items( std::move(items) ) {}
+
+		qsize_t itemCount() const
+		{
+			return _items.size();
+		}
+
+		const Item & itemAt( qsize_t idx ) const
+		{
+			return _items[ idx ];
+		}
+
+		using ListModelMimeData::addLazyFormat;
+
+	 protected:
+
+		virtual QVariant makeLazyData( const QString & mimeType ) const override
+		{
+			if (mimeType == MimeTypes::UriList)
+			{
+				if (!_urls.isValid())
+				{
+					QVariantList urls;  // the same form in which QMimeData::setUrls() stores them
+					urls.reserve( itemCount() );
+					for (qsize_t i = 0; i < itemCount(); i++)
+						urls.append( QUrl::fromLocalFile( itemAt( i ).getFilePath() ) );
+					_urls = std::move( urls );
+				}
+				return _urls;
+			}
+			else if (mimeType == MimeTypes::Json)
+			{
+				if (!_json.isValid())
+				{
+					QJsonArray itemsJs;
+					for (qsize_t i = 0; i < itemCount(); i++)
+						itemsJs.append( itemAt( i ).serialize() );
+					_json = QJsonDocument( itemsJs ).toJson( QJsonDocument::Compact );
+				}
+				return _json;
+			}
+			return {};
+		}
+
+	};
+
+	/// Creates MIME data containing copies of the items at \p indexes.
+	/** The items are serialized only if the data are requested in the URL or JSON format.
+	  * Copying them is much cheaper than serializing them, and unlike row numbers the copies cannot be invalidated
+	  * by the list being refreshed while the drag is in progress. */
 	public: virtual QMimeData * mimeData( const QModelIndexList & indexes ) const override
 	{
 		if (indexes.isEmpty())
@@ -940,17 +1613,29 @@ class GenericListModel : public AListModel, public ListImpl {
 			return nullptr;  // nothing to produce
 		}
 
-		QMimeData * mimeData = new QMimeData;
+		PtrList< Item > items;
+		items.reserve( indexes.size() );
+		for (const QModelIndex & index : indexes)
+		{
+			if (index.row() < 0 || index.row() >= listImpl().size())
+			{
+				reportLogicError( u"mimeData", "Cannot export items", "Invalid index: "%QString::number( index.row() ) );
+				continue;
+			}
+			items.append( listImpl()[ index.row() ] );
+		}
+
+		auto * mimeData = new MimeData( std::move(items) );
 
 		mimeData->setData( MimeTypes::ModelPtr, makeMimeModelPtr() );  // to recognize the source of the data
 
 		if (canExportItemsAsUrls())
 		{
-			mimeData->setUrls( makeMimeUrls( indexes ) );
+			mimeData->addLazyFormat( MimeTypes::UriList );
 		}
 		if (!isReadOnly() && canExportItemsAsJson())
 		{
-			mimeData->setData( MimeTypes::Json, makeMimeJsonItems( indexes ) );
+			mimeData->addLazyFormat( MimeTypes::Json );
 		}
 		if (!isReadOnly() && canExportItemsAsIndexes())
 		{
@@ -966,34 +1651,6 @@ class GenericListModel : public AListModel, public ListImpl {
 		return QByteArray( reinterpret_cast< const char * >( &aModelPtr ), qsize_t( sizeof( &aModelPtr ) ) );
 	}
 
-	private: QList< QUrl > makeMimeUrls( const QModelIndexList & indexes ) const
-	{
-		QList< QUrl > urls;
-		urls.reserve( indexes.size() );
-		for (const QModelIndex & index : indexes)
-		{
-			if (index.row() < 0 || index.row() >= listImpl().size())
-			{
-				reportLogicError( u"mimeData", "Cannot export items", "Invalid index: "%QString::number( index.row() ) );
-				continue;
-			}
-			const Item & item = listImpl()[ index.row() ];
-			urls.append( QUrl::fromLocalFile( item.getFilePath() ) );
-		}
-		return urls;
-	}
-
-	private: QByteArray makeMimeJsonItems( const QModelIndexList & indexes ) const
-	{
-		QJsonArray itemsJs;
-		for (const QModelIndex & index : indexes)
-		{
-			const Item & item = listImpl()[ index.row() ];
-			itemsJs.append( item.serialize() );
-		}
-		return QJsonDocument( itemsJs ).toJson( QJsonDocument::Compact );
-	}
-
 	private: QByteArray makeMimeRowIndexes( const QModelIndexList & indexes ) const
 	{
 		// If we only want to reorder the items, we don't need to serialize the whole rich content
@@ -1079,7 +1736,11 @@ class GenericListModel : public AListModel, public ListImpl {
 		}
 		else if (hasImportableJson( mimeData, sourceModel ))
 		{
-			return dropMimeSerializedItems( mimeData->data( MimeTypes::Json ), row );
+			// If the data come from this process, we can copy the items directly and skip the JSON round-trip.
+			if (const auto * ourMimeData = dynamic_cast< const MimeData * >( mimeData ))
+				return dropMimeItemCopies( *ourMimeData, row );
+			else
+				return dropMimeSerializedItems( mimeData->data( MimeTypes::Json ), row );
 		}
 		else
 		{
@@ -1096,6 +1757,22 @@ class GenericListModel : public AListModel, public ListImpl {
 			reportLogicError( u"dropMimeData", "Cannot import data", "File has been dropped but PathConvertor is not set." );
 		}
 
+		if (bulkDropHandler && urls.size() >= bulkDropMinCount)
+		{
+			QStringList localPaths;
+			localPaths.reserve( urls.size() );
+			for (const QUrl & droppedUrl : urls)
+			{
+				QString localPath = droppedUrl.toLocalFile();
+				if (!localPath.isEmpty())
+					localPaths.append( pathConvertor ? pathConvertor->convertPath( localPath ) : localPath );
+			}
+
+			// Nothing has been inserted yet, so the view must not select anything or report a finished drag&drop.
+			bulkDropHandler( std::move( localPaths ), row );
+			return false;
+		}
+
 		// verify the dropped items so that we don't drop invalid ones
 		std::vector< std::unique_ptr< Item > > validDroppedFiles;
 		validDroppedFiles.reserve( size_t( urls.size() ) );
@@ -1132,6 +1809,31 @@ class GenericListModel : public AListModel, public ListImpl {
 		return true;
 	}
 
+	private: bool dropMimeItemCopies( const MimeData & mimeData, int row )
+	{
+		// copy all the items first, the source items might be in this list and get shifted by the insertion
+		std::vector< std::unique_ptr< Item > > droppedItems;  // cannot use QVector here because those require copyable objects
+		droppedItems.reserve( size_t( mimeData.itemCount() ) );
+		for (qsize_t i = 0; i < mimeData.itemCount(); i++)
+			droppedItems.push_back( std::make_unique< Item >( mimeData.itemAt( i ) ) );
+		auto count = int( droppedItems.size() );
+
+		// insert the dropped items in one pass
+		AListModel::startInsertingItems( row, count );
+		listImpl().insertPtrs( row, std::move( droppedItems ) );
+		AListModel::finishInsertingItems();
+
+		// notify the model owner about this external modification
+		AListModel::notifyItemsInserted( row, count );
+
+		// idiotic workaround because Qt is fucking retarded   (read the comment at the top of ExtendedListView.cpp)
+		//
+		// note down the destination drop index, so it can be later retrieved by ListView
+		DropTarget::itemsDropped( row, count );
+
+		return true;
+	}
+
 	private: bool dropMimeSerializedItems( const QByteArray & encodedData, int row )
 	{
 		QJsonParseError parseError;
@@ -1193,6 +1895,15 @@ class GenericListModel : public AListModel, public ListImpl {
 		std::vector< int > sortedItemIndexes( rawData, rawData + count );
 		std::sort( sortedItemIndexes.begin(), sortedItemIndexes.end() );
 
+		// the list might have been refreshed from a directory while the items were being dragged
+		if (!sortedItemIndexes.empty()
+		 && (sortedItemIndexes.front() < 0 || sortedItemIndexes.back() >= listImpl().size()
+		  || std::adjacent_find( sortedItemIndexes.begin(), sortedItemIndexes.end() ) != sortedItemIndexes.end()))
+		{
+			reportLogicError( u"dropMimeData", "Cannot move items", "The dragged items are no longer in the list." );
+			return false;
+		}
+
 		// Because every insert or remove operation shifts the items and invalidates the indexes (or iterators),
 		// we need to capture the original items before inserting anything at the target position. We can avoid
 		// copying or moving the instances of Item by abusing the fact that PtrList is an array of pointers to Item.
@@ -1306,6 +2017,9 @@ class GenericListModel : public AListModel, public ListImpl {
 		return !isReadOnly() && ((editingEnabled && item.isEditable()) || item.isSeparator);
 	}
 
+	/// Above this number of separate ranges, removeItems() resets the model instead of announcing each range.
+	static constexpr int maxSeparatelyAnnouncedRanges = 16;
+
  protected: // configuration
 
 	// Each list view might want to display the same data differently, so we allow the user of the list model
@@ -1313,6 +2027,10 @@ class GenericListModel : public AListModel, public ListImpl {
 	/// function that takes Item and constructs a String that will be displayed in the view
 	std::function< QString ( const Item & ) > makeDisplayString;
 
+ private: // display data cache
+
+	mutable QVector< CachedRowData > _rowCache;   ///< indexed by row
+
 };
 
 
@@ -1323,6 +2041,7 @@ template< typename Item > using ReadOnlyDirectListModel   = GenericListModel< Di
 template< typename Item > using ReadOnlyFilteredListModel = GenericListModel< FilteredList< Item >, AccessStyle::ReadOnly >;
 template< typename Item > using EditableDirectListModel   = GenericListModel< DirectList< Item >, AccessStyle::Editable >;
 template< typename Item > using EditableFilteredListModel = GenericListModel< FilteredList< Item >, AccessStyle::Editable >;
+template< typename Item > using EditableExternalListModel = GenericListModel< ExternalList< Item >, AccessStyle::Editable >;
 
 
 //======================================================================================================================
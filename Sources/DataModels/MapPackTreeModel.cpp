@@ -0,0 +1,981 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: model of a directory tree with map packs and additional columns with information read from the WADs
+//======================================================================================================================
+
+#include "MapPackTreeModel.hpp"
+
+#include "Utils/WADReader.hpp"  // readWadInfo, g_cachedWadInfo
+#include "Utils/FileIconProvider.hpp"
+#include "Utils/StringUtils.hpp"  // makeNaturalSortKey
+
+#include <QRunnable>
+#include <QDirIterator>
+#include <QThread>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QLocale>
+#include <QMimeData>
+#include <QUrl>
+#include <QIcon>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+
+//======================================================================================================================
+// internal types
+
+enum class WadInfoState
+{
+	NotApplicable,  ///< not a WAD file or a directory
+	Pending,        ///< the file is being read in the background
+	Loaded,
+	Failed,
+};
+
+struct MapPackTreeModel::Node
+{
+	Node * parent = nullptr;
+	int row = 0;                    ///< index of this node in parent's children, must be updated on every re-ordering
+
+	QString name;
+	QString path;                   ///< absolute path with '/' separators
+	QString suffix;
+	bool isDir = false;
+	qint64 size = 0;
+	QDateTime lastModified;
+
+	bool isPopulated = false;       ///< whether the content of this directory has already been read
+	std::vector< std::unique_ptr< Node > > children;
+
+	// information read from the WAD
+	WadInfoState wadInfoState = WadInfoState::NotApplicable;
+	int mapCount = -1;
+	QString game;
+	QString format;
+	QString firstMap;
+
+	// pre-computed sort keys, so that sorting doesn't have to transform the strings on every comparison
+	QString nameSortKey;
+	QString typeSortKey;
+	QString gameSortKey;
+	QString formatSortKey;
+	QString firstMapSortKey;
+
+	mutable QIcon icon;             ///< loaded lazily only for the rows that are displayed
+};
+
+static QString makeSortKey( const QString & str )
+{
+	return makeNaturalSortKey( str );  // so that MAP2 goes before MAP10 and "Episode 9" before "Episode 10"
+}
+
+static bool isWadFileSuffix( const QString & suffix )
+{
+	return suffix.compare( "wad", Qt::CaseInsensitive ) == 0
+	    || suffix.compare( "iwad", Qt::CaseInsensitive ) == 0
+	    || suffix.compare( "pwad", Qt::CaseInsensitive ) == 0;
+}
+
+/// Normalizes the path, so that it can be used as a key for looking up the nodes.
+static QString makePathKey( const QString & absolutePath )
+{
+ #if IS_WINDOWS
+	return absolutePath.toLower();  // paths on Windows are case-insensitive
+ #else
+	return absolutePath;
+ #endif
+}
+
+static QString makeAbsolutePath( const QString & path )
+{
+	return QDir::cleanPath( QFileInfo( path ).absoluteFilePath() );
+}
+
+/// Reads the WAD file in a worker thread and passes the result to the model in the main thread.
+class ReadWadInfoTask : public QRunnable {
+
+	MapPackTreeModel * _model;
+	QString _filePath;
+	qint64 _lastModified;
+	uint _generation;
+
+ public:
+
+	ReadWadInfoTask( MapPackTreeModel * model, QString filePath, qint64 lastModified, uint generation )
+		: _model( model ), _filePath( std::move(filePath) ), _lastModified( lastModified ), _generation( generation ) {}
+
+	virtual void run() override
+	{
+		doom::UncertainWadInfo wadInfo = doom::readWadInfo( _filePath );
+
+		// The model waits for all running tasks in its destructor, so it's guaranteed to still exist here,
+		// and the event is delivered to the model's thread, where it's safe to access the nodes.
+		QMetaObject::invokeMethod( _model,
+			[ model = _model, filePath = _filePath, lastModified = _lastModified, generation = _generation,
+			  wadInfo = std::move( wadInfo ) ]()
+			{
+				model->onWadInfoRead( filePath, lastModified, generation, wadInfo );
+			},
+			Qt::QueuedConnection
+		);
+	}
+
+};
+
+
+/// Reads the whole directory tree in a worker thread and builds an index for searching in it.
+/** The directories are read the same way as when the model populates them, so it can use these listings later. */
+class ScanTreeTask : public QRunnable {
+
+	MapPackTreeModel * _model;
+	QString _rootPath;
+	QStringList _nameFilters;
+	QDir::Filters _filters;
+	uint _generation;
+
+ public:
+
+	ScanTreeTask( MapPackTreeModel * model, QString rootPath, QStringList nameFilters, QDir::Filters filters, uint generation )
+		: _model( model ), _rootPath( std::move(rootPath) ), _nameFilters( std::move(nameFilters) ), _filters( filters ), _generation( generation ) {}
+
+	virtual void run() override
+	{
+		MapPackTreeModel::DirListings dirListings;
+		TrigramIndex searchIndex;
+
+		QStringList dirsToScan = { _rootPath };
+		while (!dirsToScan.isEmpty())
+		{
+			const QString dirPath = dirsToScan.takeLast();
+			QVector< MapPackTreeModel::EntryInfo > entries = MapPackTreeModel::listDir( dirPath, _nameFilters, _filters );
+			for (const MapPackTreeModel::EntryInfo & entry : as_const( entries ))
+			{
+				QString entryPath = dirPath + '/' + entry.name;
+				searchIndex.addEntry( entryPath.mid( _rootPath.size() + 1 ) );  // relative to the root
+				if (entry.isDir && !entry.isSymLink)  // following the symlinks could end up in an infinite loop
+					dirsToScan.append( std::move( entryPath ) );
+			}
+			dirListings.insert( makePathKey( dirPath ), std::move( entries ) );
+		}
+
+		// same reasoning as in ReadWadInfoTask
+		QMetaObject::invokeMethod( _model,
+			[ model = _model, generation = _generation, dirListings = std::move( dirListings ), searchIndex = std::move( searchIndex ) ]() mutable
+			{
+				model->onTreeScanned( generation, std::move( dirListings ), std::move( searchIndex ) );
+			},
+			Qt::QueuedConnection
+		);
+	}
+
+};
+
+
+//======================================================================================================================
+// construction
+
+MapPackTreeModel::MapPackTreeModel( QObject * parent )
+:
+	QAbstractItemModel( parent ),
+	LoggingComponent( u"MapPackTreeModel" ),
+	_rootNode( std::make_unique< Node >() )
+{
+	_rootNode->isDir = true;
+
+	// reading files is mostly waiting for the disk, more threads than that would only make them compete for it
+	_workerPool.setMaxThreadCount( std::clamp( QThread::idealThreadCount(), 1, 4 ) );
+
+	_updateTimer.setSingleShot( true );
+	_updateTimer.setInterval( 100 );
+	_resortTimer.setSingleShot( true );
+	_resortTimer.setInterval( 500 );
+	_reindexTimer.setSingleShot( true );
+	_reindexTimer.setInterval( 2000 );
+	_verifyTimer.setSingleShot( true );
+	_verifyTimer.setInterval( 1000 );
+
+	connect( &_dirWatcher, &QFileSystemWatcher::directoryChanged, this, &ThisClass::onDirectoryChanged );
+	connect( &_updateTimer, &QTimer::timeout, this, &ThisClass::flushWadInfoUpdates );
+	connect( &_resortTimer, &QTimer::timeout, this, &ThisClass::onResortTimerExpired );
+	connect( &_reindexTimer, &QTimer::timeout, this, &ThisClass::startTreeScan );
+	connect( &_verifyTimer, &QTimer::timeout, this, &ThisClass::verifyScannedDirs );
+}
+
+MapPackTreeModel::~MapPackTreeModel()
+{
+	// The tasks hold a pointer to this model, make sure none of them will use it after it's destroyed.
+	// The results that have already been posted to our event queue will be discarded together with this object.
+	_workerPool.clear();
+	_workerPool.waitForDone();
+}
+
+
+//======================================================================================================================
+// configuration
+
+void MapPackTreeModel::toggleIcons( bool enabled )
+{
+	if (enabled == _iconsEnabled)
+		return;
+
+	_iconsEnabled = enabled;
+
+	// the icons don't change the layout, only the first column of every row that has already been loaded
+	std::function< void ( const Node & ) > notifyIconsChanged = [ & ]( const Node & dirNode )
+	{
+		if (dirNode.children.empty())
+			return;
+		emit dataChanged(
+			indexFromNode( dirNode.children.front().get(), NameColumn ),
+			indexFromNode( dirNode.children.back().get(), NameColumn ),
+			{ Qt::DecorationRole }
+		);
+		for (const auto & child : dirNode.children)
+			if (child->isDir && child->isPopulated)
+				notifyIconsChanged( *child );
+	};
+	notifyIconsChanged( *_rootNode );
+}
+
+
+//======================================================================================================================
+// QFileSystemModel-like API
+
+QModelIndex MapPackTreeModel::setRootPath( const QString & path )
+{
+	const QString absolutePath = !path.isEmpty() ? makeAbsolutePath( path ) : QString();
+
+	beginResetModel();
+
+	// forget everything related to the old directory
+	_workerPool.clear();
+	++_generation;
+	_pendingUpdates.clear();
+	_nodesByPath.clear();
+	_searchIndex.clear();
+	_reindexTimer.stop();
+	_scannedDirs.clear();
+	_dirsToVerify.clear();
+	_verifyTimer.stop();
+	if (const QStringList watchedDirs = _dirWatcher.directories(); !watchedDirs.isEmpty())
+		_dirWatcher.removePaths( watchedDirs );
+
+	_rootNode = std::make_unique< Node >();
+	_rootNode->isDir = true;
+	_rootNode->path = absolutePath;
+	_rootNode->name = QFileInfo( absolutePath ).fileName();
+	if (!absolutePath.isEmpty())
+		_nodesByPath.insert( makePathKey( absolutePath ), _rootNode.get() );
+
+	endResetModel();
+
+	// read the top-level entries right away, the callers expect directoryLoaded to come even when no view is asking
+	if (!absolutePath.isEmpty())
+	{
+		populateDir( *_rootNode );
+		startTreeScan();
+	}
+
+	return QModelIndex();
+}
+
+QString MapPackTreeModel::rootPath() const
+{
+	return _rootNode->path;
+}
+
+QDir MapPackTreeModel::rootDirectory() const
+{
+	return QDir( _rootNode->path );
+}
+
+QModelIndex MapPackTreeModel::index( const QString & path, int column )
+{
+	Node * node = findOrLoadNodeByPath( path );
+	if (!node || node == _rootNode.get())
+		return QModelIndex();
+
+	return indexFromNode( node, column );
+}
+
+QString MapPackTreeModel::filePath( const QModelIndex & index ) const
+{
+	const Node * node = nodeFromIndex( index );
+	return node ? node->path : QString();
+}
+
+bool MapPackTreeModel::isDir( const QModelIndex & index ) const
+{
+	const Node * node = nodeFromIndex( index );
+	return node ? node->isDir : false;
+}
+
+
+//======================================================================================================================
+// tree navigation
+
+MapPackTreeModel::Node * MapPackTreeModel::nodeFromIndex( const QModelIndex & index ) const
+{
+	return index.isValid() ? static_cast< Node * >( index.internalPointer() ) : _rootNode.get();
+}
+
+QModelIndex MapPackTreeModel::indexFromNode( const Node * node, int column ) const
+{
+	if (!node || node == _rootNode.get())
+		return QModelIndex();
+
+	return createIndex( node->row, column, const_cast< Node * >( node ) );
+}
+
+MapPackTreeModel::Node * MapPackTreeModel::findNodeByPath( const QString & path ) const
+{
+	return _nodesByPath.value( makePathKey( makeAbsolutePath( path ) ), nullptr );
+}
+
+MapPackTreeModel::Node * MapPackTreeModel::findOrLoadNodeByPath( const QString & path )
+{
+	if (_rootNode->path.isEmpty() || path.isEmpty())
+		return nullptr;
+
+	const QString absolutePath = makeAbsolutePath( path );
+
+	if (Node * node = _nodesByPath.value( makePathKey( absolutePath ), nullptr ))
+		return node;
+
+	const QString relativePath = QDir( _rootNode->path ).relativeFilePath( absolutePath );
+	if (relativePath.startsWith("..") || QDir::isAbsolutePath( relativePath ))
+		return nullptr;  // not inside our root directory
+
+	// walk down from the root and read the directories on the way, until we find the entry
+	Node * node = _rootNode.get();
+	QString currentPath = _rootNode->path;
+	const QStringList pathParts = relativePath.split( '/', Qt::SkipEmptyParts );
+	for (const QString & part : pathParts)
+	{
+		if (!node->isDir)
+			return nullptr;
+		if (!node->isPopulated)
+			populateDir( *node );
+
+		currentPath = currentPath + '/' + part;
+		node = _nodesByPath.value( makePathKey( currentPath ), nullptr );
+		if (!node)
+			return nullptr;  // doesn't exist or was filtered out
+	}
+
+	return node;
+}
+
+
+//======================================================================================================================
+// reading directories
+
+QVector< MapPackTreeModel::EntryInfo > MapPackTreeModel::listDir( const QString & dirPath, const QStringList & nameFilters, QDir::Filters filters )
+{
+	const QFileInfoList fileInfos = QDir( dirPath ).entryInfoList( nameFilters, filters );
+
+	QVector< EntryInfo > entries;
+	entries.reserve( fileInfos.size() );
+	for (const QFileInfo & fileInfo : fileInfos)
+	{
+		EntryInfo entry;
+		entry.name = fileInfo.fileName();
+		entry.isDir = fileInfo.isDir();
+		entry.isSymLink = fileInfo.isSymLink();
+		if (!entry.isDir)
+		{
+			entry.suffix = fileInfo.suffix();
+			entry.size = fileInfo.size();
+		}
+		entry.lastModified = fileInfo.lastModified();
+		entries.append( std::move( entry ) );
+	}
+	return entries;
+}
+
+std::unique_ptr< MapPackTreeModel::Node > MapPackTreeModel::makeNode( Node * parent, const EntryInfo & entry )
+{
+	auto node = std::make_unique< Node >();
+
+	node->parent = parent;
+	node->name = entry.name;
+	node->path = parent->path + '/' + node->name;
+	node->isDir = entry.isDir;
+	if (!node->isDir)
+	{
+		node->suffix = entry.suffix;
+		node->size = entry.size;
+		node->format = node->suffix.toUpper();
+	}
+	node->lastModified = entry.lastModified;
+
+	node->nameSortKey = makeSortKey( node->name );
+	node->typeSortKey = makeSortKey( node->suffix );
+	node->formatSortKey = makeSortKey( node->format );
+
+	if (!node->isDir)
+	{
+		requestWadInfo( *node );  // if it's in the cache, the info is filled right away
+	}
+
+	return node;
+}
+
+void MapPackTreeModel::populateDir( Node & dirNode )
+{
+	dirNode.isPopulated = true;
+
+	QVector< EntryInfo > entries;
+	auto scannedIter = _scannedDirs.find( makePathKey( dirNode.path ) );
+	if (scannedIter != _scannedDirs.end())
+	{
+		// Reading the directory again could take long on a slow drive, and this can be called when jumping to a search
+		// result on every key press. The directory might have changed since the scan, so it's verified later.
+		entries = std::move( scannedIter.value() );
+		_scannedDirs.erase( scannedIter );
+		_dirsToVerify.append( dirNode.path );
+		_verifyTimer.start();
+	}
+	else
+	{
+		entries = listDir( dirNode.path, _nameFilters, _filters );
+		_dirWatcher.addPath( dirNode.path );
+	}
+
+	if (!entries.isEmpty())
+	{
+		std::vector< std::unique_ptr< Node > > newChildren;
+		newChildren.reserve( size_t( entries.size() ) );
+		for (const EntryInfo & entry : as_const( entries ))
+		{
+			newChildren.push_back( makeNode( &dirNode, entry ) );
+		}
+
+		beginInsertRows( indexFromNode( &dirNode ), 0, int( newChildren.size() ) - 1 );
+
+		dirNode.children = std::move( newChildren );
+		sortChildren( dirNode );
+		for (const auto & child : dirNode.children)
+		{
+			_nodesByPath.insert( makePathKey( child->path ), child.get() );
+		}
+
+		endInsertRows();
+	}
+
+	// QFileSystemModel emits this asynchronously, let's keep the same behaviour, the callers might rely on it
+	QMetaObject::invokeMethod( this, [ this, path = dirNode.path ]() { emit directoryLoaded( path ); }, Qt::QueuedConnection );
+}
+
+void MapPackTreeModel::onDirectoryChanged( const QString & path )
+{
+	Node * dirNode = findNodeByPath( path );
+	if (dirNode && dirNode->isPopulated)
+	{
+		refreshDir( *dirNode );
+	}
+
+	_reindexTimer.start();  // the directories are often modified in bursts, wait until it settles
+}
+
+/// Updates the content of an already populated directory, while keeping the nodes of the entries that still exist.
+void MapPackTreeModel::refreshDir( Node & dirNode )
+{
+	const QVector< EntryInfo > entries = listDir( dirNode.path, _nameFilters, _filters );
+	const QModelIndex dirIndex = indexFromNode( &dirNode );
+
+	QHash< QString, const EntryInfo * > newEntries;  // entries not yet present in the model
+	newEntries.reserve( entries.size() );
+	for (const EntryInfo & entry : entries)
+		newEntries.insert( entry.name, &entry );
+
+	// remove the nodes whose entries no longer exist and update the modified ones
+	for (int row = int( dirNode.children.size() ) - 1; row >= 0; --row)  // backwards, so that the rows don't shift
+	{
+		Node & child = *dirNode.children[ size_t( row ) ];
+
+		auto entryIter = newEntries.find( child.name );
+		if (entryIter == newEntries.end() || entryIter.value()->isDir != child.isDir)
+		{
+			beginRemoveRows( dirIndex, row, row );
+			unregisterSubtree( child );
+			dirNode.children.erase( dirNode.children.begin() + row );
+			for (size_t i = size_t( row ); i < dirNode.children.size(); ++i)
+				dirNode.children[i]->row = int( i );
+			endRemoveRows();
+			continue;
+		}
+
+		const EntryInfo & entry = *entryIter.value();
+		if (!child.isDir && (entry.lastModified != child.lastModified || entry.size != child.size))
+		{
+			child.size = entry.size;
+			child.lastModified = entry.lastModified;
+			requestWadInfo( child );
+			emit dataChanged( indexFromNode( &child, 0 ), indexFromNode( &child, ColumnCount - 1 ) );
+		}
+
+		newEntries.erase( entryIter );
+	}
+
+	if (newEntries.isEmpty())
+		return;
+
+	// append the new entries to the end and then move them into their sorted positions
+
+	const int firstNewRow = int( dirNode.children.size() );
+	beginInsertRows( dirIndex, firstNewRow, firstNewRow + int( newEntries.size() ) - 1 );
+	for (const EntryInfo & entry : entries)  // iterate the original list to keep a deterministic order
+	{
+		if (!newEntries.contains( entry.name ))
+			continue;
+		auto newNode = makeNode( &dirNode, entry );
+		newNode->row = int( dirNode.children.size() );
+		_nodesByPath.insert( makePathKey( newNode->path ), newNode.get() );
+		dirNode.children.push_back( std::move( newNode ) );
+	}
+	endInsertRows();
+
+	sortPreservingPersistentIndexes();
+}
+
+void MapPackTreeModel::unregisterSubtree( Node & node )
+{
+	_nodesByPath.remove( makePathKey( node.path ) );
+	_pendingUpdates.remove( makePathKey( node.path ) );
+
+	if (node.isDir && node.isPopulated)
+	{
+		_dirWatcher.removePath( node.path );
+		for (const auto & child : node.children)
+			unregisterSubtree( *child );
+	}
+}
+
+
+//======================================================================================================================
+// WAD information
+
+void MapPackTreeModel::requestWadInfo( Node & fileNode )
+{
+	fileNode.wadInfoState = WadInfoState::NotApplicable;
+	if (!isWadFileSuffix( fileNode.suffix ))
+		return;
+
+	// the cache uses seconds
+	const qint64 lastModified = fileNode.lastModified.toSecsSinceEpoch();
+
+	if (const auto * cachedInfo = doom::g_cachedWadInfo.findUpToDateFileInfo( fileNode.path, lastModified ))
+	{
+		applyWadInfo( fileNode, *cachedInfo );
+		return;
+	}
+
+	fileNode.wadInfoState = WadInfoState::Pending;
+	_workerPool.start( new ReadWadInfoTask( this, fileNode.path, lastModified, _generation ) );
+}
+
+void MapPackTreeModel::onWadInfoRead(
+	const QString & filePath, qint64 lastModified, uint generation, const doom::UncertainWadInfo & wadInfo
+){
+	// the info is valid regardless of whether the model still displays this file, let others use it
+	doom::g_cachedWadInfo.storeFileInfo( filePath, wadInfo, lastModified );
+
+	if (generation != _generation)
+		return;  // the root directory has changed since the task was started
+
+	Node * node = _nodesByPath.value( makePathKey( filePath ), nullptr );
+	if (!node || node->lastModified.toSecsSinceEpoch() != lastModified)
+		return;  // the file has been deleted or modified meanwhile, a new task has been started
+
+	applyWadInfo( *node, wadInfo );
+
+	_pendingUpdates.insert( makePathKey( filePath ), node );
+	if (!_updateTimer.isActive())
+		_updateTimer.start();
+}
+
+void MapPackTreeModel::applyWadInfo( Node & fileNode, const doom::UncertainWadInfo & wadInfo )
+{
+	if (wadInfo.status != ReadStatus::Success)
+	{
+		fileNode.wadInfoState = WadInfoState::Failed;
+		return;
+	}
+
+	fileNode.wadInfoState = WadInfoState::Loaded;
+	fileNode.mapCount = int( wadInfo.mapNames.size() );
+	fileNode.game = wadInfo.game.name ? QString( wadInfo.game.name ) : QString();
+	fileNode.icon = QIcon();  // the game badge might have changed
+	fileNode.firstMap = !wadInfo.mapNames.isEmpty() ? wadInfo.mapNames.first() : QString();
+	if (wadInfo.type == doom::WadType::IWAD)
+		fileNode.format = "IWAD";
+	else if (wadInfo.type == doom::WadType::PWAD)
+		fileNode.format = "PWAD";
+
+	fileNode.gameSortKey = makeSortKey( fileNode.game );
+	fileNode.formatSortKey = makeSortKey( fileNode.format );
+	fileNode.firstMapSortKey = makeSortKey( fileNode.firstMap );
+}
+
+void MapPackTreeModel::flushWadInfoUpdates()
+{
+	// notify about continuous ranges of rows in each directory instead of every row separately
+	QHash< Node *, std::pair< int, int > > updatedRowsPerDir;
+	for (Node * node : as_const( _pendingUpdates ))
+	{
+		auto rangeIter = updatedRowsPerDir.find( node->parent );
+		if (rangeIter == updatedRowsPerDir.end())
+		{
+			updatedRowsPerDir.insert( node->parent, { node->row, node->row } );
+		}
+		else
+		{
+			rangeIter->first = std::min( rangeIter->first, node->row );
+			rangeIter->second = std::max( rangeIter->second, node->row );
+		}
+	}
+	_pendingUpdates.clear();
+
+	for (auto rangeIter = updatedRowsPerDir.begin(); rangeIter != updatedRowsPerDir.end(); ++rangeIter)
+	{
+		Node * dirNode = rangeIter.key();
+		const auto [firstRow, lastRow] = rangeIter.value();
+		emit dataChanged(
+			indexFromNode( dirNode->children[ size_t( firstRow ) ].get(), NameColumn ),  // icon with the game badge
+			indexFromNode( dirNode->children[ size_t( lastRow ) ].get(), ColumnCount - 1 )
+		);
+	}
+
+	// the rows sorted by these columns are no longer in order
+	if (isSortedByWadInfo())
+		_resortTimer.start();
+}
+
+void MapPackTreeModel::onResortTimerExpired()
+{
+	sortPreservingPersistentIndexes();
+}
+
+
+//======================================================================================================================
+// searching
+
+void MapPackTreeModel::startTreeScan()
+{
+	if (_rootNode->path.isEmpty())
+		return;
+
+	_workerPool.start( new ScanTreeTask( this, _rootNode->path, _nameFilters, _filters, _generation ) );
+}
+
+void MapPackTreeModel::onTreeScanned( uint generation, DirListings && dirListings, TrigramIndex && searchIndex )
+{
+	if (generation != _generation)
+		return;  // the root directory has changed since the task was started
+
+	_searchIndex = std::move( searchIndex );
+
+	// the populated directories are kept up to date by the watcher, only the others can use the listings
+	_scannedDirs = std::move( dirListings );
+	for (auto dirIter = _scannedDirs.begin(); dirIter != _scannedDirs.end(); )
+	{
+		const Node * dirNode = _nodesByPath.value( dirIter.key(), nullptr );
+		if (dirNode && dirNode->isPopulated)
+			dirIter = _scannedDirs.erase( dirIter );
+		else
+			++dirIter;
+	}
+
+	emit searchIndexUpdated();
+}
+
+void MapPackTreeModel::verifyScannedDirs()
+{
+	const QStringList dirsToVerify = std::move( _dirsToVerify );
+	_dirsToVerify.clear();
+
+	for (const QString & dirPath : dirsToVerify)
+	{
+		Node * dirNode = findNodeByPath( dirPath );
+		if (!dirNode || !dirNode->isPopulated)
+			continue;  // removed in the meantime
+
+		refreshDir( *dirNode );
+		_dirWatcher.addPath( dirNode->path );
+	}
+}
+
+QStringList MapPackTreeModel::searchEntries( const QString & phrase, qsize_t maxResults )
+{
+	const QVector< TrigramIndex::Match > matches = _searchIndex.search( phrase, maxResults );
+
+	QStringList relativePaths;
+	relativePaths.reserve( matches.size() );
+	for (const TrigramIndex::Match & match : matches)
+		relativePaths.append( _searchIndex.entryText( match.id ) );
+
+	return relativePaths;
+}
+
+
+//======================================================================================================================
+// sorting
+
+void MapPackTreeModel::sortChildren( Node & dirNode ) const
+{
+	const int column = _sortColumn;
+	const bool ascending = _sortOrder == Qt::AscendingOrder;
+
+	// returns negative, zero or positive like strcmp
+	auto compareByColumn = [ column ]( const Node & n1, const Node & n2 ) -> int
+	{
+		switch (column)
+		{
+			case SizeColumn:      return (n1.size > n2.size) - (n1.size < n2.size);
+			case TypeColumn:      return n1.typeSortKey.compare( n2.typeSortKey );
+			case DateColumn:      return (n1.lastModified > n2.lastModified) - (n1.lastModified < n2.lastModified);
+			case MapCountColumn:  return (n1.mapCount > n2.mapCount) - (n1.mapCount < n2.mapCount);
+			case GameColumn:      return n1.gameSortKey.compare( n2.gameSortKey );
+			case FormatColumn:    return n1.formatSortKey.compare( n2.formatSortKey );
+			case FirstMapColumn:  return n1.firstMapSortKey.compare( n2.firstMapSortKey );
+			default:              return 0;  // name is the tie-breaker anyway
+		}
+	};
+
+	std::stable_sort( dirNode.children.begin(), dirNode.children.end(),
+		[ & ]( const std::unique_ptr< Node > & n1, const std::unique_ptr< Node > & n2 )
+		{
+			// directories always go first
+			if (n1->isDir != n2->isDir)
+				return n1->isDir;
+
+			int result = compareByColumn( *n1, *n2 );
+			if (result == 0)
+				result = n1->nameSortKey.compare( n2->nameSortKey );
+
+			return ascending ? result < 0 : result > 0;
+		}
+	);
+
+	for (size_t i = 0; i < dirNode.children.size(); ++i)
+		dirNode.children[i]->row = int( i );
+}
+
+void MapPackTreeModel::sortChildrenRecursively( Node & dirNode ) const
+{
+	sortChildren( dirNode );
+
+	for (const auto & child : dirNode.children)
+		if (child->isDir && child->isPopulated)
+			sortChildrenRecursively( *child );
+}
+
+void MapPackTreeModel::sortPreservingPersistentIndexes()
+{
+	emit layoutAboutToBeChanged( {}, QAbstractItemModel::VerticalSortHint );
+
+	// the nodes stay the same, only their rows change, so we can remember the nodes and re-create the indexes after
+	const QModelIndexList oldIndexes = persistentIndexList();
+	QVector< std::pair< Node *, int > > persistentNodes;
+	persistentNodes.reserve( oldIndexes.size() );
+	for (const QModelIndex & index : oldIndexes)
+		persistentNodes.append({ nodeFromIndex( index ), index.column() });
+
+	sortChildrenRecursively( *_rootNode );
+
+	QModelIndexList newIndexes;
+	newIndexes.reserve( persistentNodes.size() );
+	for (const auto & [node, column] : persistentNodes)
+		newIndexes.append( indexFromNode( node, column ) );
+	changePersistentIndexList( oldIndexes, newIndexes );
+
+	emit layoutChanged( {}, QAbstractItemModel::VerticalSortHint );
+}
+
+void MapPackTreeModel::sort( int column, Qt::SortOrder order )
+{
+	if (column < 0 || column >= ColumnCount)
+	{
+		logLogicError( u"sort" ) << "invalid column: " << column;
+		return;
+	}
+
+	_sortColumn = column;
+	_sortOrder = order;
+
+	sortPreservingPersistentIndexes();
+}
+
+
+//======================================================================================================================
+// implementation of QAbstractItemModel's virtual methods
+
+QModelIndex MapPackTreeModel::index( int row, int column, const QModelIndex & parent ) const
+{
+	const Node * parentNode = nodeFromIndex( parent );
+	if (row < 0 || size_t( row ) >= parentNode->children.size() || column < 0 || column >= ColumnCount)
+		return QModelIndex();
+
+	return createIndex( row, column, parentNode->children[ size_t( row ) ].get() );
+}
+
+QModelIndex MapPackTreeModel::parent( const QModelIndex & index ) const
+{
+	if (!index.isValid())
+		return QModelIndex();
+
+	return indexFromNode( nodeFromIndex( index )->parent );
+}
+
+int MapPackTreeModel::rowCount( const QModelIndex & parent ) const
+{
+	if (parent.column() > 0)
+		return 0;
+
+	return int( nodeFromIndex( parent )->children.size() );
+}
+
+int MapPackTreeModel::columnCount( const QModelIndex & ) const
+{
+	return ColumnCount;
+}
+
+bool MapPackTreeModel::hasChildren( const QModelIndex & parent ) const
+{
+	if (parent.column() > 0)
+		return false;
+
+	const Node * node = nodeFromIndex( parent );
+	// the directories that haven't been read yet are assumed to have some, so that the view shows the expand arrow
+	return node->isDir && (!node->isPopulated || !node->children.empty());
+}
+
+bool MapPackTreeModel::canFetchMore( const QModelIndex & parent ) const
+{
+	const Node * node = nodeFromIndex( parent );
+	return node->isDir && !node->isPopulated && !node->path.isEmpty();
+}
+
+void MapPackTreeModel::fetchMore( const QModelIndex & parent )
+{
+	Node * node = nodeFromIndex( parent );
+	if (node->isDir && !node->isPopulated && !node->path.isEmpty())
+	{
+		populateDir( *node );
+	}
+}
+
+QVariant MapPackTreeModel::data( const QModelIndex & index, int role ) const
+{
+	if (!index.isValid())
+		return QVariant();
+
+	const Node * node = nodeFromIndex( index );
+
+	if (role == Qt::DisplayRole)
+	{
+		switch (index.column())
+		{
+			case NameColumn:
+				return node->name;
+			case SizeColumn:
+				return node->isDir ? QString() : QLocale().formattedDataSize( node->size );
+			case TypeColumn:
+				return node->isDir ? QStringLiteral("Folder") : node->suffix + QStringLiteral(" File");
+			case DateColumn:
+				return QLocale().toString( node->lastModified, QLocale::ShortFormat );
+			case MapCountColumn:
+				return node->wadInfoState == WadInfoState::Loaded ? QVariant( node->mapCount ) : QVariant();
+			case GameColumn:
+				return node->game;
+			case FormatColumn:
+				return node->format;
+			case FirstMapColumn:
+				return node->firstMap;
+			default:
+				return QVariant();
+		}
+	}
+	else if (role == Qt::DecorationRole && index.column() == NameColumn && _iconsEnabled)
+	{
+		// resolved per suffix from memory, large directories don't cause any icon I/O
+		if (node->icon.isNull())
+			node->icon = getFileIconProvider().getIcon( node->path, node->isDir, node->game );
+		return node->icon;
+	}
+	else if (role == Qt::TextAlignmentRole)
+	{
+		if (index.column() == SizeColumn || index.column() == MapCountColumn)
+			return int( Qt::AlignRight | Qt::AlignVCenter );
+	}
+	else if (role == Qt::ToolTipRole && index.column() >= MapCountColumn)
+	{
+		if (node->wadInfoState == WadInfoState::Pending)
+			return QStringLiteral("Reading the file...");
+		else if (node->wadInfoState == WadInfoState::Failed)
+			return QStringLiteral("The file could not be read or is not a valid WAD.");
+	}
+
+	return QVariant();
+}
+
+QVariant MapPackTreeModel::headerData( int section, Qt::Orientation orientation, int role ) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QVariant();
+
+	switch (section)
+	{
+		case NameColumn:      return QStringLiteral("Name");
+		case SizeColumn:      return QStringLiteral("Size");
+		case TypeColumn:      return QStringLiteral("Type");
+		case DateColumn:      return QStringLiteral("Date Modified");
+		case MapCountColumn:  return QStringLiteral("Maps");
+		case GameColumn:      return QStringLiteral("Game");
+		case FormatColumn:    return QStringLiteral("Format");
+		case FirstMapColumn:  return QStringLiteral("First map");
+		default:              return QVariant();
+	}
+}
+
+Qt::ItemFlags MapPackTreeModel::flags( const QModelIndex & index ) const
+{
+	if (!index.isValid())
+		return Qt::NoItemFlags;
+
+	Qt::ItemFlags flags = Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled;
+	if (!nodeFromIndex( index )->isDir)
+		flags |= Qt::ItemNeverHasChildren;
+	return flags;
+}
+
+QStringList MapPackTreeModel::mimeTypes() const
+{
+	return { QStringLiteral("text/uri-list") };
+}
+
+QMimeData * MapPackTreeModel::mimeData( const QModelIndexList & indexes ) const
+{
+	QList< QUrl > urls;
+	for (const QModelIndex & index : indexes)
+	{
+		if (index.column() == NameColumn)  // the view gives us an index for every column in the row
+			urls.append( QUrl::fromLocalFile( nodeFromIndex( index )->path ) );
+	}
+
+	QMimeData * mimeData = new QMimeData;
+	mimeData->setUrls( urls );
+	return mimeData;
+}
+
+Qt::DropActions MapPackTreeModel::supportedDragActions() const
+{
+	// same as QFileSystemModel, the other views of this application accept only MoveAction from other widgets
+	return Qt::CopyAction | Qt::MoveAction | Qt::LinkAction;
+}
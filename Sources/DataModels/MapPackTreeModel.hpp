@@ -0,0 +1,221 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: model of a directory tree with map packs and additional columns with information read from the WADs
+//======================================================================================================================
+
+#ifndef MAP_PACK_TREE_MODEL_INCLUDED
+#define MAP_PACK_TREE_MODEL_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include "Utils/WADReaderTypes.hpp"  // UncertainWadInfo
+#include "Utils/TrigramIndex.hpp"    // TrigramIndex
+#include "Utils/ErrorHandling.hpp"    // LoggingComponent
+
+#include <QAbstractItemModel>
+#include <QFileSystemWatcher>
+#include <QThreadPool>
+#include <QTimer>
+#include <QHash>
+#include <QVector>
+#include <QDir>
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+
+//======================================================================================================================
+/// Model of a directory tree with map packs, displaying also information read from the WAD files.
+/**
+  * Replacement of QFileSystemModel with an API subset compatible with it, the first 4 columns are also the same.
+  *
+  * The directories are read only when they are expanded in the view or when an entry inside them is requested by path.
+  * After setRootPath() the whole tree is scanned once in background to build the search index, and the directories
+  * are then populated from the listings of this scan, so that jumping to a search result doesn't wait for the disk.
+  * These listings are verified against the disk later, when the user stops navigating.
+  * The information about the WADs (map count, game, format, first map) is read by a pool of background threads
+  * and the rows are updated gradually as the information arrives. Sorting by any column uses sort keys
+  * that are computed once when the entry or its information is loaded.
+  */
+class MapPackTreeModel : public QAbstractItemModel, protected LoggingComponent {
+
+	Q_OBJECT
+
+	using ThisClass = MapPackTreeModel;
+
+ public:
+
+	enum Column
+	{
+		// The first 4 correspond to the column indexes in the QFileSystemModel and to ExtendedViewCommon::SortKey.
+		NameColumn = 0,
+		SizeColumn = 1,
+		TypeColumn = 2,
+		DateColumn = 3,
+		MapCountColumn = 4,
+		GameColumn = 5,
+		FormatColumn = 6,
+		FirstMapColumn = 7,
+
+		ColumnCount
+	};
+
+	MapPackTreeModel( QObject * parent = nullptr );
+	virtual ~MapPackTreeModel() override;
+
+	//-- configuration -------------------------------------------------------------------------------------------------
+
+	/// Which kinds of file-system entries will be listed. Takes effect on the next setRootPath().
+	void setFilter( QDir::Filters filters )                { _filters = filters; }
+	/// Which files will be listed, directories are not affected. Takes effect on the next setRootPath().
+	void setNameFilters( const QStringList & nameFilters )  { _nameFilters = nameFilters; }
+
+	void toggleIcons( bool enabled );
+	bool areIconsEnabled() const                            { return _iconsEnabled; }
+
+	//-- QFileSystemModel-like API -------------------------------------------------------------------------------------
+
+	/// Resets the model to display the content of directory \p path and reads its top-level entries.
+	/** Returns an index that should be set as the root index of the view (always the invalid index). */
+	QModelIndex setRootPath( const QString & path );
+	QString rootPath() const;
+	QDir rootDirectory() const;
+
+	/// Returns an index of the entry with a given path, reading the parent directories if they haven't been read yet.
+	/** Returns an invalid index if the entry is not inside the root directory or doesn't exist. */
+	QModelIndex index( const QString & path, int column = 0 );
+
+	QString filePath( const QModelIndex & index ) const;
+	bool isDir( const QModelIndex & index ) const;
+
+	//-- searching -----------------------------------------------------------------------------------------------------
+
+	/// Finds the entries anywhere in the directory tree (even in the directories not read yet) matching the phrase.
+	/** Returns their paths relative to the root directory, sorted from the best match.
+	  * The whole tree is indexed in background after setRootPath(), until it's done this returns an empty list.
+	  * Doesn't access the file system. */
+	QStringList searchEntries( const QString & phrase, qsize_t maxResults );
+
+	//-- implementation of QAbstractItemModel's virtual methods --------------------------------------------------------
+
+	virtual QModelIndex index( int row, int column, const QModelIndex & parent = QModelIndex() ) const override;
+	virtual QModelIndex parent( const QModelIndex & index ) const override;
+
+	virtual int rowCount( const QModelIndex & parent = QModelIndex() ) const override;
+	virtual int columnCount( const QModelIndex & parent = QModelIndex() ) const override;
+	virtual bool hasChildren( const QModelIndex & parent = QModelIndex() ) const override;
+
+	virtual bool canFetchMore( const QModelIndex & parent ) const override;
+	virtual void fetchMore( const QModelIndex & parent ) override;
+
+	virtual QVariant data( const QModelIndex & index, int role ) const override;
+	virtual QVariant headerData( int section, Qt::Orientation orientation, int role = Qt::DisplayRole ) const override;
+	virtual Qt::ItemFlags flags( const QModelIndex & index ) const override;
+
+	virtual QStringList mimeTypes() const override;
+	virtual QMimeData * mimeData( const QModelIndexList & indexes ) const override;
+	virtual Qt::DropActions supportedDragActions() const override;
+
+	virtual void sort( int column, Qt::SortOrder order = Qt::AscendingOrder ) override;
+
+ signals:
+
+	/// Emitted when the content of a directory has been read, same as QFileSystemModel::directoryLoaded.
+	void directoryLoaded( const QString & path );
+
+	/// Emitted when the scan of the whole tree has finished and searchEntries() can find the new entries.
+	void searchIndexUpdated();
+
+ private slots:
+
+	void onDirectoryChanged( const QString & path );
+	void flushWadInfoUpdates();
+	void onResortTimerExpired();
+	void startTreeScan();
+	void verifyScannedDirs();
+
+ private: // internal types
+
+	struct Node;
+
+	/// Properties of a file-system entry needed to create its node, they can be read in a worker thread.
+	struct EntryInfo
+	{
+		QString name;
+		QString suffix;
+		bool isDir = false;
+		bool isSymLink = false;
+		qint64 size = 0;
+		QDateTime lastModified;
+	};
+	using DirListings = QHash< QString, QVector< EntryInfo > >;  ///< normalized dir path -> entries of the directory
+
+	friend class ReadWadInfoTask;
+	friend class ScanTreeTask;
+
+ private: // helpers
+
+	Node * nodeFromIndex( const QModelIndex & index ) const;
+	QModelIndex indexFromNode( const Node * node, int column = 0 ) const;
+	Node * findNodeByPath( const QString & path ) const;
+	Node * findOrLoadNodeByPath( const QString & path );
+
+	/// Reads the directory with the given filters, the same way for the whole-tree scan and the individual directories.
+	static QVector< EntryInfo > listDir( const QString & dirPath, const QStringList & nameFilters, QDir::Filters filters );
+
+	std::unique_ptr< Node > makeNode( Node * parent, const EntryInfo & entry );
+	void populateDir( Node & dirNode );
+	void refreshDir( Node & dirNode );
+	void unregisterSubtree( Node & node );
+	void sortChildren( Node & dirNode ) const;
+	void sortChildrenRecursively( Node & dirNode ) const;
+	void sortPreservingPersistentIndexes();
+
+	void requestWadInfo( Node & fileNode );
+	/// Called in the main thread by the background task, when the WAD has been read.
+	void onWadInfoRead( const QString & filePath, qint64 lastModified, uint generation, const doom::UncertainWadInfo & wadInfo );
+	void applyWadInfo( Node & fileNode, const doom::UncertainWadInfo & wadInfo );
+
+	bool isSortedByWadInfo() const  { return _sortColumn >= MapCountColumn; }
+
+	/// Called in the main thread by the background task, when the whole directory tree has been scanned.
+	void onTreeScanned( uint generation, DirListings && dirListings, TrigramIndex && searchIndex );
+
+ private: // members
+
+	std::unique_ptr< Node > _rootNode;
+	QHash< QString, Node * > _nodesByPath;   ///< quick lookup of already loaded nodes by their normalized path
+
+	QFileSystemWatcher _dirWatcher;          ///< keeps the loaded directories up to date
+	QThreadPool _workerPool;                 ///< reads the WAD files in background
+	uint _generation = 0;                    ///< incremented on every root change, to discard results of outdated tasks
+
+	QHash< QString, Node * > _pendingUpdates;  ///< nodes whose WAD info arrived but the view hasn't been notified yet
+	QTimer _updateTimer;                     ///< coalesces the incoming WAD info into fewer dataChanged signals
+	QTimer _resortTimer;                     ///< coalesces re-sorting when sorted by a column whose values keep arriving
+
+	TrigramIndex _searchIndex;               ///< paths of all entries in the tree relative to the root directory
+	QTimer _reindexTimer;                    ///< coalesces re-scanning when the directories are being modified
+	DirListings _scannedDirs;                ///< listings from the last scan, for the directories not populated yet
+	QStringList _dirsToVerify;               ///< directories populated from the scan, they might have changed since then
+	QTimer _verifyTimer;                     ///< postpones the verification until the user stops navigating
+
+	// configuration
+	QDir::Filters _filters = QDir::AllDirs | QDir::Files | QDir::NoDotAndDotDot;
+	QStringList _nameFilters;
+	bool _iconsEnabled = false;
+	int _sortColumn = NameColumn;
+	Qt::SortOrder _sortOrder = Qt::AscendingOrder;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // MAP_PACK_TREE_MODEL_INCLUDED
@@ -0,0 +1,118 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: logic of the dialog that shows the launch latency and session duration of the presets
+//======================================================================================================================
+
+#include "LaunchStatsDialog.hpp"
+#include "ui_LaunchStatsDialog.h"
+
+#include <QTableWidgetItem>
+#include <QHeaderView>
+#include <QDateTime>
+#include <QStringBuilder>
+
+
+//======================================================================================================================
+
+enum Column
+{
+	PresetColumn,
+	EngineColumn,
+	LaunchCountColumn,
+	FailedCountColumn,
+	LastLaunchColumn,
+	StartTimeColumn,
+	FirstOutputColumn,
+	SessionColumn,
+};
+
+/// Displays a text, but sorts by a number stored in the Qt::UserRole.
+class NumericItem : public QTableWidgetItem {
+ public:
+	NumericItem( const QString & text, qint64 sortValue ) : QTableWidgetItem( text )
+	{
+		setData( Qt::UserRole, sortValue );
+		setTextAlignment( Qt::AlignRight | Qt::AlignVCenter );
+	}
+	bool operator<( const QTableWidgetItem & other ) const override
+	{
+		return data( Qt::UserRole ).toLongLong() < other.data( Qt::UserRole ).toLongLong();
+	}
+};
+
+static QTableWidgetItem * makePercentilesItem( const Percentiles & values, double divisor )
+{
+	if (values.count == 0)
+	{
+		return new NumericItem( "-", -1 );
+	}
+
+	auto format = [ divisor ]( qint64 value ) { return QString::number( double( value ) / divisor, 'f', 1 ); };
+	QString text = format( values.p50 ) % " / " % format( values.p90 ) % " / " % format( values.last );
+	auto * item = new NumericItem( text, values.p50 );
+	item->setToolTip( QStringLiteral("measured %1 times, 99th percentile: %2").arg( values.count ).arg( format( values.p99 ) ) );
+	return item;
+}
+
+
+//======================================================================================================================
+
+LaunchStatsDialog::LaunchStatsDialog(
+	QWidget * parent, const QList< LaunchStatsSummary > & summaries, const QString & selectedPreset
+)
+:
+	QDialog( parent ),
+	DialogCommon( this, u"LaunchStatsDialog" )
+{
+	ui = new Ui::LaunchStatsDialog;
+	ui->setupUi( this );
+
+	fillTable( summaries, selectedPreset );
+
+	connect( ui->buttonBox, &QDialogButtonBox::rejected, this, &ThisClass::reject );  // Close button is a reject role
+}
+
+LaunchStatsDialog::~LaunchStatsDialog()
+{
+	delete ui;
+}
+
+void LaunchStatsDialog::fillTable( const QList< LaunchStatsSummary > & summaries, const QString & selectedPreset )
+{
+	QTableWidget * table = ui->statsTable;
+
+	table->setSortingEnabled( false );  // otherwise the rows would be re-sorted while being filled
+	table->setRowCount( int( summaries.size() ) );
+
+	int row = 0;
+	for (const LaunchStatsSummary & summary : summaries)
+	{
+		table->setItem( row, PresetColumn, new QTableWidgetItem( summary.presetName ) );
+		table->setItem( row, EngineColumn, new QTableWidgetItem( summary.engineName ) );
+		table->setItem( row, LaunchCountColumn, new NumericItem( QString::number( summary.launchCount ), summary.launchCount ) );
+		table->setItem( row, FailedCountColumn, new NumericItem( QString::number( summary.failedCount ), summary.failedCount ) );
+		QString lastLaunch = QDateTime::fromMSecsSinceEpoch( summary.lastLaunchTime ).toString("yyyy-MM-dd hh:mm");
+		table->setItem( row, LastLaunchColumn, new NumericItem( lastLaunch, summary.lastLaunchTime ) );
+		table->setItem( row, StartTimeColumn, makePercentilesItem( summary.spawnTimeUs, 1000.0 ) );
+		table->setItem( row, FirstOutputColumn, makePercentilesItem( summary.firstOutputMs, 1.0 ) );
+		table->setItem( row, SessionColumn, makePercentilesItem( summary.sessionDurationMs, 60000.0 ) );
+		++row;
+	}
+
+	table->setSortingEnabled( true );
+	table->sortByColumn( PresetColumn, Qt::AscendingOrder );
+	table->horizontalHeader()->resizeSections( QHeaderView::ResizeToContents );
+
+	// point the user to the currently selected preset
+	for (row = 0; row < table->rowCount(); ++row)
+	{
+		if (table->item( row, PresetColumn )->text() == selectedPreset)
+		{
+			table->selectRow( row );
+			table->scrollToItem( table->item( row, PresetColumn ) );
+			break;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: logic of the dialog that shows the launch latency and session duration of the presets
+//======================================================================================================================
+
+#ifndef LAUNCH_STATS_DIALOG_INCLUDED
+#define LAUNCH_STATS_DIALOG_INCLUDED
+
+
+#include "DialogCommon.hpp"
+
+#include "LaunchStatistics.hpp"  // LaunchStatsSummary
+
+#include <QDialog>
+
+namespace Ui
+{
+	class LaunchStatsDialog;
+}
+
+
+//======================================================================================================================
+
+class LaunchStatsDialog : public QDialog, private DialogCommon {
+
+	Q_OBJECT
+
+	using ThisClass = LaunchStatsDialog;
+
+ public:
+
+	/// \param selectedPreset Rows of this preset will be selected, can be empty.
+	explicit LaunchStatsDialog(
+		QWidget * parent, const QList< LaunchStatsSummary > & summaries, const QString & selectedPreset
+	);
+	virtual ~LaunchStatsDialog() override;
+
+ private: // methods
+
+	void fillTable( const QList< LaunchStatsSummary > & summaries, const QString & selectedPreset );
+
+ private: // members
+
+	Ui::LaunchStatsDialog * ui;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // LAUNCH_STATS_DIALOG_INCLUDED
@@ -10,6 +10,7 @@
 
 #include "Utils/WidgetUtils.hpp"  // setTextColor
 #include "Utils/FileSystemUtils.hpp"  // getFileNameFromPath
+#include "Utils/OSUtils.hpp"  // makeProcessEnvironment, spawnDetachedProcess, setProcessScheduling
 #include "Utils/ErrorHandling.hpp"
 
 #include <QTextEdit>
@@ -187,7 +188,8 @@ void ProcessOutputWindow::setOwnStatus( ProcessStatus status, const QString & de
 }
 
 ProcessStatus ProcessOutputWindow::runProcess(
-	const QString & executable, const QStringList & arguments, const QString & workingDir, const EnvVars & envVars
+	const QString & executable, const QStringList & arguments, const QString & workingDir, const EnvVars & envVars,
+	const os::ProcessScheduling & scheduling, const LaunchStatsRecorder & stats
 ){
 	logDebug( u"runProcess" ) << executable;
 
@@ -199,12 +201,9 @@ ProcessStatus ProcessOutputWindow::runProcess(
 	process.setWorkingDirectory( workingDir );
 	process.setProcessChannelMode( QProcess::MergedChannels );  // merge stdout and stderr
 
-	QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-	for (const auto & envVar : envVars)
-	{
-		env.insert( envVar.name, envVar.value );
-	}
-	process.setProcessEnvironment( env );
+	process.setProcessEnvironment( os::makeProcessEnvironment( envVars ) );
+	this->scheduling = scheduling;
+	this->stats = stats;
 
 	connect( &process, &QProcess::started, this, &ThisClass::onProcessStarted );
 	connect( &process, &QProcess::readyReadStandardOutput, this, &ThisClass::readProcessOutput );
@@ -214,6 +213,7 @@ ProcessStatus ProcessOutputWindow::runProcess(
 	setOwnStatus( ProcessStatus::Starting );
 
 	// start asynchronously and wait for signals
+	sessionTimer.start();
 	process.start();
 
 	// When the error occurs early and the signal is sent from within process.start(),
@@ -230,29 +230,72 @@ ProcessStatus ProcessOutputWindow::runProcess(
 	return ownStatus;
 }
 
+static void reportSchedulingError( QWidget * parent, const QString & executableName, const QString & error )
+{
+	::reportRuntimeError( parent, "Process scheduling error",
+		"Failed to apply the scheduling options to \""%executableName%"\" ("%error%"). "
+		"The process will keep running with the launcher's ones."
+	);
+}
+
 bool startDetachedProcess(
-	const QString & executable, const QStringList & arguments, const QString & workingDir, const EnvVars & envVars
+	const QString & executable, const QStringList & arguments, const QString & workingDir, const EnvVars & envVars,
+	const os::ProcessScheduling & scheduling, const LaunchStatsRecorder & stats
 ){
-	QProcess process;
-
 	QString executableName = fs::getFileNameFromPath( executable );
 
-	process.setProgram( executable );
-	process.setArguments( arguments );
-	process.setWorkingDirectory( workingDir );
+	QElapsedTimer sessionTimer;
+	sessionTimer.start();
 
-	QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-	for (const auto & envVar : envVars)
+	// QProcess::startDetached() forks twice and copies the whole environment, spawning the process directly avoids that.
+	if (os::canSpawnDetachedProcess())
 	{
-		env.insert( envVar.name, envVar.value );
+		// the launcher collects the exit status of the process anyway, so it can measure the session
+		os::ProcessExitCallback onExit;
+		if (stats.isActive())
+		{
+			onExit = [ stats, sessionTimer ]( int exitCode )
+			{
+				stats.recordExit( exitCode, sessionTimer.elapsed() );
+			};
+		}
+
+		QString schedulingError;
+		QString error = os::spawnDetachedProcess(
+			executable, arguments, workingDir, envVars, scheduling, &schedulingError, std::move( onExit )
+		);
+		stats.recordStart( error.isEmpty() ? sessionTimer.nsecsElapsed() / 1000 : -1 );
+		if (!error.isEmpty())
+		{
+			::reportRuntimeError( nullptr, "Process start error", "Failed to start \""%executableName%"\" ("%error%")" );
+		}
+		else if (!schedulingError.isEmpty())
+		{
+			reportSchedulingError( nullptr, executableName, schedulingError );
+		}
+		return error.isEmpty();
 	}
-	process.setProcessEnvironment( env );
 
-	bool success = process.startDetached();
+	QProcess process;
+
+	process.setProgram( executable );
+	process.setArguments( arguments );
+	process.setWorkingDirectory( workingDir );
+	process.setProcessEnvironment( os::makeProcessEnvironment( envVars ) );
+
+	qint64 pid = 0;
+	bool success = process.startDetached( &pid );
+	stats.recordStart( success ? sessionTimer.nsecsElapsed() / 1000 : -1 );
 	if (!success)
 	{
 		::reportRuntimeError( nullptr, "Process start error", "Failed to start \""%executableName%"\" ("%process.errorString()%")" );
 	}
+	else if (!scheduling.isDefault())
+	{
+		QString schedulingError = os::setProcessScheduling( pid, scheduling );
+		if (!schedulingError.isEmpty())
+			reportSchedulingError( nullptr, executableName, schedulingError );
+	}
 
 	return success;
 }
@@ -262,11 +305,28 @@ void ProcessOutputWindow::onProcessStarted()
 	logDebug( u"processStarted" );
 
 	setOwnStatus( ProcessStatus::Running );
+
+	stats.recordStart( sessionTimer.nsecsElapsed() / 1000 );
+
+	if (!scheduling.isDefault())
+	{
+		QString schedulingError = os::setProcessScheduling( process.processId(), scheduling );
+		if (!schedulingError.isEmpty())
+			reportSchedulingError( this, executableName, schedulingError );
+	}
 }
 
 void ProcessOutputWindow::readProcessOutput()
 {
 	QByteArray output = process.readAllStandardOutput();
+
+	// stderr is merged into stdout, so this is the first byte of either of them
+	if (!firstOutputReceived && !output.isEmpty())
+	{
+		firstOutputReceived = true;
+		stats.recordFirstOutput( sessionTimer.elapsed() );
+	}
+
 	if constexpr (IS_WINDOWS)
 	{
 		output.replace( "\r\n", "\n" );
@@ -313,6 +373,9 @@ void ProcessOutputWindow::onProcessFinished( int exitCode, QProcess::ExitStatus
 	if (ui == nullptr)
 		return;
 
+	// Qt doesn't provide the signal number of a crashed process, so -1 is recorded for all crashes (see os::ProcessExitCallback)
+	stats.recordExit( exitStatus == QProcess::CrashExit ? -1 : exitCode, sessionTimer.elapsed() );
+
 	if (ownStatus == ProcessStatus::ShuttingDown)  // user requested to terminate the process and now it finally shut down
 	{
 		setOwnStatus( ProcessStatus::Terminated );
@@ -373,11 +436,13 @@ void ProcessOutputWindow::onErrorOccurred( QProcess::ProcessError error )
 	switch (error)
 	{
 		case QProcess::FailedToStart:
+			stats.recordStart( -1 );
 			setOwnStatus( ProcessStatus::FailedToStart );
 			reportRuntimeError( "Process start error", "Failed to start \""%executableName%"\" ("%process.errorString()%")" );
 			closeDialog( QDialog::Accepted );
 			break;
 		case QProcess::Timedout:
+			stats.recordStart( -1 );
 			setOwnStatus( ProcessStatus::FailedToStart );
 			reportRuntimeError( "Process start timeout", "\""%executableName%"\" process has timed out while starting." );
 			closeDialog( QDialog::Accepted );
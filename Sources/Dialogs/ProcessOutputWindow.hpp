@@ -11,11 +11,13 @@
 
 #include "DialogCommon.hpp"
 
-#include "UserData.hpp"  // EnvVars
+#include "UserData.hpp"  // EnvVars, ProcessScheduling
+#include "LaunchStatistics.hpp"  // LaunchStatsRecorder
 #include "Utils/EventFilters.hpp"
 
 #include <QDialog>
 #include <QProcess>
+#include <QElapsedTimer>
 class QPushButton;
 class QCloseEvent;
 
@@ -74,10 +76,13 @@ class ProcessOutputWindow : public QDialog, private DialogCommon {
 	  * \param workingDir Working directory for the started process. All file paths given via arguments must be relative to this.
 	  *                   If not specified, the current working directory is used.
 	  * \param envVars Optional evironment variables to be set for the starting process.
+	  * \param scheduling Optional scheduling options to be applied to the process once it starts.
+	  * \param stats Optional recorder of the start latency, time to the first output, exit code and session duration.
 	  * \return In which state the process was when the the dialog was closed.
 	  */
 	ProcessStatus runProcess(
-		const QString & executable, const QStringList & arguments, const QString & workingDir = {}, const EnvVars & envVars = {}
+		const QString & executable, const QStringList & arguments, const QString & workingDir = {}, const EnvVars & envVars = {},
+		const os::ProcessScheduling & scheduling = {}, const LaunchStatsRecorder & stats = {}
 	);
 
  private slots:
@@ -106,6 +111,11 @@ class ProcessOutputWindow : public QDialog, private DialogCommon {
 	QPushButton * closeBtn;  ///< shortcut to the Close button in the list of ui->buttonBox
 
 	QProcess process;
+	os::ProcessScheduling scheduling;  ///< QProcess cannot apply these before the process starts, so they are applied afterwards
+
+	LaunchStatsRecorder stats;
+	QElapsedTimer sessionTimer;   ///< measures the time since the process start was requested
+	bool firstOutputReceived = false;
 
 	QString executableName;
 
@@ -123,8 +133,11 @@ class ProcessOutputWindow : public QDialog, private DialogCommon {
 //----------------------------------------------------------------------------------------------------------------------
 
 /// Alternative to ProcessOutputWindow::runProcess(). Starts the process, detaches from it, and ignores its output.
+/** The start latency is always recorded into the stats, the exit code and session duration only where the system
+  * allows waiting for the detached process. */
 bool startDetachedProcess(
-	const QString & executable, const QStringList & arguments, const QString & workingDir = {}, const EnvVars & envVars = {}
+	const QString & executable, const QStringList & arguments, const QString & workingDir = {}, const EnvVars & envVars = {},
+	const os::ProcessScheduling & scheduling = {}, const LaunchStatsRecorder & stats = {}
 );
 
 
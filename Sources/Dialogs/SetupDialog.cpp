@@ -78,6 +78,7 @@ SetupDialog::SetupDialog(
 	ui->absolutePathsChkBox->setChecked( settings.pathStyle.isAbsolute() );
 	ui->showEngineOutputChkBox->setChecked( settings.showEngineOutput );
 	ui->closeOnLaunchChkBox->setChecked( settings.closeOnLaunch );
+	ui->warmUpGameFilesChkBox->setChecked( settings.warmUpGameFiles );
 
 	ui->styleCmbBox->addItem( "System default" );
 	ui->styleCmbBox->addItems( themes::getAvailableAppStyles() );
@@ -120,6 +121,7 @@ SetupDialog::SetupDialog(
 
 	connect( ui->showEngineOutputChkBox, &QCheckBox::toggled, this, &ThisClass::onShowEngineOutputToggled );
 	connect( ui->closeOnLaunchChkBox, &QCheckBox::toggled, this, &ThisClass::onCloseOnLaunchToggled );
+	connect( ui->warmUpGameFilesChkBox, &QCheckBox::toggled, this, &ThisClass::onWarmUpGameFilesToggled );
 
 	connect( ui->doneBtn, &QPushButton::clicked, this, &ThisClass::accept );
 
@@ -265,7 +267,7 @@ void setSelectedItemAsDefault( QListView * view, ListModel & model, QAction * se
 	defaultItemID = selectedItem->getID();
 
 	// unmark the previous default entry
-	int prevIdx = findSuch( model, [&]( const auto & item ){ return item.getID() == prevDefaultItemID; } );
+	int prevIdx = int( model.findIndexByID( prevDefaultItemID ) );
 	if (prevIdx >= 0)
 		unmarkItemAsDefault( model[ prevIdx ] );
 
@@ -302,7 +304,7 @@ void SetupDialog::engineAdd()
 
 void SetupDialog::engineDelete()
 {
-	int defaultIndex = findSuch( engineModel, [&]( const Engine & e ){ return e.getID() == engineSettings.defaultEngine; } );
+	int defaultIndex = int( engineModel.findIndexByID( engineSettings.defaultEngine ) );
 
 	const auto removedIndexes = wdg::removeSelectedItems( ui->engineListView, engineModel );
 
@@ -418,7 +420,7 @@ void SetupDialog::iwadAdd()
 
 void SetupDialog::iwadDelete()
 {
-	int defaultIndex = findSuch( iwadModel, [&]( const IWAD & i ){ return i.getID() == iwadSettings.defaultIWAD; } );
+	int defaultIndex = int( iwadModel.findIndexByID( iwadSettings.defaultIWAD ) );
 
 	const auto removedIndexes = wdg::removeSelectedItems( ui->iwadListView, iwadModel );
 
@@ -549,7 +551,7 @@ void SetupDialog::updateIWADsFromDir()
 	if (!iwadSettings.defaultIWAD.isEmpty())
 	{
 		// the default item marking was lost during the update, mark it again
-		int defaultIdx = findSuch( iwadModel, [&]( const IWAD & i ){ return i.getID() == iwadSettings.defaultIWAD; } );
+		int defaultIdx = int( iwadModel.findIndexByID( iwadSettings.defaultIWAD ) );
 		if (defaultIdx >= 0)
 			markItemAsDefault( iwadModel[ defaultIdx ] );
 	}
@@ -618,12 +620,12 @@ void SetupDialog::onAbsolutePathsToggled( bool checked )
 
 	iwadSettings.dir = pathConvertor.convertPath( iwadSettings.dir );
 	ui->iwadDirLine->setText( iwadSettings.dir );
-	engineModel.startEditingItemData();
+	iwadModel.startEditingItemData();
 	for (IWAD & iwad : iwadModel)
 	{
 		iwad.path = pathConvertor.convertPath( iwad.path );
 	}
-	engineModel.finishEditingItemData( 0, -1, AListModel::onlyDisplayRole );
+	iwadModel.finishEditingItemData( 0, -1, AListModel::onlyDisplayRole );
 
 	mapSettings.dir = pathConvertor.convertPath( mapSettings.dir );
 	ui->mapDirLine->setText( mapSettings.dir );
@@ -650,3 +652,8 @@ void SetupDialog::onCloseOnLaunchToggled( bool checked )
 		ui->showEngineOutputChkBox->setChecked( false );
 	}
 }
+
+void SetupDialog::onWarmUpGameFilesToggled( bool checked )
+{
+	settings.warmUpGameFiles = checked;
+}
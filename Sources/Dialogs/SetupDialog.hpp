@@ -111,6 +111,7 @@ class SetupDialog : public QDialog, public DialogWithPaths {
 
 	void onShowEngineOutputToggled( bool checked );
 	void onCloseOnLaunchToggled( bool checked );
+	void onWarmUpGameFilesToggled( bool checked );
 
  private: // methods
 
@@ -0,0 +1,752 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: generation of the engine's launch command from the user data, independent of the UI
+//======================================================================================================================
+
+#include "LaunchCommandBuilder.hpp"
+
+#include "DoomFiles.hpp"  // demoFileSuffix
+#include "Utils/FileSystemUtils.hpp"  // PathRebaser, quoted
+#include "Utils/AsyncPathChecker.hpp"  // checkPathsInParallel
+#include "Utils/OSUtils.hpp"  // getRunCommand
+#include "Utils/DoomModBundles.hpp"
+#include "Utils/LangUtils.hpp"  // isFlagSet, correspondingValue
+#include "Utils/StringUtils.hpp"  // capitalize
+#include "Utils/MiscUtils.hpp"  // splitCommandLineArguments
+
+#include <QStringBuilder>
+#include <QFileInfo>
+
+
+//======================================================================================================================
+// helpers
+
+static int launchCmdPartIndex( LaunchCmdPart::Values part )
+{
+	int index = 0;
+	for (uint flag = part; flag > 1; flag >>= 1)
+		++index;
+	return index;
+}
+
+static void appendCustomArguments( QStringList & args, const QString & customArgsStr, bool quotePaths )
+{
+	auto splitArgs = splitCommandLineArguments( customArgsStr );
+	for (auto & arg : splitArgs)
+	{
+		if (quotePaths && arg.wasQuoted)
+			args << quoted( arg.str );
+		else
+			args << std::move( arg.str );
+	}
+};
+
+static void prependCommandWith( os::ShellCommand & cmd, const QString & cmdPrefix, bool quotePaths )
+{
+	QStringList cmdParts;
+	appendCustomArguments( cmdParts, cmdPrefix, quotePaths );
+	cmdParts << std::move( cmd.executable );
+	cmdParts << std::move( cmd.arguments );
+
+	cmd.executable = cmdParts.takeFirst();
+	cmd.arguments = std::move( cmdParts );
+}
+
+// Executes the loopBody functor for every file path in that pack. Sub-packs are expanded recursively.
+// If bundleCycles is not null, descriptions of the bundles including themselves are appended to it.
+template< typename Entry, typename Functor >
+static void expandDMB( const QString & filePath, const Functor & loopBody, QStringList * bundleCycles )
+{
+	// The expansion is cached until some of the bundles changes, so this is cheap to call on every re-generation.
+	const QStringList entries = dmb::getExpandedEntries( filePath, bundleCycles );
+	for (const QString & path : entries)
+	{
+		loopBody( Entry( path ) );
+	}
+}
+
+// Iterates over a list of selected map files where each Doom Mod Bundle (.dmb) is fully expanded.
+template< typename Functor >
+static void forEachMapFileWithExpandedDMBs(
+	const QStringList & selectedMapPacks, const Functor & loopBody, QStringList * bundleCycles = nullptr
+)
+{
+	for (const QString & mapFilePath : selectedMapPacks)
+	{
+		if (fs::getFileSuffix( mapFilePath ) == dmb::fileSuffix)
+		{
+			expandDMB< QString >( mapFilePath, loopBody, bundleCycles );
+		}
+		else
+		{
+			loopBody( mapFilePath );
+		}
+	}
+}
+
+// Iterates over a list of checked mod files where each Doom Mod Bundle (.dmb) is fully expanded.
+template< typename Functor >
+static void forEachCheckedModFileWithExpandedDMBs(
+	const PtrList< Mod > & mods, const Functor & loopBody, QStringList * bundleCycles = nullptr
+)
+{
+	for (const Mod & mod : mods)
+	{
+		if (!mod.isSeparator && mod.checked)
+		{
+			if (fs::getFileSuffix( mod.path ) == dmb::fileSuffix)
+			{
+				expandDMB< Mod >( mod.path, loopBody, bundleCycles );
+			}
+			else
+			{
+				loopBody( mod );
+			}
+		}
+	}
+}
+
+// Which options are available is decided by the same rules that enable or disable the corresponding widgets.
+
+static bool isDirectLaunch( LaunchMode mode )
+{
+	return mode == LaunchMap || mode == RecordDemo;
+}
+
+static bool areGameplayOptionsAvailable( LaunchMode mode )
+{
+	return isDirectLaunch( mode ) || mode == Default;
+}
+
+// Gathers the paths of the files and dirs that the requested parts will verify, so that they can be checked all at once.
+// The paths that are not listed here are simply checked one by one during the generation.
+static QStringList collectPathsToVerify( const LaunchCommandInput & input, LaunchCmdParts parts, const EngineInfo & engine )
+{
+	QStringList paths;
+
+	if (isFlagSet( parts, LaunchCmdPart::Engine ))
+		paths.append( engine.getFilePath() );
+	if (isFlagSet( parts, LaunchCmdPart::Config ) && !input.configFilePath.isEmpty())
+		paths.append( input.configFilePath );
+	if (isFlagSet( parts, LaunchCmdPart::IWAD ) && input.iwad)
+		paths.append( input.iwad->getFilePath() );
+
+	if (isFlagSet( parts, LaunchCmdPart::Files ))
+	{
+		forEachMapFileWithExpandedDMBs( input.selectedMapPacks, [&]( const QString & mapFilePath )
+		{
+			paths.append( mapFilePath );
+		});
+		if (input.mods)
+		{
+			forEachCheckedModFileWithExpandedDMBs( *input.mods, [&]( const Mod & mod )
+			{
+				if (!mod.isCmdArg)
+					paths.append( mod.getFilePath() );
+			});
+		}
+	}
+
+	if (isFlagSet( parts, LaunchCmdPart::AltDirs ))
+	{
+		if (!input.altSaveDir.isEmpty())
+			paths.append( input.altSaveDir );
+		if (!input.altScreenshotDir.isEmpty())
+			paths.append( input.altScreenshotDir );
+	}
+
+	return paths;
+}
+
+
+//======================================================================================================================
+// path verification
+
+/// Verifies the paths the same way as PathChecker, but collects the errors into the report instead of displaying them.
+class PathVerifier {
+
+	enum class EntryType
+	{
+		File,
+		Dir,
+		Both
+	};
+
+	using cStrRef = const QString &;  // for shorter function signatures
+
+	LaunchCmdReport & report;
+	bool verificationRequired;
+	AsyncPathChecker * resultMemo;
+	AsyncPathChecker::Results prefetchedStatuses;  ///< results of prefetch(), the paths not found here are checked one by one
+
+ public:
+
+	PathVerifier( LaunchCmdReport & report, bool verificationRequired, AsyncPathChecker * resultMemo )
+		: report( report ), verificationRequired( verificationRequired ), resultMemo( resultMemo ) {}
+
+	/// Checks all the paths at once in parallel, so that the following checks of these paths don't have to wait
+	/// for the file-system one by one. Does nothing if the verification is not required.
+	void prefetch( const QStringList & paths )
+	{
+		if (!verificationRequired)
+			return;
+
+		// The memo is not consulted, the files might have been deleted since they were checked, but it gets refreshed.
+		prefetchedStatuses = checkPathsInParallel( paths, resultMemo );
+	}
+
+	void checkAnyPath( cStrRef path, cStrRef subjectName, cStrRef errorPostscript )
+	{
+		checkPath( path, EntryType::Both, subjectName, errorPostscript, nullptr );
+	}
+	void checkFilePath( cStrRef path, cStrRef subjectName, cStrRef errorPostscript )
+	{
+		checkPath( path, EntryType::File, subjectName, errorPostscript, nullptr );
+	}
+	void checkDirPath( cStrRef path, cStrRef subjectName, cStrRef errorPostscript )
+	{
+		checkPath( path, EntryType::Dir, subjectName, errorPostscript, nullptr );
+	}
+	template< typename ListItem >
+	void checkItemAnyPath( const ListItem & item, cStrRef subjectName, cStrRef errorPostscript )
+	{
+		checkItemPath( item, EntryType::Both, subjectName, errorPostscript );
+	}
+	template< typename ListItem >
+	void checkItemFilePath( const ListItem & item, cStrRef subjectName, cStrRef errorPostscript )
+	{
+		checkItemPath( item, EntryType::File, subjectName, errorPostscript );
+	}
+
+	void checkOverwrite( cStrRef path, cStrRef subjectName, cStrRef errorPostscript )
+	{
+		if (!verificationRequired)
+			return;
+
+		PathStatus status = getPathStatus( path );
+		if (status == PathStatus::Dir)
+		{
+			addIssue( LaunchCmdIssue::InvalidPath, "Path is a directory",
+				capitalize(subjectName)%" ("%path%") is a directory, but a file is expected. "%errorPostscript, path, nullptr );
+		}
+		else if (status == PathStatus::File)
+		{
+			addIssue( LaunchCmdIssue::FileExists, "Overwrite existing file",
+				capitalize(subjectName)%" ("%path%") already exists. Do you want to overwrite it?", path, nullptr );
+		}
+	}
+
+ private:
+
+	template< typename ListItem >
+	void checkItemPath( const ListItem & item, EntryType expectedType, cStrRef subjectName, cStrRef errorPostscript )
+	{
+		if (!verificationRequired)
+			return;
+
+		report.verifiedItems.append( &item );
+		checkPath( item.getFilePath(), expectedType, subjectName, errorPostscript, &item );
+	}
+
+	void checkPath( cStrRef path, EntryType expectedType, cStrRef subjectName, cStrRef errorPostscript, const AModelItem * item )
+	{
+		if (!verificationRequired)
+			return;
+
+		if (!item)
+			report.verifiedPaths.append( path );
+
+		if (path.isEmpty())
+		{
+			addIssue( LaunchCmdIssue::InvalidPath, "Path is empty",
+				"Path of "%subjectName%" is empty. "%errorPostscript, path, item );
+			return;
+		}
+
+		PathStatus status = getPathStatus( path );
+		if (status == PathStatus::Missing)
+		{
+			QString fileOrDir = correspondingValue( expectedType,
+				correspondsTo( EntryType::File, "File" ),
+				correspondsTo( EntryType::Dir,  "Directory" ),
+				correspondsTo( EntryType::Both, "File or directory" )
+			);
+			addIssue( LaunchCmdIssue::InvalidPath, fileOrDir%" no longer exists",
+				capitalize(subjectName)%" ("%path%") no longer exists. "%errorPostscript, path, item );
+		}
+		else if (expectedType == EntryType::File && status != PathStatus::File)
+		{
+			addIssue( LaunchCmdIssue::InvalidPath, "Path is a directory",
+				capitalize(subjectName)%" ("%path%") is a directory, but a file is expected. "%errorPostscript, path, item );
+		}
+		else if (expectedType == EntryType::Dir && status != PathStatus::Dir)
+		{
+			addIssue( LaunchCmdIssue::InvalidPath, "Path is a file",
+				capitalize(subjectName)%" ("%path%") is a file, but a directory is expected. "%errorPostscript, path, item );
+		}
+	}
+
+	PathStatus getPathStatus( cStrRef path ) const
+	{
+		auto statusIter = prefetchedStatuses.constFind( path );
+		if (statusIter != prefetchedStatuses.constEnd())
+			return statusIter.value();
+
+		QFileInfo entry( path );
+		return !entry.exists() ? PathStatus::Missing
+		     : entry.isDir()   ? PathStatus::Dir
+		                       : PathStatus::File;
+	}
+
+	void addIssue( LaunchCmdIssue::Type type, QString title, QString message, cStrRef path, const AModelItem * item )
+	{
+		report.issues.append({ type, std::move( title ), std::move( message ), path, item });
+	}
+
+};
+
+static void addInputIssue( LaunchCmdReport & report, QString title, QString message )
+{
+	report.issues.append({ LaunchCmdIssue::InvalidInput, std::move( title ), std::move( message ) });
+}
+
+
+//======================================================================================================================
+// LaunchCommandBuilder
+
+os::ShellCommand LaunchCommandBuilder::generate( const LaunchCommandInput & input, LaunchCmdReport & report )
+{
+	LaunchCmdSections sections;
+	bool pathsValid = generateParts( input, LaunchCmdPart::All, sections, report );
+	return pathsValid ? joinParts( sections ) : os::ShellCommand{};
+}
+
+os::ShellCommand LaunchCommandBuilder::joinParts( const LaunchCmdSections & sections )
+{
+	os::ShellCommand cmd = sections.engineCmd;
+	for (const QStringList & partArgs : sections.args)
+		cmd.arguments << partArgs;
+	return cmd;
+}
+
+QStringList LaunchCommandBuilder::getGameFilePaths( const LaunchCommandInput & input )
+{
+	QStringList filePaths;
+
+	if (input.iwad && !input.iwad->path.isEmpty())
+		filePaths.append( input.iwad->path );
+
+	forEachMapFileWithExpandedDMBs( input.selectedMapPacks, [&]( const QString & mapFilePath )
+	{
+		filePaths.append( mapFilePath );
+	});
+
+	if (input.mods)
+	{
+		forEachCheckedModFileWithExpandedDMBs( *input.mods, [&]( const Mod & mod )
+		{
+			if (!mod.isCmdArg && !mod.path.isEmpty())
+				filePaths.append( mod.path );
+		});
+	}
+
+	return filePaths;
+}
+
+bool LaunchCommandBuilder::generateParts(
+	const LaunchCommandInput & input, LaunchCmdParts partsToGenerate, LaunchCmdSections & sections, LaunchCmdReport & report
+){
+	const LaunchCommandOptions & opts = _opts;  // let's make it little shorter
+	const EngineInfo & engine = opts.selectedEngine;
+
+	const QString engineExeDir = fs::getAbsoluteParentDir( engine.executablePath );
+
+	// The stored engine path is relative to DoomRunner's directory, but we need it relative to runnersWorkingDir.
+	PathRebaser runnersDirRebaser( input.workingDir, opts.runnersWorkingDir, opts.quotePaths );
+	runnersDirRebaser.setRequiredPathStyle( opts.exePathStyle );
+	// All stored paths are relative to DoomRunner's directory, but we need them relative to to the engine's executable
+	// directory, because the engine must be started with the working directory set to its executable directory.
+	PathRebaser runDirRebaser( input.workingDir, engineExeDir, opts.quotePaths );
+	if (engine.requiresAbsolutePaths())
+		runDirRebaser.enforceAbsolutePaths();
+	// Checks if the required files or directories exist and reports the errors if requested.
+	PathVerifier p( report, opts.verifyPaths, opts.pathStatusMemo );
+	if (opts.verifyPaths)
+	{
+		// Waiting for a slow storage (network drive) on each path one by one would noticeably delay the launch,
+		// so query them all in parallel first. The checks below then only report the errors in the usual order.
+		p.prefetch( collectPathsToVerify( input, partsToGenerate, engine ) );
+	}
+
+	// Each part is regenerated from scratch into its own list, the parts that are not requested keep their old content.
+	auto startPart = [&]( LaunchCmdPart::Values part ) -> QStringList *
+	{
+		if (!isFlagSet( partsToGenerate, part ))
+			return nullptr;
+		QStringList & partArgs = sections.args[ launchCmdPartIndex( part ) ];
+		partArgs.clear();
+		return &partArgs;
+	};
+
+	const LaunchMode launchMode = input.launchOpts.mode;
+
+	//-- engine and command prefix -------------------------------------------------
+
+	if (isFlagSet( partsToGenerate, LaunchCmdPart::Engine ))
+	{
+		p.checkItemFilePath( engine, "the selected engine", "Please update its path in Menu -> Initial Setup, or select another one." );
+
+		// get the beginning of the launch command based on OS and installation type
+		os::ShellCommand & cmd = sections.engineCmd;
+		cmd = os::getRunCommand( engine.executablePath, runnersDirRebaser, !input.cmdPrefix.isEmpty(), input.dirsToBeAccessed );
+
+		if (!input.cmdPrefix.isEmpty())
+		{
+			prependCommandWith( cmd, input.cmdPrefix, opts.quotePaths );
+		}
+	}
+
+	//-- engine's config -----------------------------------------------------------
+
+	if (QStringList * args = startPart( LaunchCmdPart::Config ))
+	{
+		if (!input.configFilePath.isEmpty())
+		{
+			p.checkFilePath( input.configFilePath, "the selected config", "Please update the config dir in Menu -> Initial Setup, or select another one." );
+			*args << "-config" << runDirRebaser.makeRequiredCmdPath( input.configFilePath );
+		}
+	}
+
+	//-- game data files -----------------------------------------------------------
+
+	// IWAD
+	if (QStringList * args = startPart( LaunchCmdPart::IWAD ))
+	{
+		if (input.iwad)
+		{
+			p.checkItemFilePath( *input.iwad, "selected IWAD", "Please select another one." );
+			*args << "-iwad" << runDirRebaser.makeRequiredCmdPath( input.iwad->path );
+		}
+	}
+
+	// This part is tricky.
+	// Older engines only accept single -file parameter, so all the regular map/mod files must be listed together.
+	// But the user is allowed to intersperse the regular files with deh/bex files or custom cmd arguments.
+	// So we must somehow build an ordered sequence of mod files and custom arguments in which all the regular files are
+	// grouped together, and the easiest option seems to be by using a placeholder item.
+	if (QStringList * args = startPart( LaunchCmdPart::Files ))
+	{
+		/// Command line arguments constructed from the selected map files and the entries in the mod files list.
+		/** Contains placeholder for the -file list until the last phase. */
+		QStringList fileArgs;
+		bool placeholderPlaced = false;
+
+		auto addFileAccordingToSuffix = [&]( QStringList & fileList, const QString & filePath )
+		{
+			QString suffix = QFileInfo( filePath ).suffix().toLower();
+			// dehacked files are special, they go directly into the arguments with a different command line option
+			if (suffix == "deh" || suffix == "hhe") {
+				fileArgs << "-deh" << runDirRebaser.makeRequiredCmdPath( filePath );
+			} else if (suffix == "bex") {
+				fileArgs << "-bex" << runDirRebaser.makeRequiredCmdPath( filePath );
+			} else {
+				// for now, only insert a placeholder where all the files will be inserted later together
+				if (!placeholderPlaced) {
+					fileArgs << "-file" << "<files>";
+					placeholderPlaced = true;
+				}
+				// and gather the files in a separate list
+				fileList.append( runDirRebaser.makeRequiredCmdPath( filePath ) );
+			}
+		};
+
+		QStringList bundleCycles;
+
+		/// Postponed map files that will be inserted together into the -file list.
+		QStringList mapFiles;
+		forEachMapFileWithExpandedDMBs( input.selectedMapPacks, [&]( const QString & mapFilePath )
+		{
+			p.checkAnyPath( mapFilePath, "the selected map pack", "Please select another one." );
+			addFileAccordingToSuffix( mapFiles, mapFilePath );
+		}, &bundleCycles );
+
+		/// Postponed mod files that will be inserted together into the -file list.
+		QStringList modFiles;
+		if (input.mods)
+		{
+			forEachCheckedModFileWithExpandedDMBs( *input.mods, [&]( const Mod & mod )
+			{
+				if (mod.isCmdArg) {  // this is not a file but a custom command line argument, append it directly to the arguments
+					appendCustomArguments( fileArgs, mod.name, opts.quotePaths );
+				} else {
+					p.checkItemAnyPath( mod, "the selected mod", "Please update the mod list." );
+					addFileAccordingToSuffix( modFiles, mod.path );
+				}
+			}, &bundleCycles );
+		}
+
+		// the same bundle can be both selected as a map pack and in the mod list
+		bundleCycles.removeDuplicates();
+		for (QString & cycle : bundleCycles)
+		{
+			report.issues.append({ LaunchCmdIssue::BundleCycle, "Mod Bundle includes itself",
+				"A Mod Bundle includes itself ("%cycle%"). The bundle will be loaded only once, "
+				"but please remove the cycle in the Mod Bundle editor."
+			});
+		}
+
+		// output the final sequence to the args
+		for (QString & argument : fileArgs)
+		{
+			if (argument == "<files>")
+			{
+				// replace the placeholder with the actual list
+				if (input.loadMapsAfterMods) {
+					*args << std::move( modFiles );
+					*args << std::move( mapFiles );
+				} else {
+					*args << std::move( mapFiles );
+					*args << std::move( modFiles );
+				}
+			}
+			else
+			{
+				*args << std::move( argument );
+			}
+		}
+	}
+
+	//-- alternative directories ---------------------------------------------------
+	// Rather set them before the launch parameters, because some of the parameters
+	// (e.g. -loadgame) can be relative to these alternative directories.
+
+	if (QStringList * args = startPart( LaunchCmdPart::AltDirs ))
+	{
+		// Do not use -savedir or -shotdir for engines that don't support it,
+		// some of them are bitchy and won't start if you supply them with unknown command line parameter.
+		if (engine.saveDirParam() != nullptr && !input.altSaveDir.isEmpty())
+		{
+			p.checkDirPath( input.altSaveDir, "the save dir", {} );
+			*args << engine.saveDirParam() << runDirRebaser.makeRequiredCmdPath( input.altSaveDir );
+		}
+		if (engine.screenshotDirParam() != nullptr && !input.altScreenshotDir.isEmpty())
+		{
+			p.checkDirPath( input.altScreenshotDir, "the screenshot dir", {} );
+			*args << engine.screenshotDirParam() << runDirRebaser.makeRequiredCmdPath( input.altScreenshotDir );
+		}
+	}
+
+	//-- launch mode and parameters ------------------------------------------------
+	// Beware that while -record and -playdemo are either absolute or relative to the current working dir
+	// -loadgame might need to be relative to -savedir, depending on the engine and its version
+
+	if (QStringList * args = startPart( LaunchCmdPart::LaunchMode ))
+	{
+		const LaunchOptions & launchOpts = input.launchOpts;
+		if (launchMode == LaunchMap)
+		{
+			*args << engine.getMapArgs( input.mapIdx, launchOpts.mapName );
+		}
+		else if (launchMode == LoadSave && !launchOpts.saveFile.isEmpty())
+		{
+			// save dir cannot be empty, otherwise there would be no save file to select
+			QString saveFilePath = fs::getPathFromFileName( input.saveDir, launchOpts.saveFile );
+			p.checkFilePath( saveFilePath, "the selected save file", "Please select another one." );
+			*args << engine.getLoadSavedGameArgs( runDirRebaser, input.saveDir, launchOpts.saveFile );
+		}
+		else if (launchMode == RecordDemo && !launchOpts.demoFile_record.isEmpty())
+		{
+			// if demo dir is empty (no alternative demo dir and engine.dataDir is not set), then the demo file name will be used as is
+			QString demoFileName = fs::ensureFileSuffix( launchOpts.demoFile_record, doom::demoFileSuffix );
+			QString demoFilePath = fs::getPathFromFileName( input.demoDir, demoFileName );
+			p.checkOverwrite( demoFilePath, "the specified demo file", "Please select another one." );
+			*args << "-record" << runDirRebaser.makeRequiredCmdPath( demoFilePath );
+			*args << engine.getMapArgs( input.mapIdx_demo, launchOpts.mapName_demo );
+		}
+		else if (launchMode == ReplayDemo && !launchOpts.demoFile_replay.isEmpty())
+		{
+			// demo dir cannot be empty, otherwise there would be no demo file to select
+			QString demoFilePath = fs::getPathFromFileName( input.demoDir, launchOpts.demoFile_replay );
+			p.checkFilePath( demoFilePath, "the selected demo file", "Please select another one." );
+			*args << "-playdemo" << runDirRebaser.makeRequiredCmdPath( demoFilePath );
+		}
+		else if (launchMode == ResumeDemo
+		      && !launchOpts.demoFile_resumeFrom.isEmpty() && !launchOpts.demoFile_resumeTo.isEmpty())
+		{
+			// demo dir cannot be empty, otherwise there would be no demo file to select
+			QString origDemoPath = fs::getPathFromFileName( input.demoDir, launchOpts.demoFile_resumeFrom );
+			QString destDemoPath = fs::getPathFromFileName( input.demoDir, fs::ensureFileSuffix( launchOpts.demoFile_resumeTo, doom::demoFileSuffix ) );
+			p.checkFilePath( origDemoPath, "the original demo file", "Please select another one." );
+			p.checkOverwrite( destDemoPath, "the destination demo file", "Please select another one." );
+			*args << "-recordfromto"
+				<< runDirRebaser.makeRequiredCmdPath( origDemoPath ) << runDirRebaser.makeRequiredCmdPath( destDemoPath );
+		}
+	}
+
+	//-- gameplay and compatibility options ----------------------------------------
+	// These options are used only if the corresponding command line options are supported by the engine.
+
+	if (QStringList * args = startPart( LaunchCmdPart::Gameplay ))
+	{
+		const GameplayOptions & gameOpts = input.gameOpts;
+		const bool gameplayOptsAvailable = areGameplayOptionsAvailable( launchMode );
+		const bool detailedGameOptsAvailable = gameplayOptsAvailable && engine.hasDetailedGameOptions();
+		if (isDirectLaunch( launchMode ))
+			*args << "-skill" << QString::number( gameOpts.skillNum );
+		if (gameplayOptsAvailable && gameOpts.noMonsters)
+			*args << "-nomonsters";
+		if (gameplayOptsAvailable && gameOpts.fastMonsters)
+			*args << "-fast";
+		if (gameplayOptsAvailable && gameOpts.monstersRespawn)
+			*args << "-respawn";
+		if (gameplayOptsAvailable && gameOpts.pistolStart && engine.pistolStartOption() != nullptr)
+			*args << engine.pistolStartOption();
+		if (gameplayOptsAvailable && gameOpts.allowCheats)
+			*args << engine.allowCheatsArgs();
+		if (detailedGameOptsAvailable && gameOpts.dmflags1 != 0)
+			*args << "+dmflags" << QString::number( gameOpts.dmflags1 );
+		if (detailedGameOptsAvailable && gameOpts.dmflags2 != 0)
+			*args << "+dmflags2" << QString::number( gameOpts.dmflags2 );
+		if (detailedGameOptsAvailable && gameOpts.dmflags3 != 0)
+			*args << "+dmflags3" << QString::number( gameOpts.dmflags3 );
+	}
+
+	if (QStringList * args = startPart( LaunchCmdPart::Compat ))
+	{
+		const bool gameplayOptsAvailable = areGameplayOptionsAvailable( launchMode );
+		if (gameplayOptsAvailable && engine.compatModeStyle() != CompatModeStyle::None && input.compatOpts.compatMode >= 0)
+			*args << engine.getCompatModeArgs( input.compatOpts.compatMode );
+		if (gameplayOptsAvailable && engine.hasDetailedCompatOptions() && !input.compatOptsCmdArgs.isEmpty())
+			*args << input.compatOptsCmdArgs;
+	}
+
+	//-- multiplayer options -------------------------------------------------------
+
+	if (QStringList * args = startPart( LaunchCmdPart::Multiplayer ))
+	{
+		const MultiplayerOptions & multOpts = input.multOpts;
+		if (multOpts.isMultiplayer && engine.hasMultiplayer())
+		{
+			switch (multOpts.multRole)
+			{
+			 case MultRole::Server:
+				if (engine.multHostParam())
+					*args << engine.multHostParam();
+				if (engine.multPlayerCountParam())
+					*args << engine.multPlayerCountParam() << QString::number( multOpts.playerCount );
+				if (multOpts.port != 5029)
+					*args << "-port" << QString::number( multOpts.port );
+				if (engine.hasNetMode())
+					*args << "-netmode" << QString::number( multOpts.netMode );
+				switch (multOpts.gameMode)
+				{
+				 case Deathmatch:
+					*args << "-deathmatch";
+					break;
+				 case TeamDeathmatch:
+					*args << "-deathmatch" << "+teamplay";
+					break;
+				 case AltDeathmatch:
+					*args << "-altdeath";
+					break;
+				 case AltTeamDeathmatch:
+					*args << "-altdeath" << "+teamplay";
+					break;
+				 case Deathmatch3:
+					*args << "-dm3";
+					break;
+				 case Cooperative: // default mode, which is started without any param
+					break;
+				 default:
+					addInputIssue( report, "Invalid game mode index", "The game mode index is out of range." );
+				}
+				if (multOpts.teamDamage != 0.0)
+					*args << "+teamdamage" << QString::number( multOpts.teamDamage, 'f', 2 );
+				if (multOpts.timeLimit != 0)
+					*args << "-timer" << QString::number( multOpts.timeLimit );
+				if (multOpts.fragLimit != 0)
+					*args << "+fraglimit" << QString::number( multOpts.fragLimit );
+				break;
+			 case MultRole::Client:
+				if (!engine.multJoinParam())
+				{
+					addInputIssue( report, "Multiplayer join parameter is null",
+						"The multiplayer join parameter is not set. The multiplayer group-box should have been disabled."
+					);
+					break;
+				}
+				*args << engine.multJoinParam() << multOpts.hostName % ":" % QString::number( multOpts.port );
+				break;
+			 default:
+				addInputIssue( report, "Invalid multiplayer role index", "The multiplayer role index is out of range." );
+			}
+
+			if (engine.hasPlayerCustomization() && !multOpts.playerName.isEmpty())
+			{
+				*args << "+name" << multOpts.playerName;
+
+				if (multOpts.playerColor.isValid())
+				{
+					QString colorArg = QStringLiteral("%1 %2 %3")
+					                   .arg( multOpts.playerColor.red(),   1, 16 )
+					                   .arg( multOpts.playerColor.green(), 1, 16 )
+					                   .arg( multOpts.playerColor.blue(),  1, 16 );
+					*args << "+color" << runDirRebaser.maybeQuoted( colorArg );
+				}
+			}
+		}
+	}
+
+	//-- output options ------------------------------------------------------------
+
+	if (QStringList * args = startPart( LaunchCmdPart::Video ))
+	{
+		const VideoOptions & videoOpts = input.videoOpts;
+
+		// On Windows, ZDoom doesn't log its output to stdout by default.
+		// Force it to do so, so that our ProcessOutputWindow displays something.
+		if (input.showEngineOutput && engine.needsStdoutParam())
+			*args << "-stdout";
+
+		// video options
+		if (videoOpts.monitorIdx > 0)
+		{
+			int monitorIndex = videoOpts.monitorIdx - 1;  // the first item is a placeholder for leaving it default
+			*args << "+vid_adapter" << engine.getCmdMonitorIndex( monitorIndex );  // some engines index monitors from 1 and others from 0
+		}
+		if (videoOpts.resolutionX != 0)
+			*args << "-width" << QString::number( videoOpts.resolutionX );
+		if (videoOpts.resolutionY != 0)
+			*args << "-height" << QString::number( videoOpts.resolutionY );
+		if (videoOpts.showFPS)
+			*args << "+vid_fps" << "1";
+	}
+
+	// audio options
+	if (QStringList * args = startPart( LaunchCmdPart::Audio ))
+	{
+		if (input.audioOpts.noSound)
+			*args << "-nosound";
+		if (input.audioOpts.noSFX)
+			*args << "-nosfx";
+		if (input.audioOpts.noMusic)
+			*args << "-nomusic";
+	}
+
+	//-- additional custom command line arguments ----------------------------------
+
+	if (QStringList * args = startPart( LaunchCmdPart::CustomArgs ))
+	{
+		if (!input.globalCmdArgs.isEmpty())
+			appendCustomArguments( *args, input.globalCmdArgs, opts.quotePaths );
+
+		if (!input.presetCmdArgs.isEmpty())
+			appendCustomArguments( *args, input.presetCmdArgs, opts.quotePaths );
+	}
+
+	//------------------------------------------------------------------------------
+
+	return !report.hasInvalidPaths();
+}
@@ -0,0 +1,226 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: generation of the engine's launch command from the user data, independent of the UI
+//======================================================================================================================
+
+#ifndef LAUNCH_COMMAND_BUILDER_INCLUDED
+#define LAUNCH_COMMAND_BUILDER_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include "UserData.hpp"  // EngineInfo, IWAD, Mod, option structs
+#include "Utils/FileSystemUtilsTypes.hpp"  // PathStyle
+#include "Utils/OSUtilsTypes.hpp"  // ShellCommand
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+class AsyncPathChecker;
+
+
+//======================================================================================================================
+// launch command parts
+
+/// Independently generated sections of the launch command, in the order in which they appear in the command.
+/** Each section depends only on a subset of the input, so when some of it changes, only that section is regenerated. */
+namespace LaunchCmdPart { enum Values : uint
+{
+	None         = 0,
+	Engine       = (1 << 0),    ///< engine executable, sandbox wrapper and command prefix
+	Config       = (1 << 1),    ///< -config
+	IWAD         = (1 << 2),    ///< -iwad
+	Files        = (1 << 3),    ///< map packs, mods, dehacked files and custom arguments from the mod list
+	AltDirs      = (1 << 4),    ///< alternative save and screenshot directories
+	LaunchMode   = (1 << 5),    ///< map to warp to, save to load, demo to record or replay
+	Gameplay     = (1 << 6),    ///< skill, monsters, cheats and dmflags
+	Compat       = (1 << 7),    ///< compat mode and compatibility flags
+	Multiplayer  = (1 << 8),    ///< multiplayer role, game mode, limits and player settings
+	Video        = (1 << 9),    ///< monitor, resolution, fps and engine output
+	Audio        = (1 << 10),   ///< sound and music switches
+	CustomArgs   = (1 << 11),   ///< global and preset additional arguments
+
+	All          = (1 << 12) - 1
+};}
+using LaunchCmdParts = std::underlying_type_t< LaunchCmdPart::Values >;
+constexpr int LaunchCmdPartCount = 12;
+
+/// Argument fragments of the individual launch command parts, indexed by the bit position of LaunchCmdPart.
+struct LaunchCmdSections
+{
+	os::ShellCommand engineCmd;   ///< executable and leading arguments produced by the Engine part
+	QStringList args [LaunchCmdPartCount];
+};
+
+
+//======================================================================================================================
+// generator input
+
+/// How the command should be generated.
+struct LaunchCommandOptions
+{
+	/// The currently selected engine.
+	/** The command cannot be generated without one. */
+	const EngineInfo & selectedEngine;
+
+	/// Path style to be used for the engine executable.
+	PathStyle exePathStyle;
+
+	// Path style for the arguments is determined case by case.
+
+	/// Working directory of the process that will run the command.
+	/** This determines the relative path of the engine executable in the command. */
+	const QString & runnersWorkingDir;
+
+	/// Surround each path in the command with quotes.
+	/** Required for displaying the command or saving it to a script file. */
+	bool quotePaths;
+
+	/// Verify that each path in the command is valid and leads to the correct entry type (file or directory).
+	/** Each invalid path is reported as an issue of the generation. */
+	bool verifyPaths;
+
+	/// Where to remember the results of the path verification. Can be null.
+	/** The verification always queries the paths again, but the following checks of the same paths
+	  * (for example when switching presets) can reuse its results. */
+	AsyncPathChecker * pathStatusMemo = nullptr;
+};
+
+/// What the command should be generated from.
+/** Only the members that the requested parts depend on need to be filled in.
+  * The options that the selected engine doesn't support or that don't apply to the launch mode are ignored. */
+struct LaunchCommandInput
+{
+	QString workingDir;   ///< directory to which the relative paths in this input are relative (usually the launcher's working dir)
+
+	// LaunchCmdPart::Engine
+	QString cmdPrefix;             ///< command to prepend before the engine executable
+	QStringList dirsToBeAccessed;  ///< directories the sandboxed engines will need to be given access to
+
+	// LaunchCmdPart::Config
+	QString configFilePath;   ///< empty means the engine's default config
+
+	// LaunchCmdPart::IWAD
+	const IWAD * iwad = nullptr;
+
+	// LaunchCmdPart::Files
+	QStringList selectedMapPacks;      ///< map files and Doom Mod Bundles in the order in which they were selected
+	const PtrList< Mod > * mods = nullptr;   ///< the whole mod list, only the checked entries are used
+	bool loadMapsAfterMods = false;
+
+	// LaunchCmdPart::AltDirs
+	QString altSaveDir;         ///< empty if the user hasn't chosen an alternative save dir
+	QString altScreenshotDir;   ///< empty if the user hasn't chosen an alternative screenshot dir
+
+	// LaunchCmdPart::LaunchMode
+	LaunchOptions launchOpts;
+	int mapIdx = -1;        ///< index of launchOpts.mapName in the list of available maps, for engines that can only -warp
+	int mapIdx_demo = -1;   ///< index of launchOpts.mapName_demo in the list of available maps
+	QString saveDir;        ///< directory with the save files, resolved from the alternative or default save dir
+	QString demoDir;        ///< directory with the demo files, resolved from the alternative or default demo dir
+
+	// LaunchCmdPart::Gameplay
+	GameplayOptions gameOpts;
+
+	// LaunchCmdPart::Compat
+	CompatibilityOptions compatOpts;
+	QStringList compatOptsCmdArgs;   ///< command line arguments generated from compatOpts for the selected engine
+
+	// LaunchCmdPart::Multiplayer
+	MultiplayerOptions multOpts;
+
+	// LaunchCmdPart::Video
+	VideoOptions videoOpts;
+	bool showEngineOutput = false;   ///< the output of the engine will be displayed by the launcher
+
+	// LaunchCmdPart::Audio
+	AudioOptions audioOpts;
+
+	// LaunchCmdPart::CustomArgs
+	QString globalCmdArgs;
+	QString presetCmdArgs;
+};
+
+
+//======================================================================================================================
+// generator output
+
+/// Problem found during the generation, which the caller should present to the user.
+struct LaunchCmdIssue
+{
+	enum Type
+	{
+		InvalidPath,    ///< a path doesn't exist or leads to a wrong entry type, the command must not be launched
+		FileExists,     ///< a file that the engine will write already exists, the user should confirm overwriting it
+		InvalidInput,   ///< the input is inconsistent, which is a bug in the code that gathered it
+		BundleCycle,    ///< a Mod Bundle includes itself, it was expanded only once, the command can still be launched
+	};
+
+	Type type;
+	QString title;
+	QString message;
+	QString path;                        ///< the path the issue is about, empty if it's not about a path
+	const AModelItem * item = nullptr;   ///< list item the path belongs to, if the path was taken from a list item
+};
+
+/// Everything the caller needs to know about the generation, besides the command itself.
+struct LaunchCmdReport
+{
+	QList< LaunchCmdIssue > issues;              ///< in the order in which they appear in the command
+	QList< const AModelItem * > verifiedItems;   ///< list items whose paths were verified, valid or not
+	QStringList verifiedPaths;                   ///< other paths that were verified, valid or not
+
+	bool hasInvalidPaths() const
+	{
+		for (const LaunchCmdIssue & issue : issues)
+			if (issue.type == LaunchCmdIssue::InvalidPath)
+				return true;
+		return false;
+	}
+};
+
+
+//======================================================================================================================
+// generator
+
+/// Generates the engine's launch command from plain user data.
+/** It does not access any widgets and doesn't interact with the user, all the problems are returned in LaunchCmdReport,
+  * so it can be used without the main window. */
+class LaunchCommandBuilder {
+
+ public:
+
+	explicit LaunchCommandBuilder( const LaunchCommandOptions & opts ) : _opts( opts ) {}
+
+	/// Generates the whole command.
+	/** Returns empty command when paths verification was requested and some of the paths is invalid. */
+	os::ShellCommand generate( const LaunchCommandInput & input, LaunchCmdReport & report );
+
+	/// Generates only the requested parts into the sections, the other sections keep their content.
+	/** The issues found are appended to the report.
+	  * Returns false when paths verification was requested and some of the paths is invalid. */
+	bool generateParts(
+		const LaunchCommandInput & input, LaunchCmdParts partsToGenerate, LaunchCmdSections & sections, LaunchCmdReport & report
+	);
+
+	/// Joins the generated sections into a complete command.
+	static os::ShellCommand joinParts( const LaunchCmdSections & sections );
+
+	/// Lists the game files the engine will load: the IWAD, the map files and the mod files, with Doom Mod Bundles expanded.
+	/** Only the IWAD and Files members of the input are used. */
+	static QStringList getGameFilePaths( const LaunchCommandInput & input );
+
+ private:
+
+	const LaunchCommandOptions & _opts;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // LAUNCH_COMMAND_BUILDER_INCLUDED
@@ -0,0 +1,291 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: recording and evaluation of launch latency and session duration of the started engines
+//======================================================================================================================
+
+#include "LaunchStatistics.hpp"
+
+#include "CommonTypes.hpp"  // qsize_t
+#include "Utils/ErrorHandling.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QUuid>
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QStringBuilder>
+
+#include <algorithm>
+#include <vector>
+
+
+//======================================================================================================================
+// file format
+//
+// Plain text, one measurement per line, the fields are separated by tabs:
+//   S <launch ID> <launch time in ms since epoch> <spawn time in us> <preset name> <engine name>
+//   O <launch ID> <time to first output in ms>
+//   E <launch ID> <exit code> <session duration in ms>
+// The lines of different launches can interleave when more engines are running at the same time.
+// When the file is rotated while an engine is running, the rest of its lines ends up in the rotated file.
+
+static constexpr char FieldSeparator = '\t';
+
+/// The names are user-defined, they must not break the line structure.
+static QString sanitizeName( QString name )
+{
+	for (QChar & c : name)
+		if (c == FieldSeparator || c == '\n' || c == '\r')
+			c = ' ';
+	return name;
+}
+
+
+//======================================================================================================================
+// recording
+
+LaunchStatsRecorder::LaunchStatsRecorder( const QString & filePath, const QString & presetName, const QString & engineName )
+:
+	_filePath( filePath ),
+	_presetName( sanitizeName( presetName ) ),
+	_engineName( sanitizeName( engineName ) ),
+	_launchID( QUuid::createUuid().toString( QUuid::WithoutBraces ) ),
+	_launchTime( QDateTime::currentMSecsSinceEpoch() )
+{}
+
+QString getRotatedLaunchStatsFilePath( const QString & filePath )
+{
+	return filePath % ".old";
+}
+
+void LaunchStatsRecorder::recordStart( qint64 spawnTimeUs ) const
+{
+	// Done only here, once per launch, the other records are cheap enough to be appended even to a large file.
+	rotateFileIfTooLarge();
+
+	appendLine( QStringLiteral("S\t%1\t%2\t%3\t").arg( _launchID ).arg( _launchTime ).arg( spawnTimeUs ) % _presetName % FieldSeparator % _engineName );
+}
+
+void LaunchStatsRecorder::recordFirstOutput( qint64 firstOutputMs ) const
+{
+	appendLine( QStringLiteral("O\t%1\t%2").arg( _launchID ).arg( firstOutputMs ) );
+}
+
+void LaunchStatsRecorder::recordExit( int exitCode, qint64 sessionDurationMs ) const
+{
+	appendLine( QStringLiteral("E\t%1\t%2\t%3").arg( _launchID ).arg( exitCode ).arg( sessionDurationMs ) );
+}
+
+void LaunchStatsRecorder::rotateFileIfTooLarge() const
+{
+	if (!isActive() || QFileInfo( _filePath ).size() <= maxLaunchStatsFileSize)
+		return;
+
+	// The rename is atomic, so the lines appended by the other launcher instances end up either in the old or the new file.
+	QString rotatedFilePath = getRotatedLaunchStatsFilePath( _filePath );
+	QFile::remove( rotatedFilePath );
+	if (!QFile::rename( _filePath, rotatedFilePath ))
+		logRuntimeError().quote() << "Cannot rotate launch statistics file " << _filePath;
+}
+
+void LaunchStatsRecorder::appendLine( const QString & line ) const
+{
+	if (!isActive())
+		return;
+
+	// The whole line is written by a single write() into a file opened in append mode,
+	// so concurrent writes from different threads or launcher instances don't mix.
+	QFile file( _filePath );
+	if (!file.open( QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered ))
+	{
+		// this can be called from a background thread, don't touch the shared log file
+		printRuntimeError().quote() << "Cannot open launch statistics file " << _filePath << ": " << file.errorString();
+		return;
+	}
+
+	file.write( line.toUtf8() + '\n' );
+}
+
+
+//======================================================================================================================
+// evaluation
+
+/// Lines of the current and the rotated file are merged into the same records.
+struct LaunchRecordParser
+{
+	QList< LaunchRecord > records;
+	QHash< QString, qsize_t > recordIndexes;  // launch ID -> index into records
+	QSet< QString > startedIDs;
+
+	void parseFile( const QString & filePath );
+};
+
+void LaunchRecordParser::parseFile( const QString & filePath )
+{
+	QFile file( filePath );
+	if (!file.exists())
+	{
+		return;  // nothing has been launched yet, or the file has never been rotated
+	}
+	if (!file.open( QIODevice::ReadOnly ))
+	{
+		logRuntimeError().quote() << "Cannot open launch statistics file " << filePath << ": " << file.errorString();
+		return;
+	}
+
+	while (!file.atEnd())
+	{
+		QString line = QString::fromUtf8( file.readLine() );
+		while (line.endsWith('\n') || line.endsWith('\r'))
+			line.chop( 1 );
+
+		// Skip what can't be parsed. When the launcher was killed while writing a line, the line is incomplete
+		// and the next record is appended right after it, so the field count and the numbers must match exactly.
+		const QStringList fields = line.split( FieldSeparator );
+		const qsize_t expectedFieldCount = fields[0] == "S" ? 6 : fields[0] == "O" ? 3 : fields[0] == "E" ? 4 : -1;
+		if (fields.size() != expectedFieldCount || fields[1].isEmpty())
+			continue;
+
+		bool valueValid = false, value2Valid = true;
+		const QString & launchID = fields[1];
+		qint64 value = fields[2].toLongLong( &valueValid );
+		qint64 value2 = fields[0] != "O" ? fields[3].toLongLong( &value2Valid ) : 0;
+		if (!valueValid || !value2Valid)
+			continue;
+
+		// The exit of a short-lived detached process can be written before its start,
+		// so the record has to be created by whichever line comes first.
+		auto indexIter = recordIndexes.find( launchID );
+		if (indexIter == recordIndexes.end())
+		{
+			indexIter = recordIndexes.insert( launchID, records.size() );
+			records.append( LaunchRecord() );
+			records.last().launchID = launchID;
+		}
+		LaunchRecord & record = records[ *indexIter ];
+
+		if (fields[0] == "S")
+		{
+			record.launchTime = value;
+			record.spawnTimeUs = value2;
+			record.presetName = fields[4];
+			record.engineName = fields[5];
+			startedIDs.insert( launchID );
+		}
+		else if (fields[0] == "O")
+		{
+			record.firstOutputMs = value;
+		}
+		else if (fields[0] == "E")
+		{
+			record.exited = true;
+			record.exitCode = int( value );
+			record.sessionDurationMs = value2;
+		}
+	}
+}
+
+QList< LaunchRecord > readLaunchRecords( const QString & filePath )
+{
+	LaunchRecordParser parser;
+	parser.parseFile( getRotatedLaunchStatsFilePath( filePath ) );
+	parser.parseFile( filePath );
+
+	QList< LaunchRecord > & records = parser.records;
+
+	// without the start line it's unknown which preset the measurements belong to
+	records.erase( std::remove_if( records.begin(), records.end(), [&]( const LaunchRecord & record )
+	{
+		return !parser.startedIDs.contains( record.launchID );
+	}), records.end() );
+
+	std::stable_sort( records.begin(), records.end(), []( const LaunchRecord & a, const LaunchRecord & b )
+	{
+		return a.launchTime < b.launchTime;
+	});
+
+	return records;
+}
+
+Percentiles computePercentiles( std::vector< qint64 > values )
+{
+	Percentiles result;
+
+	result.count = int( values.size() );
+	if (values.empty())
+		return result;
+
+	result.last = values.back();
+
+	std::sort( values.begin(), values.end() );
+	auto percentile = [ &values ]( size_t percent )
+	{
+		size_t rank = (percent * values.size() + 99) / 100;  // ceil( percent / 100 * count )
+		return values[ std::max< size_t >( rank, 1 ) - 1 ];
+	};
+	result.p50 = percentile( 50 );
+	result.p90 = percentile( 90 );
+	result.p99 = percentile( 99 );
+
+	return result;
+}
+
+QList< LaunchStatsSummary > summarizeLaunchRecords( const QList< LaunchRecord > & records )
+{
+	struct Group
+	{
+		LaunchStatsSummary summary;
+		std::vector< qint64 > spawnTimes;
+		std::vector< qint64 > firstOutputTimes;
+		std::vector< qint64 > sessionDurations;
+	};
+	std::vector< Group > groups;
+	QHash< QString, size_t > groupIndexes;  // preset name + engine name -> index into groups
+
+	for (const LaunchRecord & record : records)
+	{
+		// the names were sanitized when written, so the separator cannot be a part of them
+		QString groupKey = record.presetName % FieldSeparator % record.engineName;
+		auto indexIter = groupIndexes.find( groupKey );
+		if (indexIter == groupIndexes.end())
+		{
+			indexIter = groupIndexes.insert( groupKey, groups.size() );
+			groups.emplace_back();
+			groups.back().summary.presetName = record.presetName;
+			groups.back().summary.engineName = record.engineName;
+		}
+		Group & group = groups[ *indexIter ];
+
+		group.summary.launchCount++;
+		group.summary.lastLaunchTime = record.launchTime;
+		if (record.spawnTimeUs < 0 || (record.exited && record.exitCode != 0))
+			group.summary.failedCount++;
+
+		if (record.spawnTimeUs >= 0)
+			group.spawnTimes.push_back( record.spawnTimeUs );
+		if (record.firstOutputMs >= 0)
+			group.firstOutputTimes.push_back( record.firstOutputMs );
+		if (record.exited && record.sessionDurationMs >= 0)
+			group.sessionDurations.push_back( record.sessionDurationMs );
+	}
+
+	QList< LaunchStatsSummary > summaries;
+	summaries.reserve( qsize_t( groups.size() ) );
+	for (Group & group : groups)
+	{
+		group.summary.spawnTimeUs = computePercentiles( std::move( group.spawnTimes ) );
+		group.summary.firstOutputMs = computePercentiles( std::move( group.firstOutputTimes ) );
+		group.summary.sessionDurationMs = computePercentiles( std::move( group.sessionDurations ) );
+		summaries.append( std::move( group.summary ) );
+	}
+
+	std::sort( summaries.begin(), summaries.end(), []( const LaunchStatsSummary & a, const LaunchStatsSummary & b )
+	{
+		return a.presetName != b.presetName ? a.presetName < b.presetName : a.engineName < b.engineName;
+	});
+
+	return summaries;
+}
@@ -0,0 +1,124 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: recording and evaluation of launch latency and session duration of the started engines
+//======================================================================================================================
+
+#ifndef LAUNCH_STATISTICS_INCLUDED
+#define LAUNCH_STATISTICS_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QString>
+#include <QList>
+
+#include <vector>
+
+
+//======================================================================================================================
+// recording
+
+/// The file is rotated when it grows over this size, which is roughly 10 000 launches.
+constexpr qint64 maxLaunchStatsFileSize = 1024 * 1024;
+
+/// Where the previous content of the statistics file is moved when the file gets rotated.
+QString getRotatedLaunchStatsFilePath( const QString & filePath );
+
+/// Appends the measurements of a single engine launch to the statistics file as they become known.
+/** The file is append-only, each measurement is written as a separate line tagged with the launch ID,
+  * so that nothing is lost when the launcher is closed before the engine exits.
+  * When the file grows over maxLaunchStatsFileSize, it's rotated at the next launch, only the previous file is kept.
+  * It holds no other state than the file path and the launch identification, so copies of it can be handed over
+  * to other threads that outlive the launch, each write opens the file, appends one line and closes it. */
+class LaunchStatsRecorder {
+
+ public:
+
+	/// Constructs an inactive recorder that ignores all the measurements.
+	LaunchStatsRecorder() {}
+
+	LaunchStatsRecorder( const QString & filePath, const QString & presetName, const QString & engineName );
+
+	bool isActive() const  { return !_filePath.isEmpty(); }
+
+	/// Records that the process has been started and how long it took, -1 means the process failed to start.
+	void recordStart( qint64 spawnTimeUs ) const;
+
+	/// Records the time from the start of the process to the first byte of its output (stdout or stderr).
+	void recordFirstOutput( qint64 firstOutputMs ) const;
+
+	/// Records the exit of the process.
+	/** \param exitCode Exit code of the process, -1 if the process crashed or was killed by a signal. */
+	void recordExit( int exitCode, qint64 sessionDurationMs ) const;
+
+ private:
+
+	void appendLine( const QString & line ) const;
+
+	void rotateFileIfTooLarge() const;
+
+	QString _filePath;
+	QString _presetName;
+	QString _engineName;
+	QString _launchID;      ///< unique even for launches in the same millisecond or from different launcher instances
+	qint64 _launchTime = 0;   ///< in ms since epoch
+
+};
+
+
+//======================================================================================================================
+// evaluation
+
+/// All the measurements of a single engine launch, merged from the individual lines of the file.
+struct LaunchRecord
+{
+	QString launchID;
+	qint64 launchTime = 0;   ///< in ms since epoch
+	QString presetName;
+	QString engineName;
+	qint64 spawnTimeUs = -1;         ///< -1 if the process failed to start
+	qint64 firstOutputMs = -1;       ///< -1 if the output wasn't captured or the process didn't output anything
+	bool exited = false;             ///< false if the launcher didn't wait for the exit of the process
+	int exitCode = 0;                ///< valid only if exited is true
+	qint64 sessionDurationMs = -1;   ///< valid only if exited is true
+};
+
+/// Reads all the launch records from the statistics file and its rotated predecessor, ordered from the oldest.
+QList< LaunchRecord > readLaunchRecords( const QString & filePath );
+
+/// Distribution of one measured quantity.
+struct Percentiles
+{
+	int count = 0;   ///< number of launches where the quantity was measured, the other members are valid only if it's > 0
+	qint64 p50 = 0;
+	qint64 p90 = 0;
+	qint64 p99 = 0;
+	qint64 last = 0;   ///< value from the most recent launch, to spot regressions
+};
+
+/// Computes the nearest-rank percentiles of the values, which are in the order in which they were measured.
+Percentiles computePercentiles( std::vector< qint64 > values );
+
+/// Summary of all the launches of one preset with one engine.
+struct LaunchStatsSummary
+{
+	QString presetName;
+	QString engineName;
+	int launchCount = 0;
+	int failedCount = 0;   ///< launches where the process didn't start, crashed or exited with non-zero code
+	qint64 lastLaunchTime = 0;   ///< in ms since epoch
+	Percentiles spawnTimeUs;
+	Percentiles firstOutputMs;
+	Percentiles sessionDurationMs;
+};
+
+/// Groups the records by preset and engine and computes the percentiles of each measured quantity.
+QList< LaunchStatsSummary > summarizeLaunchRecords( const QList< LaunchRecord > & records );
+
+
+//======================================================================================================================
+
+
+#endif // LAUNCH_STATISTICS_INCLUDED
@@ -17,10 +17,12 @@
 #include "Dialogs/GameOptsDialog.hpp"
 #include "Dialogs/CompatOptsDialog.hpp"
 #include "Dialogs/ProcessOutputWindow.hpp"
+#include "Dialogs/LaunchStatsDialog.hpp"
 #include <QColorDialog>
 
 #include "AppVersion.hpp"  // window title
 #include "OptionsSerializer.hpp"
+#include "LaunchStatistics.hpp"
 #include "UpdateChecker.hpp"
 #include "Themes.hpp"
 #include "EngineTraits.hpp"
@@ -36,7 +38,7 @@
 #include "Utils/WADReader.hpp"
 #include "Utils/DoomModBundles.hpp"
 #include "Utils/WidgetUtils.hpp"
-#include "Utils/MiscUtils.hpp"  // areScreenCoordinatesValid, makeFileFilter, splitCommandLineArguments
+#include "Utils/MiscUtils.hpp"  // areScreenCoordinatesValid, makeFileFilter
 #include "Utils/ErrorHandling.hpp"
 
 #include <QStringBuilder>
@@ -46,14 +48,19 @@
 #include <QStandardPaths>
 #include <QMessageBox>
 #include <QShortcut>
+#include <QProgressDialog>
 #include <QTimer>
+#include <QHeaderView>
+#include <QSignalBlocker>
 #include <QProcess>  // startDetached
+#include <QRegularExpressionValidator>  // cpuAffinityLine
 
 
 //======================================================================================================================
 
 static const char defaultOptionsFileName [] = "options.json";
 static const char defaultCacheFileName [] = "file_info_cache.json";
+static const char defaultLaunchStatsFileName [] = "launch_stats.txt";
 
 enum EnvVarsColumn
 {
@@ -78,7 +85,7 @@ QStringList MainWindow::getSelectedMapPacks() const
 {
 	QStringList selectedMapPacks;
 
-	// clicking on an item in QTreeView with QFileSystemModel selects all elements (columns) of a row,
+	// clicking on an item in QTreeView with multiple columns selects all elements (columns) of a row,
 	// but we only care about the first one
 	const auto selectedRows = wdg::getSelectedRows( ui->mapDirView );
 
@@ -94,74 +101,11 @@ QStringList MainWindow::getSelectedMapPacks() const
 	return selectedMapPacks;
 }
 
-// Executes the loopBody functor for every file path in that pack. Sub-packs are expanded recursively.
-template< typename Entry, typename Functor >
-void MainWindow::expandDMB( const QString & filePath, const Functor & loopBody ) const
-{
-	const std::optional< QStringList > entries = dmb::getEntries( filePath );
-	if (!entries)
-	{
-		// This is called everytime the launch command is re-generated, so we don't want to pop up a message box here,
-		// because that would be annoying. However by calling the loopBody on the un-expanded bundle file
-		// we can let the PathChecker decide whether to show an error or not.
-		// The detailed error message about what went wrong is logged to errors.txt.
-		loopBody( Entry( filePath ) );
-		return;
-	}
-
-	for (const QString & path : *entries)
-	{
-		if (fs::getFileSuffix( path ) == dmb::fileSuffix)
-		{
-			expandDMB< Entry >( path, loopBody );
-		}
-		else
-		{
-			loopBody( Entry( path ) );
-		}
-	}
-}
-
-// Iterates over a list of selected map files where each Doom Mod Bundle (.dmb) is fully expanded.
-template< typename Functor >
-void MainWindow::forEachSelectedMapFileWithExpandedDMBs( const Functor & loopBody ) const
-{
-	for (const QString & mapFilePath : selectedMapPacks)
-	{
-		if (fs::getFileSuffix( mapFilePath ) == dmb::fileSuffix)
-		{
-			expandDMB< QString >( mapFilePath, loopBody );
-		}
-		else
-		{
-			loopBody( mapFilePath );
-		}
-	}
-}
-
-// Iterates over a list of checked mod files where each Doom Mod Bundle (.dmb) is fully expanded.
-template< typename Functor >
-void MainWindow::forEachCheckedModFileWithExpandedDMBs( const Functor & loopBody ) const
-{
-	for (const Mod & mod : modModel)
-	{
-		if (!mod.isSeparator && mod.checked)
-		{
-			if (fs::getFileSuffix( mod.path ) == dmb::fileSuffix)
-			{
-				expandDMB< Mod >( mod.path, loopBody );
-			}
-			else
-			{
-				loopBody( mod );
-			}
-		}
-	}
-}
-
 QStringList MainWindow::getUniqueMapNamesFromWADs( const QList<QString> & selectedWADs )
 {
-	QMap< QString, int > uniqueMapNames;  // we cannot use QSet because that one is unordered and we need to retain order
+	// Ordered naturally (MAP2 before MAP10, E1M2 before E1M10) by a key computed once per name. The name is part
+	// of the map key too, so that MAP02 and MAP2 having the same sort key don't get merged, they are different maps.
+	QMap< std::pair< QString, QString >, QString > uniqueMapNames;  // (natural sort key, name) -> name
 	for (const QString & selectedWAD : selectedWADs)
 	{
 		if (!fs::isValidFile( selectedWAD ))
@@ -172,9 +116,12 @@ QStringList MainWindow::getUniqueMapNamesFromWADs( const QList<QString> & select
 			continue;
 
 		for (const QString & mapName : wadInfo.mapNames)
-			uniqueMapNames.insert( mapName.toUpper(), 0 );  // the 0 doesn't matter
+		{
+			QString upperName = mapName.toUpper();
+			uniqueMapNames.insert( { makeNaturalSortKey( upperName ), upperName }, upperName );
+		}
 	}
-	return uniqueMapNames.keys();
+	return uniqueMapNames.values();
 }
 
 // paths of data dirs
@@ -789,6 +736,7 @@ MainWindow::MainWindow()
 	connect( ui->exportPresetToScriptAction, &QAction::triggered, this, &ThisClass::onExportToScriptTriggered );
 	connect( ui->exportPresetToShortcutAction, &QAction::triggered, this, &ThisClass::onExportToShortcutTriggered );
 	//connect( ui->importPresetAction, &QAction::triggered, this, &ThisClass::onImportFromScriptTriggered );
+	connect( ui->launchStatsAction, &QAction::triggered, this, &ThisClass::onLaunchStatsTriggered );
 	connect( ui->aboutAction, &QAction::triggered, this, &ThisClass::onAboutActionTriggered );
 	connect( ui->exitAction, &QAction::triggered, this, &ThisClass::close );
 
@@ -911,12 +859,33 @@ MainWindow::MainWindow()
 	connect( ui->noSfxChkBox, &QCheckBox::toggled, this, &ThisClass::onNoSFXToggled);
 	connect( ui->noMusicChkBox, &QCheckBox::toggled, this, &ThisClass::onNoMusicToggled );
 
+	// process scheduling
+	static const QRegularExpression cpuListRegex("^\\s*\\d+(\\s*-\\s*\\d+)?(\\s*,\\s*\\d+(\\s*-\\s*\\d+)?)*\\s*,?$");
+	ui->cpuAffinityLine->setValidator( new QRegularExpressionValidator( cpuListRegex, ui->cpuAffinityLine ) );
+	connect( ui->cpuAffinityLine, &QLineEdit::textChanged, this, &ThisClass::onCpuAffinityChanged );
+	connect( ui->niceLevelSpinBox, QOverload<int>::of( &QSpinBox::valueChanged ), this, &ThisClass::onNiceLevelChanged );
+	connect( ui->schedPolicyCmbBox, QOverload<int>::of( &QComboBox::currentIndexChanged ), this, &ThisClass::onSchedPolicySelected );
+	connect( ui->ioPrioClassCmbBox, QOverload<int>::of( &QComboBox::currentIndexChanged ), this, &ThisClass::onIOPrioClassSelected );
+	connect( ui->ioPrioLevelSpinBox, QOverload<int>::of( &QSpinBox::valueChanged ), this, &ThisClass::onIOPrioLevelChanged );
+	// these are applied via Linux-specific system calls, other systems have different mechanisms
+	ui->schedulingGrpBox->setVisible( os::canSetProcessScheduling() );
+
 	// setup the rest of widgets
 
 	connect( ui->presetCmdArgsLine, &QLineEdit::textChanged, this, &ThisClass::onPresetCmdArgsChanged );
 	connect( ui->globalCmdArgsLine, &QLineEdit::textChanged, this, &ThisClass::onGlobalCmdArgsChanged );
 	connect( ui->cmdPrefixLine, &QLineEdit::textChanged, this, &ThisClass::onCmdPrefixChanged );
 	connect( ui->launchBtn, &QPushButton::clicked, this, &ThisClass::onLaunchBtnClicked );
+
+	// coalesce the bursts of changes (typing, spinning, multi-selecting) into a single command update
+	launchCmdUpdateTimer.setSingleShot( true );
+	launchCmdUpdateTimer.setInterval( 40 );
+	connect( &launchCmdUpdateTimer, &QTimer::timeout, this, &ThisClass::flushLaunchCommandUpdate );
+
+	// don't read the files of every preset the user only passes by when going through the list
+	gameFilesWarmUpTimer.setSingleShot( true );
+	gameFilesWarmUpTimer.setInterval( 1000 );
+	connect( &gameFilesWarmUpTimer, &QTimer::timeout, this, &ThisClass::warmUpGameFiles );
 }
 
 void MainWindow::adjustUi()
@@ -929,6 +898,8 @@ void MainWindow::adjustUi()
 
 	// hide it by default, it's shown on startup
 	presetSearchPanel->collapse();
+	mapSearchPanel->collapse();
+	modSearchPanel->collapse();
 }
 
 void MainWindow::setupPresetList()
@@ -939,6 +910,9 @@ void MainWindow::setupPresetList()
 	// set selection rules
 	ui->presetListView->setSelectionMode( QAbstractItemView::SingleSelection );
 
+	// some users keep hundreds of presets
+	ui->presetListView->toggleHighVolumeMode( true );
+
 	// setup editing and separators
 	ui->presetListView->toggleItemEditing( true );
 	connect( &presetModel, &AListModel::itemDataChanged, this, &ThisClass::onPresetDataChanged );
@@ -1019,17 +993,20 @@ void MainWindow::setupMapPackList()
 	// set item filters
 	mapModel.setFilter( QDir::AllDirs | QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks );
 	mapModel.setNameFilters( doom::getModFileSuffixes() );
-	mapModel.setNameFilterDisables( false );
 
 	// make the list sorted by file name
 	mapModel.sort( int( ExtendedTreeView::SortKey::Name ) );
 
-	// remove the column names at the top
-	ui->mapDirView->setHeaderHidden( true );
+	// remove the generic file columns, keep only the name and the information read from the WADs
+	ui->mapDirView->hideColumn( MapPackTreeModel::SizeColumn );
+	ui->mapDirView->hideColumn( MapPackTreeModel::TypeColumn );
+	ui->mapDirView->hideColumn( MapPackTreeModel::DateColumn );
 
-	// remove all other columns except the first one with name
-	for (int i = 1; i < mapModel.columnCount(); ++i)
-		ui->mapDirView->hideColumn(i);
+	// allow sorting by any of the columns by clicking on the column names at the top
+	ui->mapDirView->header()->setSectionsClickable( true );
+	ui->mapDirView->header()->setSortIndicatorShown( true );
+	ui->mapDirView->header()->setSortIndicator( MapPackTreeModel::NameColumn, Qt::AscendingOrder );
+	connect( ui->mapDirView->header(), &QHeaderView::sortIndicatorChanged, this, &ThisClass::onMapSortIndicatorChanged );
 
 	// make the view display a horizontal scrollbar rather than clipping the items
 	ui->mapDirView->toggleAutomaticColumnResizing( true );
@@ -1052,6 +1029,8 @@ void MainWindow::setupMapPackList()
 	ui->mapDirView->addStandardMenuActions( ExtendedListView::MenuAction::SortFilesBy );
 	ui->mapDirView->addMenuSeparator();
 	ui->mapDirView->addStandardMenuActions( ExtendedListView::MenuAction::ToggleIcons );
+	ui->mapDirView->addMenuSeparator();
+	ui->mapDirView->addStandardMenuActions( ExtendedListView::MenuAction::Find );
 
 	connect( ui->mapDirView, &ExtendedTreeView::sortActionTriggered, this, &ThisClass::onSortActionTriggered );
 
@@ -1063,10 +1042,17 @@ void MainWindow::setupMapPackList()
 	hideLabelAction = ui->mapDirHelpLabel->addMenuAction( "Hide this label", {} );
 	connect( hideLabelAction, &QAction::triggered, this, &ThisClass::onMapHelpLabelHideTriggered );
 
-	// QFileSystemModel updates its content asynchronously in a separate thread. For this reason,
-	// when the model is set to display a certain directory, we cannot select items from the view right away,
-	// but must wait until the list is populated.
-	connect( &mapModel, &QFileSystemModel::directoryLoaded, this, &ThisClass::onMapDirUpdated );
+	// The model notifies about the loaded directory asynchronously (the same way QFileSystemModel did). For this reason,
+	// when the model is set to display a certain directory, we don't select items from the view right away,
+	// but wait until the list is populated.
+	connect( &mapModel, &MapPackTreeModel::directoryLoaded, this, &ThisClass::onMapDirUpdated );
+
+	// setup search
+	mapSearchPanel = new FuzzySearchPanel( ui->mapSearchLine );
+	connect( ui->mapDirView->findItemAction, &QAction::triggered, mapSearchPanel, &FuzzySearchPanel::expand );
+	connect( mapSearchPanel, &FuzzySearchPanel::searchPhraseChanged, this, &ThisClass::onMapSearchPhraseChanged );
+	connect( mapSearchPanel, &FuzzySearchPanel::resultChosen, this, &ThisClass::onMapSearchResultChosen );
+	connect( &mapModel, &MapPackTreeModel::searchIndexUpdated, this, &ThisClass::onMapSearchIndexUpdated );
 }
 
 void MainWindow::setupModList()
@@ -1077,6 +1063,9 @@ void MainWindow::setupModList()
 	// set selection rules
 	ui->modListView->setSelectionMode( QAbstractItemView::ExtendedSelection );
 
+	// mod libraries can have thousands of entries
+	ui->modListView->toggleHighVolumeMode( true );
+
 	// setup item checkboxes
 	ui->modListView->toggleCheckboxes( true );
 
@@ -1091,6 +1080,11 @@ void MainWindow::setupModList()
 	connect( &modModel, &AListModel::itemsRemoved, this, &ThisClass::onModsRemoved );
 	connect( ui->modListView, &ExtendedListView::dragAndDropFinished, this, &ThisClass::onModsDropped );
 
+	// dropping or selecting thousands of files is handled in background
+	modModel.setBulkDropHandler( [ this ]( QStringList paths, int row ) { startModImport( std::move(paths), row ); } );
+	connect( &modImporter, &BulkFileImporter::chunkReady, this, &ThisClass::onModImportChunkReady );
+	connect( &modImporter, &BulkFileImporter::finished, this, &ThisClass::onModImportFinished );
+
 	// set reaction when an item is checked or unchecked
 	connect( &modModel, &AListModel::itemDataChanged, this, &ThisClass::onModDataChanged );
 	connect( ui->modListView, &QListView::doubleClicked, this, &ThisClass::onModDoubleClicked );
@@ -1111,6 +1105,8 @@ void MainWindow::setupModList()
 	ui->modListView->addStandardMenuActions( ExtendedListView::MenuAction::Move );
 	ui->modListView->addMenuSeparator();
 	ui->modListView->addStandardMenuActions( ExtendedListView::MenuAction::ToggleIcons );
+	ui->modListView->addMenuSeparator();
+	ui->modListView->addStandardMenuActions( ExtendedListView::MenuAction::Find );
 
 	ui->modListView->toggleListModifications( true );
 
@@ -1138,6 +1134,21 @@ void MainWindow::setupModList()
 	connect( ui->modBtnDown, &QToolButton::clicked, this, &ThisClass::modMoveDown );
 
 	connect( ui->mapsAfterModsChkBox, &QCheckBox::toggled, this, &ThisClass::onMapsAfterModsToggled );
+
+	// setup search
+	modSearchPanel = new FuzzySearchPanel( ui->modSearchLine );
+	connect( ui->modListView->findItemAction, &QAction::triggered, modSearchPanel, &FuzzySearchPanel::expand );
+	connect( modSearchPanel, &FuzzySearchPanel::searchPhraseChanged, this, &ThisClass::onModSearchPhraseChanged );
+	connect( modSearchPanel, &FuzzySearchPanel::resultChosen, this, &ThisClass::onModSearchResultChosen );
+
+	// the index is rebuilt lazily on the next search, the list can change many times before that
+	auto invalidateModSearchIndex = [this]() { modSearchIndexDirty = true; };
+	connect( &modModel, &QAbstractItemModel::rowsInserted, this, invalidateModSearchIndex );
+	connect( &modModel, &QAbstractItemModel::rowsRemoved, this, invalidateModSearchIndex );
+	connect( &modModel, &QAbstractItemModel::rowsMoved, this, invalidateModSearchIndex );
+	connect( &modModel, &QAbstractItemModel::dataChanged, this, invalidateModSearchIndex );
+	connect( &modModel, &QAbstractItemModel::layoutChanged, this, invalidateModSearchIndex );
+	connect( &modModel, &QAbstractItemModel::modelReset, this, invalidateModSearchIndex );
 }
 
 void MainWindow::setupEnvVarLists()
@@ -1237,6 +1248,7 @@ void MainWindow::initAppDataDir()
 
 	optionsFilePath = appDataDir.filePath( defaultOptionsFileName );
 	cacheFilePath = appDataDir.filePath( defaultCacheFileName );
+	launchStatsFilePath = appDataDir.filePath( defaultLaunchStatsFileName );
 }
 
 // This is called when the window layout is initialized and widget sizes calculated,
@@ -1626,7 +1638,7 @@ void MainWindow::restoreLoadedOptions( OptionsToLoad && opts )
 		disableSelectionCallbacks = false;
 
 		// mark the default engine, if chosen
-		int defaultIdx = findSuch( engineModel, [&]( const Engine & e ){ return e.getID() == engineSettings.defaultEngine; } );
+		int defaultIdx = int( engineModel.findIndexByID( engineSettings.defaultEngine ) );
 		if (defaultIdx >= 0)
 		{
 			engineModel[ defaultIdx ].textColor = themes::getCurrentPalette().defaultEntryText;
@@ -1654,7 +1666,7 @@ void MainWindow::restoreLoadedOptions( OptionsToLoad && opts )
 		}
 
 		// mark the default IWAD, if chosen
-		int defaultIdx = findSuch( iwadModel, [&]( const IWAD & i ){ return i.getID() == iwadSettings.defaultIWAD; } );
+		int defaultIdx = int( iwadModel.findIndexByID( iwadSettings.defaultIWAD ) );
 		if (defaultIdx >= 0)
 		{
 			iwadModel[ defaultIdx ].textColor = themes::getCurrentPalette().defaultEntryText;
@@ -1674,6 +1686,8 @@ void MainWindow::restoreLoadedOptions( OptionsToLoad && opts )
 
 		ui->mapDirView->toggleIcons( mapSettings.showIcons );
 		mapModel.sort( mapSettings.sortColumn, mapSettings.sortOrder );
+		QSignalBlocker headerSignalBlocker( ui->mapDirView->header() );
+		ui->mapDirView->header()->setSortIndicator( mapSettings.sortColumn, mapSettings.sortOrder );
 	}
 
 	// mods
@@ -1681,7 +1695,7 @@ void MainWindow::restoreLoadedOptions( OptionsToLoad && opts )
 		wdg::deselectAllAndUnsetCurrent( ui->modListView );
 
 		modModel.startCompleteUpdate();
-		modModel.clear();
+		modModel.unbindList();
 		// mods will be restored to the UI, when a preset is selected
 		modModel.finishCompleteUpdate();
 
@@ -1708,8 +1722,7 @@ void MainWindow::restoreLoadedOptions( OptionsToLoad && opts )
 	// load the last selected preset
 	if (!opts.selectedPreset.isEmpty())
 	{
-		int selectedPresetIdx = findSuch( presetModel, [&]( const Preset & preset )
-		                                               { return preset.name == opts.selectedPreset; } );
+		int selectedPresetIdx = int( presetModel.findIndexByID( opts.selectedPreset ) );
 		if (selectedPresetIdx >= 0)
 		{
 			// This invokes the callback, which enables the dependent widgets and calls restorePreset(...)
@@ -1794,6 +1807,8 @@ void MainWindow::restorePreset( Preset & preset )
 	if (settings.audioOptsStorage == StoreToPreset)
 		restoreAudioOptions( preset.audioOpts );
 
+	restoreSchedulingOptions( preset.schedulingOpts );
+
 	// restore additional command line arguments
 	ui->presetCmdArgsLine->setText( preset.cmdArgs );
 
@@ -1813,8 +1828,7 @@ void MainWindow::restoreSelectedEngine( Preset & preset )
 
 	if (!preset.selectedEnginePath.isEmpty())  // the engine combo box might have been empty when creating this preset
 	{
-		int engineIdx = findSuch( engineModel, [&]( const Engine & engine )
-		                                       { return engine.executablePath == preset.selectedEnginePath; } );
+		int engineIdx = int( engineModel.findIndexByID( preset.selectedEnginePath ) );
 		if (engineIdx >= 0)
 		{
 			ui->engineCmbBox->setCurrentIndex( engineIdx );
@@ -1897,18 +1911,24 @@ void MainWindow::restoreSelectedIWAD( Preset & preset )
 
 	if (!preset.selectedIWAD.isEmpty())  // the IWAD may have not been selected when creating this preset
 	{
-		int iwadIdx = findSuch( iwadModel, [&]( const IWAD & iwad ) { return iwad.path == preset.selectedIWAD; } );
+		int iwadIdx = int( iwadModel.findIndexByID( preset.selectedIWAD ) );
 		if (iwadIdx >= 0)
 		{
 			wdg::selectSetCurrentAndScrollTo( ui->iwadListView, iwadIdx );
 
-			if (!fs::isValidFile( preset.selectedIWAD ))
+			// The file might be on a slow drive, so let the list update now and report the problem when we know.
+			if (auto status = pathChecker.findRecentResult( preset.selectedIWAD ))
 			{
-				reportUserError( "IWAD no longer exists",
-					"IWAD selected for this preset ("%preset.selectedIWAD%") no longer exists. "
-					"Please select another one."
+				onPresetIWADChecked( preset.selectedIWAD, *status );
+			}
+			else
+			{
+				pathChecker.checkPaths( { preset.selectedIWAD }, this,
+					[ this, iwadPath = preset.selectedIWAD ]( const AsyncPathChecker::Results & results )
+					{
+						onPresetIWADChecked( iwadPath, results.value( iwadPath, PathStatus::Missing ) );
+					}
 				);
-				highlightListItemAsInvalid( iwadModel[ iwadIdx ] );
 			}
 		}
 		else
@@ -1932,6 +1952,27 @@ void MainWindow::restoreSelectedIWAD( Preset & preset )
 	}
 }
 
+void MainWindow::onPresetIWADChecked( const QString & iwadPath, PathStatus status )
+{
+	if (status == PathStatus::File)
+		return;
+
+	if (!selectedPreset || selectedPreset->selectedIWAD != iwadPath)
+		return;  // the user has switched to another preset in the meantime
+
+	reportUserError( "IWAD no longer exists",
+		"IWAD selected for this preset ("%iwadPath%") no longer exists. "
+		"Please select another one."
+	);
+
+	int iwadIdx = int( iwadModel.findIndexByID( iwadPath ) );
+	if (iwadIdx >= 0)
+	{
+		highlightListItemAsInvalid( iwadModel[ iwadIdx ] );
+		iwadModel.finishEditingItemData( iwadIdx, 1, { Qt::ForegroundRole } );
+	}
+}
+
 void MainWindow::restoreSelectedMapPacks( Preset & preset )
 {
 	auto origSelection = ui->mapDirView->selectionModel()->selection();
@@ -1947,19 +1988,12 @@ void MainWindow::restoreSelectedMapPacks( Preset & preset )
 	for (const QString & path : mapPacksCopy)
 	{
 		QModelIndex mapIdx = mapModel.index( path );
+		// The model lists only the entries that existed when their directory was read and the directory watcher
+		// keeps it up to date, so there's no need to ask the file-system again for every selected entry.
 		if (mapIdx.isValid() && fs::isInsideDir( mapRootDir, path ))
 		{
-			if (fs::isValidEntry( path ))
-			{
-				preset.selectedMapPacks.append( path );  // put back only items that are valid
-				wdg::selectSetCurrentAndScrollTo( ui->mapDirView, mapIdx );
-			}
-			else
-			{
-				reportUserError( "Map pack no longer exists",
-					"Map pack selected for this preset ("%path%") no longer exists."
-				);
-			}
+			preset.selectedMapPacks.append( path );  // put back only items that are valid
+			wdg::selectSetCurrentAndScrollTo( ui->mapDirView, mapIdx );
 		}
 		else
 		{
@@ -1979,25 +2013,59 @@ void MainWindow::restoreSelectedMapPacks( Preset & preset )
 	}
 }
 
+static void highlightModByPathStatus( const Mod & mod, PathStatus status )
+{
+	// Let's just highlight it now, we will show warning when the user tries to launch it.
+	if (status == PathStatus::Missing)
+		highlightListItemAsInvalid( mod );
+	else
+		unhighlightListItem( mod );
+}
+
 void MainWindow::restoreSelectedMods( Preset & preset )
 {
 	wdg::deselectAllAndUnsetCurrent( ui->modListView );  // this actually doesn't call a toggle callback, because the list is checkbox-based
 
+	QStringList pathsToCheck;
+
+	// The model works directly with the preset's list, so the edits don't have to be copied back to the preset.
 	modModel.startCompleteUpdate();
-	clearButKeepAllocated( modModel );
-	modModel.reserve( preset.mods.size() );
-	for (Mod & mod : preset.mods)
+	modModel.bindList( preset.mods );
+	for (const Mod & mod : preset.mods)
 	{
-		modModel.append( mod );
-		if ((!mod.isSeparator && !mod.isCmdArg) && !fs::isValidEntry( mod.path ))
+		if (mod.isSeparator || mod.isCmdArg)
+		{
+			unhighlightListItem( mod );
+		}
+		else if (auto status = pathChecker.findRecentResult( mod.path ))
+		{
+			highlightModByPathStatus( mod, *status );
+		}
+		else
 		{
-			// Let's just highlight it now, we will show warning when the user tries to launch it.
-			//reportUserError( "Mod no longer exists",
-			//	"A mod file \""%mod.path%"\" from this preset no longer exists. Please update it." );
-			highlightListItemAsInvalid( modModel.last() );
+			unhighlightListItem( mod );  // the mark from the last time this preset was selected might be outdated
+			pathsToCheck.append( mod.path );
 		}
 	}
 	modModel.finishCompleteUpdate();
+
+	// Checking many files on a network drive can take a while, so let the list appear now and highlight the missing
+	// ones when the results arrive.
+	pathChecker.checkPaths( std::move(pathsToCheck), this,
+		[ this, modList = &preset.mods ]( const AsyncPathChecker::Results & results )
+		{
+			if (!modModel.isBoundTo( modList ))
+				return;  // the user has switched to another preset in the meantime
+
+			for (const Mod & mod : as_const( modModel ))
+			{
+				auto resultIter = results.find( mod.path );
+				if (resultIter != results.end() && !mod.isSeparator && !mod.isCmdArg)
+					highlightModByPathStatus( mod, resultIter.value() );
+			}
+			modModel.finishEditingItemData( 0, -1, { Qt::ForegroundRole } );
+		}
+	);
 }
 
 void MainWindow::restoreAlternativePaths( const Preset & preset )
@@ -2161,6 +2229,16 @@ void MainWindow::restoreAudioOptions( const AudioOptions & opts )
 	ui->noMusicChkBox->setChecked( opts.noMusic );
 }
 
+void MainWindow::restoreSchedulingOptions( const os::ProcessScheduling & opts )
+{
+	ui->cpuAffinityLine->setText( opts.cpuAffinity );
+	ui->niceLevelSpinBox->setValue( opts.niceLevel );
+	ui->schedPolicyCmbBox->setCurrentIndex( int( opts.schedPolicy ) );
+	ui->ioPrioClassCmbBox->setCurrentIndex( int( opts.ioPrioClass ) );
+	ui->ioPrioLevelSpinBox->setValue( opts.ioPrioLevel );
+	ui->ioPrioLevelSpinBox->setEnabled( opts.ioPrioClass == os::IOPrioClass::BestEffort );
+}
+
 void MainWindow::restoreGlobalOptions( const GlobalOptions & opts )
 {
 	ui->altConfigDirPresetChkBox->setChecked( opts.usePresetNameAsConfigDir );
@@ -2178,6 +2256,8 @@ void MainWindow::restoreEnvVars( const EnvVars & envVars, QTableWidget * table )
 {
 	disableEnvVarsCallbacks = true;
 
+	table->setRowCount( 0 );  // the table might still contain the rows of the previously selected preset
+
 	for (const auto & envVar : envVars)
 	{
 		int newRowIdx = table->rowCount();
@@ -2350,6 +2430,20 @@ void MainWindow::runOptsStorageDialog()
 	}
 }
 
+void MainWindow::runLaunchStatsDialog()
+{
+	QList< LaunchStatsSummary > summaries = summarizeLaunchRecords( readLaunchRecords( launchStatsFilePath ) );
+	if (summaries.isEmpty())
+	{
+		reportInformation( "No statistics", "Nothing has been launched yet, the statistics will appear after the first launch." );
+		return;
+	}
+
+	LaunchStatsDialog dialog( this, summaries, selectedPreset ? selectedPreset->name : QString() );
+
+	dialog.exec();
+}
+
 void MainWindow::runGameOptsDialog()
 {
 	GameplayOptions & activeGameOpts = activeGameplayOptions();
@@ -2363,7 +2457,7 @@ void MainWindow::runGameOptsDialog()
 	{
 		activeGameOpts.assign( dialog.gameplayDetails );
 		scheduleSavingOptions();
-		updateLaunchCommand();
+		updateLaunchCommand( LaunchCmdPart::Gameplay );
 	}
 }
 
@@ -2382,7 +2476,7 @@ void MainWindow::runCompatOptsDialog()
 		// cache the command line args string, so that it doesn't need to be regenerated on every command line update
 		compatOptsCmdArgs = CompatOptsDialog::getCmdArgsFromOptions( dialog.compatDetails );
 		scheduleSavingOptions();
-		updateLaunchCommand();
+		updateLaunchCommand( LaunchCmdPart::Compat );
 	}
 }
 
@@ -2400,7 +2494,7 @@ void MainWindow::runPlayerColorDialog()
 		activeMultOpts.playerColor = dialog.selectedColor();
 		wdg::setButtonColor( ui->playerColorBtn, activeMultOpts.playerColor );
 		scheduleSavingOptions();
-		updateLaunchCommand();
+		updateLaunchCommand( LaunchCmdPart::Multiplayer );
 	}
 }
 
@@ -2570,6 +2664,11 @@ void MainWindow::onImportFromScriptTriggered()
 }
 */
 
+void MainWindow::onLaunchStatsTriggered()
+{
+	runLaunchStatsDialog();
+}
+
 
 //----------------------------------------------------------------------------------------------------------------------
 // item selection
@@ -2589,7 +2688,7 @@ void MainWindow::autoselectItems()
 		else
 		{
 			// select engine marked as default
-			int defaultIdx = findSuch( engineModel, [&]( const Engine & e ){ return e.getID() == engineSettings.defaultEngine; } );
+			int defaultIdx = int( engineModel.findIndexByID( engineSettings.defaultEngine ) );
 			if (defaultIdx >= 0)
 				ui->engineCmbBox->setCurrentIndex( defaultIdx );
 		}
@@ -2604,7 +2703,7 @@ void MainWindow::autoselectItems()
 		else
 		{
 			// select IWAD marked as default
-			int defaultIdx = findSuch( iwadModel, [&]( const IWAD & i ){ return i.getID() == iwadSettings.defaultIWAD; } );
+			int defaultIdx = int( iwadModel.findIndexByID( iwadSettings.defaultIWAD ) );
 			if (defaultIdx >= 0)
 				wdg::selectAndSetCurrentByIndex( ui->iwadListView, defaultIdx );
 		}
@@ -2624,11 +2723,14 @@ void MainWindow::onPresetToggled( const QItemSelection & /*selected*/, const QIt
 	{
 		togglePresetSubWidgets( selectedPreset );  // enable all widgets that contain preset settings
 		restorePreset( *selectedPreset );  // load the content of the selected preset into the other widgets
+		gameFilesWarmUpTimer.start();  // if the user stays on it, they are likely to launch it soon
 	}
 	else  // the preset was deselected using CTRL
 	{
 		togglePresetSubWidgets( nullptr );  // disable the widgets so that user can't enter data that would not be saved anywhere
 		clearPresetSubWidgets();  // clear the other widgets that display the content of the preset
+		gameFilesWarmUpTimer.stop();
+		gameFilesWarmer.cancel();
 	}
 }
 
@@ -2663,6 +2765,7 @@ void MainWindow::togglePresetSubWidgets( const Preset * selectedPreset )
 
 	ui->videoGrpBox->setEnabled( selectedPreset || settings.videoOptsStorage != StoreToPreset );
 	ui->audioGrpBox->setEnabled( selectedPreset || settings.audioOptsStorage != StoreToPreset );
+	ui->schedulingGrpBox->setEnabled( selectedPreset != nullptr );
 
 	// Environment tab
 
@@ -2680,7 +2783,7 @@ void MainWindow::clearPresetSubWidgets()
 	wdg::deselectAllAndUnsetCurrent( ui->mapDirView );
 	wdg::deselectAllAndUnsetCurrent( ui->modListView );
 	modModel.startCompleteUpdate();
-	modModel.clear();
+	modModel.unbindList();  // the preset might be about to be deleted
 	modModel.finishCompleteUpdate();
 
 	ui->presetCmdArgsLine->clear();
@@ -2735,6 +2838,8 @@ void MainWindow::clearPresetSubWidgets()
 		ui->noMusicChkBox->setChecked( false );
 	}
 
+	restoreSchedulingOptions( os::ProcessScheduling() );
+
 	// Environment tab
 
 	ui->presetEnvVarTable->clearContents();  // clear() also clears the column names
@@ -2847,7 +2952,7 @@ void MainWindow::onConfigSelected( int index )
 	}*/
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Config );
 }
 
 void MainWindow::onIWADToggled( const QItemSelection & /*selected*/, const QItemSelection & /*deselected*/ )
@@ -2910,7 +3015,7 @@ void MainWindow::onMapPackToggled( const QItemSelection & /*selected*/, const QI
 	}
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files | LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::onIWADDoubleClicked( const QModelIndex & index )
@@ -2968,12 +3073,6 @@ void MainWindow::onModDoubleClicked( const QModelIndex & index )
 			modModel.append( newDMB );
 			modModel.finishAppendingItems();
 
-			// add it also to the current preset
-			if (selectedPreset)
-			{
-				selectedPreset->mods.append( newDMB );
-			}
-
 			scheduleSavingOptions();
 		}
 		else if (result.outcome == DMBEditor::Outcome::Deleted)
@@ -2982,16 +3081,10 @@ void MainWindow::onModDoubleClicked( const QModelIndex & index )
 			modModel.removeAt( index.row() );
 			modModel.finishRemovingItems();
 
-			// remove it also from the current preset
-			if (selectedPreset)
-			{
-				selectedPreset->mods.removeAt( index.row() );
-			}
-
 			scheduleSavingOptions();
 		}
 
-		updateLaunchCommand();
+		updateLaunchCommand( LaunchCmdPart::Files );
 	}
 	else
 	{
@@ -3011,23 +3104,14 @@ void MainWindow::onCloneConfigBtnClicked()
 
 void MainWindow::onMapDirUpdated( const QString & path )
 {
-	// the QFileSystemModel mapModel has finally updated its content from mapSettings.dir
-	if (path == pathConvertor.getAbsolutePath( mapSettings.dir ))
+	// the mapModel has finally updated its content from mapSettings.dir
+	if (path == mapModel.rootPath())
 	{
-		// idiotic workaround, because Qt never stops surprising me with its stupidity.
-		//
-		// The QFileSystemModel::directoryLoaded signal is supposed to indicate the mapModel is fully loaded,
-		// but still when we call mapModel.index( path ), it returns a zeroed-out model index with incorrect row number.
-		// This is a desperate attempt to call restoreSelectedMapPacks() when the mapModel.index( path ) finally starts
-		// returning valid indexes so that we can select the right items in the view.
-		QTimer::singleShot( 0, nullptr, [ this ]()
+		if (selectedPreset)
 		{
-			if (selectedPreset)
-			{
-				// now we can finally select the right items in the map pack view
-				restoreSelectedMapPacks( *selectedPreset );
-			}
-		});
+			// now we can finally select the right items in the map pack view
+			restoreSelectedMapPacks( *selectedPreset );
+		}
 	}
 }
 
@@ -3263,11 +3347,17 @@ void MainWindow::onMapIconsToggled()
 
 void MainWindow::onSortActionTriggered( ExtendedTreeView::SortKey key, Qt::SortOrder order )
 {
-	mapSettings.sortColumn = int(key);
+	// Our sort keys correspond to the column indexes in the MapPackTreeModel, so we can convert it directly.
+	// This will emit sortIndicatorChanged, if it's different from the current one, which will do the sorting.
+	ui->mapDirView->header()->setSortIndicator( int(key), order );
+}
+
+void MainWindow::onMapSortIndicatorChanged( int column, Qt::SortOrder order )
+{
+	mapSettings.sortColumn = column;
 	mapSettings.sortOrder = order;
 
-	// Our sort keys correspond to the column indexes in the QFileSystemModel, so we can convert it directly.
-	mapModel.sort( int(key), order );
+	mapModel.sort( column, order );
 
 	//scheduleSavingOptions();
 }
@@ -3281,6 +3371,49 @@ void MainWindow::onMapHelpLabelHideTriggered()
 	scheduleSavingOptions();
 }
 
+void MainWindow::onMapSearchPhraseChanged( const QString & phrase )
+{
+	mapSearchResults = mapModel.searchEntries( phrase, 50 );
+	mapSearchPanel->setResults( mapSearchResults );
+
+	if (mapSearchResults.isEmpty())
+		return;
+
+	// Jump to the best match while typing, but don't select it, that would change the launch parameters.
+	// The directories on the way are populated from the model's last scan, so this doesn't wait for the disk.
+	QModelIndex bestMatchIdx = mapModel.index( mapModel.rootDirectory().filePath( mapSearchResults.first() ) );
+	if (bestMatchIdx.isValid())
+	{
+		wdg::expandParentsOfNode( ui->mapDirView, bestMatchIdx );
+		wdg::setCurrentItemByIndex( ui->mapDirView, bestMatchIdx );  // also scrolls to it
+	}
+}
+
+void MainWindow::onMapSearchIndexUpdated()
+{
+	// The user might have started typing before the whole tree was indexed.
+	// Only the results are updated, jumping somewhere else now would be confusing.
+	const QString phrase = ui->mapSearchLine->text();
+	if (phrase.isEmpty())
+		return;
+
+	mapSearchResults = mapModel.searchEntries( phrase, 50 );
+	mapSearchPanel->setResults( mapSearchResults );
+}
+
+void MainWindow::onMapSearchResultChosen( int resultIdx )
+{
+	if (resultIdx < 0 || resultIdx >= mapSearchResults.size())
+		return;
+
+	QModelIndex chosenIdx = mapModel.index( mapModel.rootDirectory().filePath( mapSearchResults[ resultIdx ] ) );
+	if (!chosenIdx.isValid())
+		return;  // the file has been deleted since the index was built
+
+	wdg::expandParentsOfNode( ui->mapDirView, chosenIdx );
+	wdg::chooseItemByIndex( ui->mapDirView, chosenIdx );
+}
+
 
 //----------------------------------------------------------------------------------------------------------------------
 // mod list manipulation
@@ -3298,21 +3431,21 @@ void MainWindow::modAdd()
 
 	modSettings.lastUsedDir = DialogWithPaths::lastUsedDir;
 
+	if (paths.size() >= AListModel::bulkDropMinCount)
+	{
+		startModImport( paths, modModel.size() );
+		return;  // the rest is done when the import finishes
+	}
+
 	for (const QString & path : paths)
 	{
 		Mod mod( path, /*checked*/true );
 
 		wdg::appendItem( ui->modListView, modModel, mod );
-
-		// add it also to the current preset
-		if (selectedPreset)
-		{
-			selectedPreset->mods.append( mod );
-		}
 	}
 
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::modAddDir()
@@ -3327,14 +3460,8 @@ void MainWindow::modAddDir()
 
 	wdg::appendItem( ui->modListView, modModel, mod );
 
-	// add it also to the current preset
-	if (selectedPreset)
-	{
-		selectedPreset->mods.append( mod );
-	}
-
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::modAddArg()
@@ -3344,17 +3471,11 @@ void MainWindow::modAddArg()
 
 	int appendedIdx = wdg::appendItem( ui->modListView, modModel, mod );
 
-	// add it also to the current preset
-	if (selectedPreset)
-	{
-		selectedPreset->mods.append( mod );
-	}
-
 	// open edit mode so that user can enter the command line argument
 	wdg::editItemAtIndex( ui->modListView, appendedIdx );
 
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::modCreateNewDMB()
@@ -3367,14 +3488,8 @@ void MainWindow::modCreateNewDMB()
 
 	wdg::appendItem( ui->modListView, modModel, mod );
 
-	// add it also to the current preset
-	if (selectedPreset)
-	{
-		selectedPreset->mods.append( mod );
-	}
-
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::modAddExistingDMB()
@@ -3388,16 +3503,10 @@ void MainWindow::modAddExistingDMB()
 		Mod mod( path, /*checked*/true );
 
 		wdg::appendItem( ui->modListView, modModel, mod );
-
-		// add it also to the current preset
-		if (selectedPreset)
-		{
-			selectedPreset->mods.append( mod );
-		}
 	}
 
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::modInsertSeparator()
@@ -3410,12 +3519,6 @@ void MainWindow::modInsertSeparator()
 
 	wdg::insertItem( ui->modListView, modModel, separator, insertIdx );
 
-	// insert it also to the current preset
-	if (selectedPreset)
-	{
-		selectedPreset->mods.insert( insertIdx, separator );
-	}
-
 	// open edit mode so that user can name the preset
 	wdg::editItemAtIndex( ui->modListView, insertIdx );
 
@@ -3429,153 +3532,64 @@ void MainWindow::modDelete()
 	if (removedIndexes.isEmpty())  // no item was selected
 		return;
 
-	// remove it also from the current preset
-	if (selectedPreset)
-	{
-		int removedCnt = 0;
-		for (int removedIdx : removedIndexes)
-		{
-			selectedPreset->mods.removeAt( removedIdx - removedCnt );
-			removedCnt++;
-		}
-	}
-
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::modMoveUp()
 {
-	restoringPresetInProgress = true;  // prevent onModDataChanged() from updating our preset too early and incorrectly
-
 	const auto movedIndexes = wdg::moveSelectedItemsUp( ui->modListView, modModel );
 
-	restoringPresetInProgress = false;
-
 	if (movedIndexes.isEmpty())  // no item was selected or they were already at the top
 		return;
 
-	// move it up also in the preset
-	if (selectedPreset)
-	{
-		for (int movedIdx : movedIndexes)
-		{
-			selectedPreset->mods.move( movedIdx, movedIdx - 1 );
-		}
-	}
-
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::modMoveDown()
 {
-	restoringPresetInProgress = true;  // prevent onModDataChanged() from updating our preset too early and incorrectly
-
 	const auto movedIndexes = wdg::moveSelectedItemsDown( ui->modListView, modModel );
 
-	restoringPresetInProgress = false;
-
 	if (movedIndexes.isEmpty())  // no item was selected or they were already at the bottom
 		return;
 
-	// move it down also in the preset
-	if (selectedPreset)
-	{
-		for (int movedIdx : movedIndexes)
-		{
-			selectedPreset->mods.move( movedIdx, movedIdx + 1 );
-		}
-	}
-
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::modMoveToTop()
 {
-	restoringPresetInProgress = true;  // prevent onModDataChanged() from updating our preset too early and incorrectly
-
 	const auto movedIndexes = wdg::moveSelectedItemsToTop( ui->modListView, modModel );
 
-	restoringPresetInProgress = false;
-
 	if (movedIndexes.isEmpty())  // no item was selected
 		return;
 
-	// update the preset
-	if (selectedPreset)
-	{
-		selectedPreset->mods = modModel.list();  // not the most optimal way, but the size of the list will be always small
-	}
-
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::modMoveToBottom()
 {
-	restoringPresetInProgress = true;  // prevent onModDataChanged() from updating our preset too early and incorrectly
-
 	const auto movedIndexes = wdg::moveSelectedItemsToBottom( ui->modListView, modModel );
 
-	restoringPresetInProgress = false;
-
 	if (movedIndexes.isEmpty())  // no item was selected
 		return;
 
-	// update the preset
-	if (selectedPreset)
-	{
-		selectedPreset->mods = modModel.list();  // not the most optimal way, but the size of the list will be always small
-	}
-
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
-void MainWindow::onModDataChanged( int row, int count, const QVector<int> & roles )
+void MainWindow::onModDataChanged( int /*row*/, int /*count*/, const QVector<int> & /*roles*/ )
 {
-	auto updateEachModifiedModInPreset = [ this, row, count ]( const auto & updateMod )
-	{
-		if (selectedPreset && !restoringPresetInProgress)
-		{
-			for (int idx = row; idx < row + count; idx++)
-			{
-				updateMod( selectedPreset->mods[ idx ], modModel[ idx ] );
-			}
-		}
-	};
-
-	if (roles.contains( Qt::CheckStateRole ))  // check state of some checkboxes changed
-	{
-		// update the current preset
-		updateEachModifiedModInPreset( []( Mod & presetMod, const Mod & changedMod )
-		{
-			presetMod.checked = changedMod.checked;
-		});
-	}
-	else if (roles.contains( Qt::EditRole ))  // name of separator or data of custom cmd argument changed
-	{
-		// update the current preset
-		updateEachModifiedModInPreset( []( Mod & presetMod, const Mod & changedMod )
-		{
-			presetMod.name = changedMod.name;
-		});
-	}
+	// the model works directly with the preset's mod list, so the preset is already up to date
 
 	scheduleSavingOptions( true );  // we can assume options storage was modified, otherwise this callback wouldn't be called
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
-void MainWindow::onModsInserted( int row, int count )
+void MainWindow::onModsInserted( int /*row*/, int /*count*/ )
 {
-	if (selectedPreset)
-	{
-		subrange insertedMods( modModel.cbegin() + row, modModel.cbegin() + row + count );
-		selectedPreset->mods.insertMultiple( row, insertedMods );
-	}
-
 	// Let's not update now, when the state of the model might not be final (rows may be removed soon after).
 	// onModsDropped() will be called when the drag&drop is finished, so that we can update it only once.
 	if (ui->modListView->isDragAndDropInProgress())
@@ -3584,16 +3598,11 @@ void MainWindow::onModsInserted( int row, int count )
 	}
 
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
-void MainWindow::onModsRemoved( int row, int count )
+void MainWindow::onModsRemoved( int /*row*/, int /*count*/ )
 {
-	if (selectedPreset)
-	{
-		selectedPreset->mods.removeCountAt( row, count );
-	}
-
 	// Let's not update now, when the state of the model might not be final (more rows may be removed soon after).
 	// onModsDropped() will be called when the drag&drop is finished, so that we can update it only once.
 	if (ui->modListView->isDragAndDropInProgress())
@@ -3602,7 +3611,7 @@ void MainWindow::onModsRemoved( int row, int count )
 	}
 
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 // This call will always be preceeded by a call to onModsInserted,
@@ -3628,7 +3637,86 @@ void MainWindow::onModsDropped( int row, int count, DnDSources dndSource )
 	}
 
 	scheduleSavingOptions();
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
+}
+
+void MainWindow::startModImport( QStringList paths, int row )
+{
+	if (!modModel.canBeModified())
+	{
+		reportLogicError( u"startModImport", "Model cannot be modified",
+			"Cannot insert items because the model is locked for changes."
+		);
+		return;
+	}
+
+	modImporter.cancel();  // the chunks of the previous import that have already been inserted stay
+
+	modImportTargetList = &as_const( modModel ).list();
+	modImportRow = row;
+
+	if (!modImportProgress)
+	{
+		modImportProgress = new QProgressDialog( this );
+		modImportProgress->setWindowTitle( "Adding mods" );
+		modImportProgress->setLabelText( "Checking the added files..." );
+		modImportProgress->setWindowModality( Qt::WindowModal );  // the mod list must not change under our hands
+		modImportProgress->setMinimumDuration( 500 );  // don't flash the dialog when it's done quickly
+		modImportProgress->setAutoReset( false );
+		modImportProgress->setAutoClose( false );
+		connect( modImportProgress, &QProgressDialog::canceled, this, &ThisClass::onModImportCancelRequested );
+	}
+	modImportProgress->setRange( 0, int( paths.size() ) );
+	modImportProgress->setValue( 0 );
+
+	modImporter.start( std::move(paths) );
+}
+
+void MainWindow::onModImportChunkReady( const QStringList & existingPaths, int processedCount, int totalCount )
+{
+	if (!modModel.isBoundTo( modImportTargetList ) || !modModel.canBeModified())
+	{
+		modImporter.cancel();  // the user has switched to another preset or started filtering the list
+		return;
+	}
+
+	if (!existingPaths.isEmpty())
+	{
+		const int row = std::min( modImportRow, int( modModel.size() ) );
+		const int count = int( existingPaths.size() );
+
+		std::vector< Mod > mods;
+		mods.reserve( size_t( count ) );
+		for (const QString & path : existingPaths)
+			mods.emplace_back( path, /*checked*/true );
+
+		// insert the whole chunk in one pass
+		modModel.startInsertingItems( row, count );
+		modModel.insertMultiple( row, std::move( mods ) );
+		modModel.finishInsertingItems();
+		// we're modifying the model ourselves so we don't need to be notified about it
+
+		modImportRow = row + count;
+	}
+
+	modImportProgress->setMaximum( totalCount );
+	modImportProgress->setValue( processedCount );
+}
+
+void MainWindow::onModImportCancelRequested()
+{
+	modImporter.cancel();
+}
+
+void MainWindow::onModImportFinished( bool /*cancelled*/ )
+{
+	modImportProgress->reset();
+	modImportProgress->hide();
+
+	modImportTargetList = nullptr;
+
+	scheduleSavingOptions();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::onMapsAfterModsToggled( bool checked )
@@ -3636,7 +3724,7 @@ void MainWindow::onMapsAfterModsToggled( bool checked )
 	bool storageModified = STORE_PRESET_OPTION( .loadMapsAfterMods, checked );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Files );
 }
 
 void MainWindow::onModIconsToggled()
@@ -3646,6 +3734,42 @@ void MainWindow::onModIconsToggled()
 	scheduleSavingOptions();
 }
 
+void MainWindow::onModSearchPhraseChanged( const QString & phrase )
+{
+	if (modSearchIndexDirty)
+	{
+		modSearchIndex.clear();
+		modSearchIndex.reserve( modModel.size() );
+		for (const Mod & mod : modModel)
+			modSearchIndex.addEntry( mod.name );  // the entry IDs will match the row indexes
+		modSearchIndexDirty = false;
+	}
+
+	const auto matches = modSearchIndex.search( phrase, 50 );
+
+	modSearchResults.clear();
+	QStringList resultTexts;
+	for (const TrigramIndex::Match & match : matches)
+	{
+		modSearchResults.append( match.id );
+		resultTexts.append( modSearchIndex.entryText( match.id ) );
+	}
+	modSearchPanel->setResults( resultTexts );
+
+	if (!modSearchResults.isEmpty())
+	{
+		wdg::setCurrentItemByIndex( ui->modListView, modSearchResults.first() );  // also scrolls to it
+	}
+}
+
+void MainWindow::onModSearchResultChosen( int resultIdx )
+{
+	if (resultIdx < 0 || resultIdx >= modSearchResults.size() || modSearchIndexDirty)
+		return;  // the list has changed while the popup was open, the row may no longer be valid
+
+	wdg::chooseItemByIndex( ui->modListView, modSearchResults[ resultIdx ] );
+}
+
 
 //----------------------------------------------------------------------------------------------------------------------
 // launch mode
@@ -3666,7 +3790,7 @@ void MainWindow::onModeChosen_Default()
 	}
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode | LaunchCmdPart::Gameplay | LaunchCmdPart::Compat );
 }
 
 void MainWindow::onModeChosen_LaunchMap()
@@ -3685,7 +3809,7 @@ void MainWindow::onModeChosen_LaunchMap()
 	}
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode | LaunchCmdPart::Gameplay | LaunchCmdPart::Compat );
 }
 
 void MainWindow::onModeChosen_SavedGame()
@@ -3699,7 +3823,7 @@ void MainWindow::onModeChosen_SavedGame()
 	toggleOptionsSubwidgets( chosenMode );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode | LaunchCmdPart::Gameplay | LaunchCmdPart::Compat );
 }
 
 void MainWindow::onModeChosen_RecordDemo()
@@ -3713,7 +3837,7 @@ void MainWindow::onModeChosen_RecordDemo()
 	toggleOptionsSubwidgets( chosenMode );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode | LaunchCmdPart::Gameplay | LaunchCmdPart::Compat );
 }
 
 void MainWindow::onModeChosen_ReplayDemo()
@@ -3729,7 +3853,7 @@ void MainWindow::onModeChosen_ReplayDemo()
 	ui->multiplayerGrpBox->setChecked( false );   // no multiplayer when replaying demo
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode | LaunchCmdPart::Gameplay | LaunchCmdPart::Compat );
 }
 
 void MainWindow::onModeChosen_ResumeDemo()
@@ -3745,7 +3869,7 @@ void MainWindow::onModeChosen_ResumeDemo()
 	ui->multiplayerGrpBox->setChecked( false );   // no multiplayer when replaying demo
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode | LaunchCmdPart::Gameplay | LaunchCmdPart::Compat );
 }
 
 void MainWindow::toggleLaunchModeSubwidgets( LaunchMode mode )
@@ -3795,7 +3919,7 @@ void MainWindow::onMapChanged( const QString & mapName )
 	/*bool storageModified =*/ STORE_LAUNCH_OPTION( .mapName, mapName );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::onMapChanged_demo( const QString & mapName )
@@ -3806,7 +3930,7 @@ void MainWindow::onMapChanged_demo( const QString & mapName )
 	/*bool storageModified =*/ STORE_LAUNCH_OPTION( .mapName_demo, mapName );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::onSavedGameSelected( int saveIdx )
@@ -3819,7 +3943,7 @@ void MainWindow::onSavedGameSelected( int saveIdx )
 	/*bool storageModified =*/ STORE_LAUNCH_OPTION( .saveFile, saveFileName );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::onDemoFileChanged_record( const QString & fileName )
@@ -3830,7 +3954,7 @@ void MainWindow::onDemoFileChanged_record( const QString & fileName )
 	/*bool storageModified =*/ STORE_LAUNCH_OPTION( .demoFile_record, fileName );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::onDemoFileSelected_replay( int demoIdx )
@@ -3843,7 +3967,7 @@ void MainWindow::onDemoFileSelected_replay( int demoIdx )
 	/*bool storageModified =*/ STORE_LAUNCH_OPTION( .demoFile_replay, demoFileName );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::onDemoFileSelected_resume( int demoIdx )
@@ -3856,7 +3980,7 @@ void MainWindow::onDemoFileSelected_resume( int demoIdx )
 	/*bool storageModified =*/ STORE_LAUNCH_OPTION( .demoFile_resumeFrom, demoFileName );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::onDemoFileChanged_resume( const QString & fileName )
@@ -3867,7 +3991,7 @@ void MainWindow::onDemoFileChanged_resume( const QString & fileName )
 	/*bool storageModified =*/ STORE_LAUNCH_OPTION( .demoFile_resumeTo, fileName );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::LaunchMode );
 }
 
 
@@ -3888,7 +4012,7 @@ void MainWindow::onSkillSelected( int comboBoxIdx )
 		ui->skillSpinBox->setValue( skillIdx );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Gameplay );
 }
 
 void MainWindow::onSkillNumChanged( int skillNum )
@@ -3896,7 +4020,7 @@ void MainWindow::onSkillNumChanged( int skillNum )
 	bool storageModified = STORE_GAMEPLAY_OPTION( .skillNum, skillNum );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Gameplay );
 }
 
 void MainWindow::onNoMonstersToggled( bool checked )
@@ -3904,7 +4028,7 @@ void MainWindow::onNoMonstersToggled( bool checked )
 	bool storageModified = STORE_GAMEPLAY_OPTION( .noMonsters, checked );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Gameplay );
 }
 
 void MainWindow::onFastMonstersToggled( bool checked )
@@ -3912,7 +4036,7 @@ void MainWindow::onFastMonstersToggled( bool checked )
 	bool storageModified = STORE_GAMEPLAY_OPTION( .fastMonsters, checked );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Gameplay );
 }
 
 void MainWindow::onMonstersRespawnToggled( bool checked )
@@ -3920,7 +4044,7 @@ void MainWindow::onMonstersRespawnToggled( bool checked )
 	bool storageModified = STORE_GAMEPLAY_OPTION( .monstersRespawn, checked );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Gameplay );
 }
 
 void MainWindow::onPistolStartToggled( bool checked )
@@ -3928,7 +4052,7 @@ void MainWindow::onPistolStartToggled( bool checked )
 	bool storageModified = STORE_GAMEPLAY_OPTION( .pistolStart, checked );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Gameplay );
 }
 
 void MainWindow::onAllowCheatsToggled( bool checked )
@@ -3936,7 +4060,7 @@ void MainWindow::onAllowCheatsToggled( bool checked )
 	bool storageModified = STORE_GAMEPLAY_OPTION( .allowCheats, checked );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Gameplay );
 }
 
 void MainWindow::onGameOptsBtnClicked()
@@ -3961,7 +4085,7 @@ void MainWindow::onCompatModeSelected( int compatMode )
 	bool storageModified = STORE_COMPAT_OPTION( .compatMode, compatMode - 1 );  // first item is reserved for indicating no selection
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Compat );
 }
 
 
@@ -4017,7 +4141,7 @@ void MainWindow::onMultiplayerToggled( bool checked )
 	}
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onMultRoleSelected( int multRole )
@@ -4059,7 +4183,7 @@ void MainWindow::onMultRoleSelected( int multRole )
 	}
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onHostChanged( const QString & hostName )
@@ -4067,7 +4191,7 @@ void MainWindow::onHostChanged( const QString & hostName )
 	/*bool storageModified =*/ STORE_MULT_OPTION( .hostName, hostName );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onPortChanged( int port )
@@ -4075,7 +4199,7 @@ void MainWindow::onPortChanged( int port )
 	/*bool storageModified =*/ STORE_MULT_OPTION( .port, uint16_t(port) );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onNetModeSelected( int netMode )
@@ -4083,7 +4207,7 @@ void MainWindow::onNetModeSelected( int netMode )
 	/*bool storageModified =*/ STORE_MULT_OPTION( .netMode, NetMode(netMode) );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onGameModeSelected( int gameMode )
@@ -4105,7 +4229,7 @@ void MainWindow::onGameModeSelected( int gameMode )
 	}
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onPlayerCountChanged( int count )
@@ -4113,7 +4237,7 @@ void MainWindow::onPlayerCountChanged( int count )
 	/*bool storageModified =*/ STORE_MULT_OPTION( .playerCount, uint( count ) );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onTeamDamageChanged( double damage )
@@ -4128,7 +4252,7 @@ void MainWindow::onTeamDamageChanged( double damage )
  #endif
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onTimeLimitChanged( int timeLimit )
@@ -4136,7 +4260,7 @@ void MainWindow::onTimeLimitChanged( int timeLimit )
 	/*bool storageModified =*/ STORE_MULT_OPTION( .timeLimit, uint(timeLimit) );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onFragLimitChanged( int fragLimit )
@@ -4144,7 +4268,7 @@ void MainWindow::onFragLimitChanged( int fragLimit )
 	/*bool storageModified =*/ STORE_MULT_OPTION( .fragLimit, uint(fragLimit) );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onPlayerNameChanged( const QString & name )
@@ -4152,7 +4276,7 @@ void MainWindow::onPlayerNameChanged( const QString & name )
 	/*bool storageModified =*/ STORE_MULT_OPTION( .playerName, name );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 void MainWindow::onPlayerColorResetTriggered()
@@ -4162,7 +4286,7 @@ void MainWindow::onPlayerColorResetTriggered()
 	wdg::restoreButtonColor( ui->playerColorBtn );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Multiplayer );
 }
 
 
@@ -4287,7 +4411,7 @@ void MainWindow::onAltConfigDirChanged( const QString & rebasedDir )
 	updateConfigFilesFromDir();
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::AltDirs | LaunchCmdPart::Config );
 }
 
 void MainWindow::onAltSaveDirChanged( const QString & rebasedDir )
@@ -4316,7 +4440,7 @@ void MainWindow::onAltSaveDirChanged( const QString & rebasedDir )
 	updateSaveFilesFromDir();
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::AltDirs | LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::onAltDemoDirChanged( const QString & rebasedDir )
@@ -4345,7 +4469,7 @@ void MainWindow::onAltDemoDirChanged( const QString & rebasedDir )
 	updateDemoFilesFromDir();
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::AltDirs | LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::onAltScreenshotDirChanged( const QString & rebasedDir )
@@ -4372,7 +4496,7 @@ void MainWindow::onAltScreenshotDirChanged( const QString & rebasedDir )
 	activeScreenshotDir = getActiveScreenshotDir( selectedEngine, rebasedDir );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::AltDirs | LaunchCmdPart::LaunchMode );
 }
 
 void MainWindow::selectAltConfigDir()
@@ -4436,7 +4560,7 @@ void MainWindow::onMonitorSelected( int index )
 	/*bool storageModified =*/ STORE_VIDEO_OPTION( .monitorIdx, index );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Video );
 }
 
 void MainWindow::onResolutionXChanged( const QString & xStr )
@@ -4444,7 +4568,7 @@ void MainWindow::onResolutionXChanged( const QString & xStr )
 	bool storageModified = STORE_VIDEO_OPTION( .resolutionX, xStr.toUInt() );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Video );
 }
 
 void MainWindow::onResolutionYChanged( const QString & yStr )
@@ -4452,7 +4576,7 @@ void MainWindow::onResolutionYChanged( const QString & yStr )
 	bool storageModified = STORE_VIDEO_OPTION( .resolutionY, yStr.toUInt() );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Video );
 }
 
 void MainWindow::onShowFpsToggled( bool checked )
@@ -4460,7 +4584,7 @@ void MainWindow::onShowFpsToggled( bool checked )
 	bool storageModified = STORE_VIDEO_OPTION( .showFPS, checked );
 
 	scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Video );
 }
 
 
@@ -4472,7 +4596,7 @@ void MainWindow::onNoSoundToggled( bool checked )
 	/*bool storageModified =*/ STORE_AUDIO_OPTION( .noSound, checked );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Audio );
 }
 
 void MainWindow::onNoSFXToggled( bool checked )
@@ -4480,7 +4604,7 @@ void MainWindow::onNoSFXToggled( bool checked )
 	/*bool storageModified =*/ STORE_AUDIO_OPTION( .noSFX, checked );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Audio );
 }
 
 void MainWindow::onNoMusicToggled( bool checked )
@@ -4488,7 +4612,56 @@ void MainWindow::onNoMusicToggled( bool checked )
 	/*bool storageModified =*/ STORE_AUDIO_OPTION( .noMusic, checked );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Audio );
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+// process scheduling options
+
+// These are applied to the engine process directly, so they don't appear in the launch command.
+
+void MainWindow::onCpuAffinityChanged( const QString & cpuList )
+{
+	/*bool storageModified =*/ STORE_PRESET_OPTION( .schedulingOpts.cpuAffinity, cpuList.trimmed() );
+
+	//scheduleSavingOptions( storageModified );
+}
+
+void MainWindow::onNiceLevelChanged( int niceLevel )
+{
+	bool storageModified = STORE_PRESET_OPTION( .schedulingOpts.niceLevel, niceLevel );
+
+	scheduleSavingOptions( storageModified );
+}
+
+void MainWindow::onSchedPolicySelected( int policyIdx )
+{
+	if (policyIdx < 0)  // combo-box was reset
+		return;
+
+	bool storageModified = STORE_PRESET_OPTION( .schedulingOpts.schedPolicy, os::SchedPolicy( policyIdx ) );
+
+	scheduleSavingOptions( storageModified );
+}
+
+void MainWindow::onIOPrioClassSelected( int classIdx )
+{
+	if (classIdx < 0)  // combo-box was reset
+		return;
+
+	bool storageModified = STORE_PRESET_OPTION( .schedulingOpts.ioPrioClass, os::IOPrioClass( classIdx ) );
+
+	ui->ioPrioLevelSpinBox->setEnabled( os::IOPrioClass( classIdx ) == os::IOPrioClass::BestEffort );
+
+	scheduleSavingOptions( storageModified );
+}
+
+void MainWindow::onIOPrioLevelChanged( int ioPrioLevel )
+{
+	bool storageModified = STORE_PRESET_OPTION( .schedulingOpts.ioPrioLevel, ioPrioLevel );
+
+	scheduleSavingOptions( storageModified );
 }
 
 
@@ -4647,7 +4820,7 @@ void MainWindow::onPresetCmdArgsChanged( const QString & text )
 	/*bool storageModified =*/ STORE_PRESET_OPTION( .cmdArgs, text );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::CustomArgs );
 }
 
 void MainWindow::onGlobalCmdArgsChanged( const QString & text )
@@ -4655,7 +4828,7 @@ void MainWindow::onGlobalCmdArgsChanged( const QString & text )
 	/*bool storageModified =*/ STORE_GLOBAL_OPTION( .cmdArgs, text );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::CustomArgs );
 }
 
 void MainWindow::onCmdPrefixChanged( const QString & text )
@@ -4663,7 +4836,7 @@ void MainWindow::onCmdPrefixChanged( const QString & text )
 	/*bool storageModified =*/ STORE_GLOBAL_OPTION( .cmdPrefix, text );
 
 	//scheduleSavingOptions( storageModified );
-	updateLaunchCommand();
+	updateLaunchCommand( LaunchCmdPart::Engine );
 }
 
 void MainWindow::onLaunchBtnClicked()
@@ -4696,9 +4869,12 @@ void MainWindow::togglePathStyle( PathStyle style )
 	mapSettings.dir = pathConvertor.convertPath( mapSettings.dir );
 	mapModel.setRootPath( mapSettings.dir );
 
-	for (Mod & mod : modModel)
+	if (!modModel.isBound())  // otherwise it's the list of the selected preset, which is converted below
 	{
-		mod.path = pathConvertor.convertPath( mod.path );
+		for (Mod & mod : modModel)
+		{
+			mod.path = pathConvertor.convertPath( mod.path );
+		}
 	}
 
 	for (Preset & preset : presetModel)
@@ -4772,7 +4948,7 @@ void MainWindow::updateIWADsFromDir()
 	if (!iwadSettings.defaultIWAD.isEmpty())
 	{
 		// the default item marking was lost during the update, mark it again
-		int defaultIdx = findSuch( iwadModel, [&]( const IWAD & i ){ return i.getID() == iwadSettings.defaultIWAD; } );
+		int defaultIdx = int( iwadModel.findIndexByID( iwadSettings.defaultIWAD ) );
 		if (defaultIdx >= 0)
 			markItemAsDefault( iwadModel[ defaultIdx ] );
 	}
@@ -4787,11 +4963,11 @@ void MainWindow::updateIWADsFromDir()
 	}
 }
 
-/** NOTE: The content of the model is updated asynchronously (in a separate thread)
-  * so it will most likely not be ready yet when this function returns. */
+/** NOTE: The top-level entries are read right away, but the directoryLoaded notification and the information
+  * read from the WADs come asynchronously, so they will not be ready yet when this function returns. */
 void MainWindow::resetMapDirModelAndView()
 {
-	// We use QFileSystemModel which updates the data from directory automatically.
+	// The MapPackTreeModel updates the data from directory automatically.
 	// But when the directory is changed, the model and view needs to be reset.
 	QModelIndex newRootIdx = mapModel.setRootPath( mapSettings.dir );
 	ui->mapDirView->setRootIndex( newRootIdx );
@@ -5016,6 +5192,9 @@ void MainWindow::exportPresetToScript()
 		return;  // no point in generating a command if we don't even know the engine, it determines everything
 	}
 
+	// don't leave the displayed command behind the one that is being used
+	flushLaunchCommandUpdate();
+
 	QString scriptFilePath = DialogWithPaths::selectDestFile( this, "Export preset", emptyString,
 		makeFileFilter( "Shell script files", { os::scriptFileSuffix } )
 		+ "All files (*)"
@@ -5056,6 +5235,17 @@ void MainWindow::exportPresetToScript()
 		stream << "cd '"%fs::toNativePath( engineExeDir )%"'" << '\n';
 	}
 
+	// The launcher applies the scheduling options natively, the script has to use the command line tools for it.
+	QStringList schedulingPrefix;
+	if (os::canSetProcessScheduling())
+	{
+		schedulingPrefix = os::getSchedulingCommandPrefix( selectedPreset->schedulingOpts );
+	}
+	if (!schedulingPrefix.isEmpty())
+	{
+		stream << schedulingPrefix.join(' ') << " ";
+	}
+
 	stream << cmd.executable << " " << cmd.arguments.join(' ') << '\n';
 
 	scriptFile.close();
@@ -5076,6 +5266,9 @@ void MainWindow::exportPresetToShortcut()
 		return;  // no point in generating a command if we don't even know the engine, it determines everything
 	}
 
+	// don't leave the displayed command behind the one that is being used
+	flushLaunchCommandUpdate();
+
 	QString shortcutPath = DialogWithPaths::selectDestFile( this, "Export preset", emptyString,
 		makeFileFilter( "Windows file shortcuts", { os::shortcutFileSuffix } )
 		+ "All files (*)"
@@ -5124,377 +5317,244 @@ void MainWindow::importPresetFromScript()
 //----------------------------------------------------------------------------------------------------------------------
 // launch command generation
 
-static void appendCustomArguments( QStringList & args, const QString & customArgsStr, bool quotePaths )
+// Collects the data that the requested parts of the launch command are generated from.
+// Some of them are expensive to get (directories for the sandbox), so only the requested ones are collected.
+LaunchCommandInput MainWindow::gatherLaunchCommandInput( LaunchCmdParts parts )
 {
-	auto splitArgs = splitCommandLineArguments( customArgsStr );
-	for (auto & arg : splitArgs)
-	{
-		if (quotePaths && arg.wasQuoted)
-			args << quoted( arg.str );
-		else
-			args << std::move( arg.str );
-	}
-};
-
-static void prependCommandWith( os::ShellCommand & cmd, const QString & cmdPrefix, bool quotePaths )
-{
-	QStringList cmdParts;
-	appendCustomArguments( cmdParts, cmdPrefix, quotePaths );
-	cmdParts << std::move( cmd.executable );
-	cmdParts << std::move( cmd.arguments );
-
-	cmd.executable = cmdParts.takeFirst();
-	cmd.arguments = std::move( cmdParts );
-}
-
-os::ShellCommand MainWindow::generateLaunchCommand( LaunchCommandOptions opts )
-{
-	os::ShellCommand cmd;
-
-	const EngineInfo & engine = opts.selectedEngine;  // let's make it little shorter
+	LaunchCommandInput input;
 
-	const QString currentWorkingDir = pathConvertor.workingDir().path();
-	const QString engineExeDir = fs::getAbsoluteParentDir( engine.executablePath );
+	input.workingDir = pathConvertor.workingDir().path();
 
-	// The stored engine path is relative to DoomRunner's directory, but we need it relative to runnersWorkingDir.
-	PathRebaser runnersDirRebaser( currentWorkingDir, opts.runnersWorkingDir, opts.quotePaths );
-	runnersDirRebaser.setRequiredPathStyle( opts.exePathStyle );
-	// All stored paths are relative to DoomRunner's directory, but we need them relative to to the engine's executable
-	// directory, because the engine must be started with the working directory set to its executable directory.
-	PathRebaser runDirRebaser( currentWorkingDir, engineExeDir, opts.quotePaths );
-	if (engine.requiresAbsolutePaths())
-		runDirRebaser.enforceAbsolutePaths();
-	// Checks if the required files or directories exist and displays error message if requested.
-	PathChecker p( this, opts.verifyPaths );
-
-	QString cmdPrefixStr = ui->cmdPrefixLine->text();
-
-	//-- engine --------------------------------------------------------------------
-
-	p.checkItemFilePath( engine, "the selected engine", "Please update its path in Menu -> Initial Setup, or select another one." );
-
-	// get the beginning of the launch command based on OS and installation type
-	cmd = os::getRunCommand( engine.executablePath, runnersDirRebaser, !cmdPrefixStr.isEmpty(), getDirsToBeAccessed() );
-
-	//-- command prefix ------------------------------------------------------------
-
-	if (!cmdPrefixStr.isEmpty())
+	if (isFlagSet( parts, LaunchCmdPart::Engine ))
 	{
-		prependCommandWith( cmd, cmdPrefixStr, opts.quotePaths );
+		input.cmdPrefix = ui->cmdPrefixLine->text();
+		input.dirsToBeAccessed = getDirsToBeAccessed();
 	}
 
-	//-- engine's config -----------------------------------------------------------
-
-	if (selectedConfig)
+	if (isFlagSet( parts, LaunchCmdPart::Config ) && selectedConfig)
 	{
 		// at this point the configDir cannot be empty, otherwise the configCmbBox would be empty and there would not be any selected config
-		QString configPath = fs::getPathFromFileName( activeConfigDir, selectedConfig->fileName );
+		input.configFilePath = fs::getPathFromFileName( activeConfigDir, selectedConfig->fileName );
+	}
 
-		p.checkFilePath( configPath, "the selected config", "Please update the config dir in Menu -> Initial Setup, or select another one." );
-		cmd.arguments << "-config" << runDirRebaser.makeRequiredCmdPath( configPath );
+	if (isFlagSet( parts, LaunchCmdPart::IWAD ))
+	{
+		input.iwad = selectedIWAD;
 	}
 
-	//-- game data files -----------------------------------------------------------
+	if (isFlagSet( parts, LaunchCmdPart::Files ))
+	{
+		input.selectedMapPacks = selectedMapPacks;
+		input.mods = &modModel.list();
+		input.loadMapsAfterMods = ui->mapsAfterModsChkBox->isChecked();
+	}
 
-	// IWAD
-	if (selectedIWAD)
+	if (isFlagSet( parts, LaunchCmdPart::AltDirs ))
 	{
-		p.checkItemFilePath( *selectedIWAD, "selected IWAD", "Please select another one." );
-		cmd.arguments << "-iwad" << runDirRebaser.makeRequiredCmdPath( selectedIWAD->path );
+		if (!ui->altSaveDirLine->text().isEmpty())
+			input.altSaveDir = activeSaveDir;  // rebased altSaveDirLine, keeps the path style of engine's data dir
+		if (!ui->altScreenshotDirLine->text().isEmpty())
+			input.altScreenshotDir = activeScreenshotDir;  // rebased altScreenshotDirLine, keeps the path style of engine's data dir
 	}
 
-	// This part is tricky.
-	// Older engines only accept single -file parameter, so all the regular map/mod files must be listed together.
-	// But the user is allowed to intersperse the regular files with deh/bex files or custom cmd arguments.
-	// So we must somehow build an ordered sequence of mod files and custom arguments in which all the regular files are
-	// grouped together, and the easiest option seems to be by using a placeholder item.
+	// the launch mode also determines which gameplay and compatibility options can be used
+	if (isAnyOfFlagsSet( parts, LaunchCmdPart::LaunchMode | LaunchCmdPart::Gameplay | LaunchCmdPart::Compat ))
 	{
-		/// Command line arguments constructed from the selected map files and the entries in the mod files list.
-		/** Contains placeholder for the -file list until the last phase. */
-		QStringList fileArgs;
-		bool placeholderPlaced = false;
+		input.launchOpts.mode = getLaunchModeFromUI();
+	}
 
-		auto addFileAccordingToSuffix = [&]( QStringList & fileList, const QString & filePath )
-		{
-			QString suffix = QFileInfo( filePath ).suffix().toLower();
-			// dehacked files are special, they go directly into the arguments with a different command line option
-			if (suffix == "deh" || suffix == "hhe") {
-				fileArgs << "-deh" << runDirRebaser.makeRequiredCmdPath( filePath );
-			} else if (suffix == "bex") {
-				fileArgs << "-bex" << runDirRebaser.makeRequiredCmdPath( filePath );
-			} else {
-				// for now, only insert a placeholder where all the files will be inserted later together
-				if (!placeholderPlaced) {
-					fileArgs << "-file" << "<files>";
-					placeholderPlaced = true;
-				}
-				// and gather the files in a separate list
-				fileList.append( runDirRebaser.makeRequiredCmdPath( filePath ) );
-			}
-		};
+	if (isFlagSet( parts, LaunchCmdPart::LaunchMode ))
+	{
+		LaunchOptions & launchOpts = input.launchOpts;
+		launchOpts.mapName = ui->mapCmbBox->currentText();
+		launchOpts.saveFile = ui->saveFileCmbBox->currentText();
+		launchOpts.mapName_demo = ui->mapCmbBox_demo->currentText();
+		launchOpts.demoFile_record = ui->demoFileLine_record->text();
+		launchOpts.demoFile_replay = ui->demoFileCmbBox_replay->currentText();
+		launchOpts.demoFile_resumeFrom = ui->demoFileCmbBox_resume->currentText();
+		launchOpts.demoFile_resumeTo = ui->demoFileLine_resume->text();
+		input.mapIdx = ui->mapCmbBox->currentIndex();
+		input.mapIdx_demo = ui->mapCmbBox_demo->currentIndex();
+		input.saveDir = activeSaveDir;
+		input.demoDir = activeDemoDir;
+	}
 
-		/// Postponed map files that will be inserted together into the -file list.
-		QStringList mapFiles;
-		forEachSelectedMapFileWithExpandedDMBs( [&]( const QString & mapFilePath )
-		{
-			p.checkAnyPath( mapFilePath, "the selected map pack", "Please select another one." );
-			addFileAccordingToSuffix( mapFiles, mapFilePath );
-		});
+	if (isFlagSet( parts, LaunchCmdPart::Gameplay ))
+	{
+		GameplayOptions & gameOpts = input.gameOpts;
+		gameOpts = activeGameplayOptions();  // dmflags are edited in a dialog, they're only stored
+		gameOpts.skillNum = ui->skillSpinBox->value();
+		gameOpts.noMonsters = ui->noMonstersChkBox->isChecked();
+		gameOpts.fastMonsters = ui->fastMonstersChkBox->isChecked();
+		gameOpts.monstersRespawn = ui->monstersRespawnChkBox->isChecked();
+		gameOpts.pistolStart = ui->pistolStartChkBox->isChecked();
+		gameOpts.allowCheats = ui->allowCheatsChkBox->isChecked();
+	}
 
-		/// Postponed mod files that will be inserted together into the -file list.
-		QStringList modFiles;
-		forEachCheckedModFileWithExpandedDMBs( [&]( const Mod & mod )
-		{
-			if (mod.isCmdArg) {  // this is not a file but a custom command line argument, append it directly to the arguments
-				appendCustomArguments( fileArgs, mod.name, opts.quotePaths );
-			} else {
-				p.checkItemAnyPath( mod, "the selected mod", "Please update the mod list." );
-				addFileAccordingToSuffix( modFiles, mod.path );
-			}
-		});
+	if (isFlagSet( parts, LaunchCmdPart::Compat ))
+	{
+		input.compatOpts = activeCompatOptions();
+		input.compatOptsCmdArgs = compatOptsCmdArgs;
+	}
 
-		// output the final sequence to the cmd.arguments
-		for (QString & argument : fileArgs)
-		{
-			if (argument == "<files>")
-			{
-				// replace the placeholder with the actual list
-				if (ui->mapsAfterModsChkBox->isChecked()) {
-					cmd.arguments << std::move( modFiles );
-					cmd.arguments << std::move( mapFiles );
-				} else {
-					cmd.arguments << std::move( mapFiles );
-					cmd.arguments << std::move( modFiles );
-				}
-			}
-			else
-			{
-				cmd.arguments << std::move( argument );
-			}
-		}
+	if (isFlagSet( parts, LaunchCmdPart::Multiplayer ))
+	{
+		MultiplayerOptions & multOpts = input.multOpts;
+		multOpts = activeMultiplayerOptions();  // player color is chosen in a dialog, it's only stored
+		multOpts.isMultiplayer = ui->multiplayerGrpBox->isEnabled() && ui->multiplayerGrpBox->isChecked();
+		multOpts.multRole = MultRole( ui->multRoleCmbBox->currentIndex() );
+		multOpts.hostName = ui->hostnameLine->text();
+		multOpts.port = uint16_t( ui->portSpinBox->value() );
+		multOpts.netMode = NetMode( ui->netModeCmbBox->currentIndex() );
+		multOpts.gameMode = GameMode( ui->gameModeCmbBox->currentIndex() );
+		multOpts.playerCount = uint( ui->playerCountSpinBox->value() );
+		multOpts.teamDamage = ui->teamDmgSpinBox->value();
+		multOpts.timeLimit = uint( ui->timeLimitSpinBox->value() );
+		multOpts.fragLimit = uint( ui->fragLimitSpinBox->value() );
+		multOpts.playerName = ui->playerNameLine->text();
 	}
 
-	//-- alternative directories ---------------------------------------------------
-	// Rather set them before the launch parameters, because some of the parameters
-	// (e.g. -loadgame) can be relative to these alternative directories.
+	if (isFlagSet( parts, LaunchCmdPart::Video ))
+	{
+		VideoOptions & videoOpts = input.videoOpts;
+		videoOpts.monitorIdx = ui->monitorCmbBox->currentIndex();
+		videoOpts.resolutionX = ui->resolutionXLine->text().toUInt();
+		videoOpts.resolutionY = ui->resolutionYLine->text().toUInt();
+		videoOpts.showFPS = ui->showFpsChkBox->isChecked();
+		input.showEngineOutput = settings.showEngineOutput;
+	}
 
-	// Do not use -savedir or -shotdir for engines that don't support it,
-	// some of them are bitchy and won't start if you supply them with unknown command line parameter.
-	if (engine.saveDirParam() != nullptr && !ui->altSaveDirLine->text().isEmpty())
+	if (isFlagSet( parts, LaunchCmdPart::Audio ))
 	{
-		const QString & saveDirPath = activeSaveDir;  // rebased altSaveDirLine, keeps the path style of engine's data dir
-		p.checkLineDirPath( saveDirPath, ui->altSaveDirLine, "the save dir", {} );
-		cmd.arguments << engine.saveDirParam() << runDirRebaser.makeRequiredCmdPath( saveDirPath );
+		AudioOptions & audioOpts = input.audioOpts;
+		audioOpts.noSound = ui->noSoundChkBox->isChecked();
+		audioOpts.noSFX = ui->noSfxChkBox->isChecked();
+		audioOpts.noMusic = ui->noMusicChkBox->isChecked();
 	}
-	if (engine.screenshotDirParam() != nullptr && !ui->altScreenshotDirLine->text().isEmpty())
+
+	if (isFlagSet( parts, LaunchCmdPart::CustomArgs ))
 	{
-		const QString & screenshotDirPath = activeScreenshotDir;  // rebased altScreenshotDirLine, keeps the path style of engine's data dir
-		p.checkLineDirPath( screenshotDirPath, ui->altScreenshotDirLine, "the screenshot dir", {} );
-		cmd.arguments << engine.screenshotDirParam() << runDirRebaser.makeRequiredCmdPath( screenshotDirPath );
+		input.globalCmdArgs = ui->globalCmdArgsLine->text();
+		input.presetCmdArgs = ui->presetCmdArgsLine->text();
 	}
 
-	//-- launch mode and parameters ------------------------------------------------
-	// Beware that while -record and -playdemo are either absolute or relative to the current working dir
-	// -loadgame might need to be relative to -savedir, depending on the engine and its version
+	return input;
+}
 
-	LaunchMode launchMode = getLaunchModeFromUI();
-	if (launchMode == LaunchMap)
-	{
-		cmd.arguments << engine.getMapArgs( ui->mapCmbBox->currentIndex(), ui->mapCmbBox->currentText() );
-	}
-	else if (launchMode == LoadSave && !ui->saveFileCmbBox->currentText().isEmpty())
-	{
-		// save dir cannot be empty, otherwise the saveFileCmbBox would be empty
-		const QString & saveDir = activeSaveDir;
-		QString saveFileName = ui->saveFileCmbBox->currentText();
-		QString saveFilePath = fs::getPathFromFileName( saveDir, saveFileName );
-		p.checkFilePath( saveFilePath, "the selected save file", "Please select another one." );
-		cmd.arguments << engine.getLoadSavedGameArgs( runDirRebaser, saveDir, saveFileName );
-	}
-	else if (launchMode == RecordDemo && !ui->demoFileLine_record->text().isEmpty())
-	{
-		// if demo dir is empty (demoDirLine is empty and engine.dataDir is not set), then the demoFileLine_record will be used as is
-		const QString & demoDir = activeDemoDir;
-		QString demoFileName = fs::ensureFileSuffix( ui->demoFileLine_record->text(), doom::demoFileSuffix );
-		QString demoFilePath = fs::getPathFromFileName( demoDir, demoFileName );
-		p.checkOverwrite( demoFilePath, "the specified demo file", "Please select another one." );
-		cmd.arguments << "-record" << runDirRebaser.makeRequiredCmdPath( demoFilePath );
-		cmd.arguments << engine.getMapArgs( ui->mapCmbBox_demo->currentIndex(), ui->mapCmbBox_demo->currentText() );
-	}
-	else if (launchMode == ReplayDemo && !ui->demoFileCmbBox_replay->currentText().isEmpty())
-	{
-		// demo dir cannot be empty, otherwise the demoFileCmbBox_replay would be empty
-		const QString & demoDir = activeDemoDir;
-		QString demoFileName = ui->demoFileCmbBox_replay->currentText();
-		QString demoFilePath = fs::getPathFromFileName( demoDir, demoFileName );
-		p.checkFilePath( demoFilePath, "the selected demo file", "Please select another one." );
-		cmd.arguments << "-playdemo" << runDirRebaser.makeRequiredCmdPath( demoFilePath );
-	}
-	else if (launchMode == ResumeDemo
-	      && !ui->demoFileCmbBox_resume->currentText().isEmpty() && !ui->demoFileLine_resume->text().isEmpty())
-	{
-		const QString & demoDir = activeDemoDir;  // demo dir cannot be empty, otherwise the demoFileCmbBox_resume would be empty
-		QString origDemoPath = fs::getPathFromFileName( demoDir, ui->demoFileCmbBox_resume->currentText() );
-		QString destDemoPath = fs::getPathFromFileName( demoDir, fs::ensureFileSuffix( ui->demoFileLine_resume->text(), doom::demoFileSuffix ) );
-		p.checkFilePath( origDemoPath, "the original demo file", "Please select another one." );
-		p.checkOverwrite( destDemoPath, "the destination demo file", "Please select another one." );
-		cmd.arguments << "-recordfromto"
-			<< runDirRebaser.makeRequiredCmdPath( origDemoPath ) << runDirRebaser.makeRequiredCmdPath( destDemoPath );
-	}
-
-	//-- gameplay and compatibility options ----------------------------------------
-	// These widgets are enabled only if the corresponding command line options are supported by the engine.
-
-	const GameplayOptions & activeGameOpts = activeGameplayOptions();
-	if (ui->skillCmbBox->isEnabled())
-		cmd.arguments << "-skill" << ui->skillSpinBox->text();
-	if (ui->noMonstersChkBox->isEnabled() && ui->noMonstersChkBox->isChecked())
-		cmd.arguments << "-nomonsters";
-	if (ui->fastMonstersChkBox->isEnabled() && ui->fastMonstersChkBox->isChecked())
-		cmd.arguments << "-fast";
-	if (ui->monstersRespawnChkBox->isEnabled() && ui->monstersRespawnChkBox->isChecked())
-		cmd.arguments << "-respawn";
-	if (ui->pistolStartChkBox->isEnabled() && ui->pistolStartChkBox->isChecked())
-		cmd.arguments << engine.pistolStartOption();
-	if (ui->allowCheatsChkBox->isEnabled() && ui->allowCheatsChkBox->isChecked())
-		cmd.arguments << engine.allowCheatsArgs();
-	if (ui->gameOptsBtn->isEnabled() && activeGameOpts.dmflags1 != 0)
-		cmd.arguments << "+dmflags" << QString::number( activeGameOpts.dmflags1 );
-	if (ui->gameOptsBtn->isEnabled() && activeGameOpts.dmflags2 != 0)
-		cmd.arguments << "+dmflags2" << QString::number( activeGameOpts.dmflags2 );
-	if (ui->gameOptsBtn->isEnabled() && activeGameOpts.dmflags3 != 0)
-		cmd.arguments << "+dmflags3" << QString::number( activeGameOpts.dmflags3 );
-
-	const CompatibilityOptions & activeCompatOpts = activeCompatOptions();
-	if (ui->compatModeCmbBox->isEnabled() && activeCompatOpts.compatMode >= 0)
-		cmd.arguments << engine.getCompatModeArgs( activeCompatOpts.compatMode );
-	if (ui->compatOptsBtn->isEnabled() && !compatOptsCmdArgs.isEmpty())
-		cmd.arguments << compatOptsCmdArgs;
-
-	//-- multiplayer options -------------------------------------------------------
-
-	if (ui->multiplayerGrpBox->isEnabled() && ui->multiplayerGrpBox->isChecked())
-	{
-		const MultiplayerOptions & activeMultOpts = activeMultiplayerOptions();
-
-		switch (ui->multRoleCmbBox->currentIndex())
+os::ShellCommand MainWindow::generateLaunchCommand( const LaunchCommandOptions & opts )
+{
+	LaunchCommandBuilder builder( opts );
+	LaunchCmdReport report;
+	auto cmd = builder.generate( gatherLaunchCommandInput( LaunchCmdPart::All ), report );
+	if (!handleLaunchCmdReport( report ))
+		return {};
+	return cmd;
+}
+
+// Presents the problems found by the LaunchCommandBuilder to the user.
+// Returns false if the command must not be used.
+bool MainWindow::handleLaunchCmdReport( const LaunchCmdReport & report )
+{
+	// The alternative dirs are not list items, their paths need to be matched back to the lines they came from.
+	auto forEachLineOfAltDir = [this]( const QString & path, void (* func)( QLineEdit * ) )
+	{
+		if (!ui->altSaveDirLine->text().isEmpty() && path == activeSaveDir)
+			func( ui->altSaveDirLine );
+		if (!ui->altScreenshotDirLine->text().isEmpty() && path == activeScreenshotDir)
+			func( ui->altScreenshotDirLine );
+	};
+
+	for (const AModelItem * item : report.verifiedItems)
+		unhighlightListItem( *item );
+	for (const QString & path : report.verifiedPaths)
+		forEachLineOfAltDir( path, unhighlightPathLine );
+
+	const LaunchCmdIssue * firstInvalidPath = nullptr;
+	for (const LaunchCmdIssue & issue : report.issues)
+	{
+		if (issue.type == LaunchCmdIssue::InvalidInput)
 		{
-		 case MultRole::Server:
-			if (engine.multHostParam())
-				cmd.arguments << engine.multHostParam();
-			if (engine.multPlayerCountParam() && ui->playerCountSpinBox->isEnabled())
-				cmd.arguments << engine.multPlayerCountParam() << ui->playerCountSpinBox->text();
-			if (ui->portSpinBox->value() != 5029)
-				cmd.arguments << "-port" << ui->portSpinBox->text();
-			if (ui->netModeCmbBox->isEnabled())
-				cmd.arguments << "-netmode" << QString::number( ui->netModeCmbBox->currentIndex() );
-			switch (ui->gameModeCmbBox->currentIndex())
-			{
-			 case Deathmatch:
-				cmd.arguments << "-deathmatch";
-				break;
-			 case TeamDeathmatch:
-				cmd.arguments << "-deathmatch" << "+teamplay";
-				break;
-			 case AltDeathmatch:
-				cmd.arguments << "-altdeath";
-				break;
-			 case AltTeamDeathmatch:
-				cmd.arguments << "-altdeath" << "+teamplay";
-				break;
-			 case Deathmatch3:
-				cmd.arguments << "-dm3";
-				break;
-			 case Cooperative: // default mode, which is started without any param
-				break;
-			 default:
-				reportLogicError( u"generateLaunchCommand", "Invalid game mode index", "The game mode index is out of range." );
-			}
-			if (ui->teamDmgSpinBox->value() != 0.0)
-				cmd.arguments << "+teamdamage" << QString::number( ui->teamDmgSpinBox->value(), 'f', 2 );
-			if (ui->timeLimitSpinBox->value() != 0)
-				cmd.arguments << "-timer" << ui->timeLimitSpinBox->text();
-			if (ui->fragLimitSpinBox->value() != 0)
-				cmd.arguments << "+fraglimit" << ui->fragLimitSpinBox->text();
-			break;
-		 case MultRole::Client:
-			if (!engine.multJoinParam())
-			{
-				reportLogicError( u"generateLaunchCommand", "Multiplayer join parameter is null",
-					"The multiplayer join parameter is not set. The multiplayer group-box should have been disabled."
-				);
-				break;
-			}
-			cmd.arguments << engine.multJoinParam() << ui->hostnameLine->text() % ":" % ui->portSpinBox->text();
-			break;
-		 default:
-			reportLogicError( u"generateLaunchCommand", "Invalid multiplayer role index", "The multiplayer role index is out of range." );
+			reportLogicError( u"generateLaunchCommand", issue.title, issue.message );
 		}
-
-		if (ui->playerNameLine->isEnabled() && !ui->playerNameLine->text().isEmpty())
+		else if (issue.type == LaunchCmdIssue::InvalidPath)
 		{
-			cmd.arguments << "+name" << ui->playerNameLine->text();
-
-			if (activeMultOpts.playerColor.isValid())
+			if (issue.item)
+				highlightListItemAsInvalid( *issue.item );
+			else
+				forEachLineOfAltDir( issue.path, highlightPathLineAsInvalid );
+			if (!firstInvalidPath)
+				firstInvalidPath = &issue;
+		}
+		else if (issue.type == LaunchCmdIssue::BundleCycle)
+		{
+			// The command is regenerated after every change, tell the user about each cycle only once.
+			if (!reportedBundleCycles.contains( issue.message ))
 			{
-				QString colorArg = QStringLiteral("%1 %2 %3")
-				                   .arg( activeMultOpts.playerColor.red(),   1, 16 )
-				                   .arg( activeMultOpts.playerColor.green(), 1, 16 )
-				                   .arg( activeMultOpts.playerColor.blue(),  1, 16 );
-				cmd.arguments << "+color" << runDirRebaser.maybeQuoted( colorArg );
+				reportedBundleCycles.insert( issue.message );
+				reportUserError( issue.title, issue.message );
 			}
 		}
 	}
 
-	//-- output options ------------------------------------------------------------
-
-	// On Windows, ZDoom doesn't log its output to stdout by default.
-	// Force it to do so, so that our ProcessOutputWindow displays something.
-	if (settings.showEngineOutput && engine.needsStdoutParam())
-		cmd.arguments << "-stdout";
-
-	// video options
-	if (ui->monitorCmbBox->isEnabled() && ui->monitorCmbBox->currentIndex() > 0)
+	if (firstInvalidPath)
 	{
-		int monitorIndex = ui->monitorCmbBox->currentIndex() - 1;  // the first item is a placeholder for leaving it default
-		cmd.arguments << "+vid_adapter" << engine.getCmdMonitorIndex( monitorIndex );  // some engines index monitors from 1 and others from 0
+		// don't spam too many errors when something goes wrong
+		reportUserError( firstInvalidPath->title, firstInvalidPath->message );
+		return false;
 	}
-	if (ui->resolutionXLine->isEnabled() && !ui->resolutionXLine->text().isEmpty())
-		cmd.arguments << "-width" << ui->resolutionXLine->text();
-	if (ui->resolutionYLine->isEnabled() && !ui->resolutionYLine->text().isEmpty())
-		cmd.arguments << "-height" << ui->resolutionYLine->text();
-	if (ui->showFpsChkBox->isEnabled() && ui->showFpsChkBox->isChecked())
-		cmd.arguments << "+vid_fps" << "1";
 
-	// audio options
-	if (ui->noSoundChkBox->isEnabled() && ui->noSoundChkBox->isChecked())
-		cmd.arguments << "-nosound";
-	if (ui->noSfxChkBox->isEnabled() && ui->noSfxChkBox->isChecked())
-		cmd.arguments << "-nosfx";
-	if (ui->noMusicChkBox->isEnabled() && ui->noMusicChkBox->isChecked())
-		cmd.arguments << "-nomusic";
-
-	//-- additional custom command line arguments ----------------------------------
+	for (const LaunchCmdIssue & issue : report.issues)
+	{
+		if (issue.type == LaunchCmdIssue::FileExists)
+		{
+			auto answer = QMessageBox::question( this, issue.title, issue.message, QMessageBox::Yes | QMessageBox::No );
+			if (answer != QMessageBox::Yes)
+				return false;
+		}
+	}
 
-	if (!ui->globalCmdArgsLine->text().isEmpty())
-		appendCustomArguments( cmd.arguments, ui->globalCmdArgsLine->text(), opts.quotePaths );
+	return true;
+}
 
-	if (!ui->presetCmdArgsLine->text().isEmpty())
-		appendCustomArguments( cmd.arguments, ui->presetCmdArgsLine->text(), opts.quotePaths );
+// Large IWADs and mods on a spinning disk or a network drive can delay the engine's start-up by seconds,
+// so if the user wishes, we let the OS load them into its cache in background before the engine needs them.
+void MainWindow::warmUpGameFiles()
+{
+	gameFilesWarmUpTimer.stop();  // when called at the launch, the delayed warm-up is no longer needed
 
-	//------------------------------------------------------------------------------
+	if (!settings.warmUpGameFiles)
+		return;
 
-	return !p.gotSomeInvalidPaths() ? cmd : os::ShellCommand{};
+	gameFilesWarmer.warmUp( LaunchCommandBuilder::getGameFilePaths( gatherLaunchCommandInput( LaunchCmdPart::IWAD | LaunchCmdPart::Files ) ) );
 }
 
-void MainWindow::updateLaunchCommand()
+void MainWindow::updateLaunchCommand( LaunchCmdParts changedParts )
 {
+	dirtyLaunchCmdParts |= changedParts;
+
 	// optimization: don't regenerate the command when we're about to make more changes right away
 	if (restoringOptionsInProgress || restoringPresetInProgress)
 		return;
 
-	//static uint callCnt = 1;
-	//logDebug() << "updateLaunchCommand() " << callCnt++;
+	// The command is regenerated once after the burst of changes settles down, not on every keystroke.
+	launchCmdUpdateStats.requested++;
+	if (!launchCmdUpdateTimer.isActive())
+		launchCmdUpdateTimer.start();
+}
+
+void MainWindow::flushLaunchCommandUpdate()
+{
+	launchCmdUpdateTimer.stop();
+
+	if (restoringOptionsInProgress || restoringPresetInProgress)
+		return;  // will be scheduled again when the restoring is finished
+
+	if (dirtyLaunchCmdParts == LaunchCmdPart::None)
+		return;  // the displayed command is up to date
+
+	launchCmdUpdateStats.performed++;
+	logDebug() << "launch command regenerated " << launchCmdUpdateStats.performed << " times for "
+	           << launchCmdUpdateStats.requested << " requests, avoided " << launchCmdUpdateStats.avoided();
 
 	if (!selectedEngine)
 	{
@@ -5502,6 +5562,14 @@ void MainWindow::updateLaunchCommand()
 		return;  // no point in generating a command if we don't even know the engine, it determines everything
 	}
 
+	// The save and demo file paths of the launch mode are resolved against the alternative save and demo dirs.
+	if (isFlagSet( dirtyLaunchCmdParts, LaunchCmdPart::AltDirs ))
+		dirtyLaunchCmdParts |= LaunchCmdPart::LaunchMode;
+
+	// The sandboxed engines get access to the directories of all the files and data dirs used in the command.
+	if (isAnyOfFlagsSet( dirtyLaunchCmdParts, LaunchCmdPart::IWAD | LaunchCmdPart::Files | LaunchCmdPart::AltDirs | LaunchCmdPart::Config | LaunchCmdPart::LaunchMode ))
+		dirtyLaunchCmdParts |= LaunchCmdPart::Engine;
+
 	QString currentCommand = ui->commandLine->text();
 
 	QString engineExeDir = fs::getAbsoluteParentDir( selectedEngine->executablePath );
@@ -5509,13 +5577,21 @@ void MainWindow::updateLaunchCommand()
 	// because some engines refuse to start or don't work properly when the working dir is not their executable dir.
 
 	// The relative path of the executable does not matter, because here it is for displaying only.
-	auto cmd = generateLaunchCommand({
+	LaunchCommandOptions cmdOpts = {
 		.selectedEngine = *selectedEngine,
 		.exePathStyle = PathStyle::Relative,
 		.runnersWorkingDir = engineExeDir,
 		.quotePaths = true,
 		.verifyPaths = false,
-	});
+	};
+	// Only the parts whose data have changed since the last time are regenerated, the rest is reused.
+	LaunchCommandBuilder builder( cmdOpts );
+	LaunchCmdReport report;
+	builder.generateParts( gatherLaunchCommandInput( dirtyLaunchCmdParts ), dirtyLaunchCmdParts, displayedLaunchCmd, report );
+	handleLaunchCmdReport( report );  // the paths are not verified here, this can only report bugs or bundle cycles
+	dirtyLaunchCmdParts = LaunchCmdPart::None;
+
+	auto cmd = LaunchCommandBuilder::joinParts( displayedLaunchCmd );
 
 	QString newCommand = cmd.executable % ' ' % cmd.arguments.join(' ');
 
@@ -5584,6 +5660,9 @@ void MainWindow::executeLaunchCommand()
 		return;  // no point in generating a command if we don't even know the engine, it determines everything
 	}
 
+	// don't leave the displayed command behind the one that is being used
+	flushLaunchCommandUpdate();
+
 	QString currentWorkingDir = pathConvertor.workingDir().path();
 	QString engineExeDir = fs::getAbsoluteParentDir( selectedEngine->executablePath );
 
@@ -5607,6 +5686,7 @@ void MainWindow::executeLaunchCommand()
 		.runnersWorkingDir = currentWorkingDir,
 		.quotePaths = false,
 		.verifyPaths = true,
+		.pathStatusMemo = &pathChecker,
 	});
 
 	if (cmd.executable.isNull())
@@ -5614,6 +5694,9 @@ void MainWindow::executeLaunchCommand()
 		return;  // errors are already shown during the generation
 	}
 
+	// The files might have changed since the preset was selected, the ones that are already warmed up are skipped.
+	warmUpGameFiles();
+
 	// If extra permissions are needed to run the engine inside its sandbox environment, better ask the user.
 	if (settings.askForSandboxPermissions && !cmd.extraPermissions.isEmpty())
 	{
@@ -5635,16 +5718,26 @@ void MainWindow::executeLaunchCommand()
 	EnvVars envVars = globalOpts.envVars;
 	envVars += selectedPreset->envVars;
 
+	// the options might have been loaded from a file created on a different system
+	os::ProcessScheduling scheduling;
+	if (os::canSetProcessScheduling())
+	{
+		scheduling = selectedPreset->schedulingOpts;
+	}
+
+	// record how long it takes to start and how long it runs, so that regressions after updates are visible
+	LaunchStatsRecorder launchStats( launchStatsFilePath, selectedPreset->name, selectedEngine->name );
+
 	if (settings.showEngineOutput)
 	{
 		ProcessOutputWindow processWindow( this, settings.closeOutputOnSuccess );
-		processWindow.runProcess( cmd.executable, cmd.arguments, processWorkingDir, envVars );
+		processWindow.runProcess( cmd.executable, cmd.arguments, processWorkingDir, envVars, scheduling, launchStats );
 		//int resultCode = processWindow.result();
 		settings.closeOutputOnSuccess = processWindow.closeOnSuccessChecked;
 	}
 	else
 	{
-		bool success = startDetachedProcess( cmd.executable, cmd.arguments, processWorkingDir, envVars );
+		bool success = startDetachedProcess( cmd.executable, cmd.arguments, processWorkingDir, envVars, scheduling, launchStats );
 
 		if (success && settings.closeOnLaunch)
 		{
@@ -12,10 +12,17 @@
 #include "Dialogs/DialogCommon.hpp"
 
 #include "DataModels/GenericListModel.hpp"
+#include "DataModels/MapPackTreeModel.hpp"
 #include "Widgets/ExtendedListView.hpp"  // DnDType
 #include "Widgets/ExtendedTreeView.hpp"  // SortKey
 #include "Widgets/SearchPanel.hpp"
+#include "Widgets/FuzzySearchPanel.hpp"
+#include "Utils/TrigramIndex.hpp"
+#include "Utils/AsyncPathChecker.hpp"
+#include "Utils/BulkFileImporter.hpp"
+#include "Utils/FileCacheWarmer.hpp"
 #include "Dialogs/DMBEditor.hpp"  // DMBEditor::Result
+#include "LaunchCommandBuilder.hpp"  // LaunchCmdParts, LaunchCommandOptions
 #include "UserData.hpp"
 #include "UpdateChecker.hpp"
 #include "Themes.hpp"  // SystemThemeWatcher
@@ -25,12 +32,14 @@ struct OptionsToLoad;
 #include <QMainWindow>
 #include <QString>
 #include <QFileInfo>
-#include <QFileSystemModel>
+#include <QTimer>
+#include <QSet>
 class QTableWidget;
 class QItemSelection;
 class QComboBox;
 class QLineEdit;
 class QShortcut;
+class QProgressDialog;
 
 #include <memory>
 
@@ -70,6 +79,7 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 	void onExportToScriptTriggered();
 	void onExportToShortcutTriggered();
 	//void onImportFromScriptTriggered();
+	void onLaunchStatsTriggered();
 
 	void onEngineSelected( int index );
 	void onConfigSelected( int index );
@@ -101,7 +111,11 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 
 	void onMapIconsToggled();
 	void onSortActionTriggered( ExtendedTreeView::SortKey key, Qt::SortOrder order );
+	void onMapSortIndicatorChanged( int column, Qt::SortOrder order );
 	void onMapHelpLabelHideTriggered();
+	void onMapSearchPhraseChanged( const QString & phrase );
+	void onMapSearchIndexUpdated();
+	void onMapSearchResultChosen( int resultIdx );
 
 	void modAdd();
 	void modAddDir();
@@ -118,8 +132,13 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 	void onModsInserted( int row, int count );
 	void onModsRemoved( int row, int count );
 	void onModsDropped( int row, int count, DnDSources dndSource );
+	void onModImportChunkReady( const QStringList & existingPaths, int processedCount, int totalCount );
+	void onModImportFinished( bool cancelled );
+	void onModImportCancelRequested();
 	void onMapsAfterModsToggled( bool checked );
 	void onModIconsToggled();
+	void onModSearchPhraseChanged( const QString & phrase );
+	void onModSearchResultChosen( int resultIdx );
 
 	void onModeChosen_Default();
 	void onModeChosen_LaunchMap();
@@ -181,6 +200,12 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 	void onNoSFXToggled( bool checked );
 	void onNoMusicToggled( bool checked );
 
+	void onCpuAffinityChanged( const QString & cpuList );
+	void onNiceLevelChanged( int niceLevel );
+	void onSchedPolicySelected( int policyIdx );
+	void onIOPrioClassSelected( int classIdx );
+	void onIOPrioLevelChanged( int ioPrioLevel );
+
 	void presetEnvVarAdd();
 	void presetEnvVarDelete();
 	void globalEnvVarAdd();
@@ -230,6 +255,7 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 	void restoreSelectedEngine( Preset & preset );
 	void restoreSelectedConfig( Preset & preset );
 	void restoreSelectedIWAD( Preset & preset );
+	void onPresetIWADChecked( const QString & iwadPath, PathStatus status );
 	void restoreSelectedMapPacks( Preset & preset );
 	void restoreSelectedMods( Preset & preset );
 
@@ -240,6 +266,7 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 	void restoreCompatibilityOptions( const CompatibilityOptions & opts );
 	void restoreVideoOptions( const VideoOptions & opts );
 	void restoreAudioOptions( const AudioOptions & opts );
+	void restoreSchedulingOptions( const os::ProcessScheduling & opts );
 	void restoreGlobalOptions( const GlobalOptions & opts );
 
 	void restoreEnvVars( const EnvVars & envVars, QTableWidget * table );
@@ -254,6 +281,7 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 	void runAboutDialog();
 	void runSetupDialog();
 	void runOptsStorageDialog();
+	void runLaunchStatsDialog();
 	void runGameOptsDialog();
 	void runCompatOptsDialog();
 	void runPlayerColorDialog();
@@ -293,32 +321,13 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 	void toggleSkillSubwidgets( LaunchMode mode );
 	void toggleOptionsSubwidgets( LaunchMode mode );
 
-	struct LaunchCommandOptions
-	{
-		/// The currently selected engine.
-		/** The command cannot be generated without one. */
-		const EngineInfo & selectedEngine;
-
-		/// Path style to be used for the engine executable.
-		PathStyle exePathStyle;
-
-		// Path style for the arguments is determined case by case.
-
-		/// Working directory of the process that will run the command.
-		/** This determines the relative path of the engine executable in the command. */
-		const QString & runnersWorkingDir;
-
-		/// Surround each path in the command with quotes.
-		/** Required for displaying the command or saving it to a script file. */
-		bool quotePaths;
-
-		/// Verify that each path in the command is valid and leads to the correct entry type (file or directory).
-		/** If invalid path is found, display a message box with an error description. */
-		bool verifyPaths;
-	};
-	os::ShellCommand generateLaunchCommand( LaunchCommandOptions cmdOpts );
+	LaunchCommandInput gatherLaunchCommandInput( LaunchCmdParts parts );
+	os::ShellCommand generateLaunchCommand( const LaunchCommandOptions & cmdOpts );
+	bool handleLaunchCmdReport( const LaunchCmdReport & report );
+	void warmUpGameFiles();
 
-	void updateLaunchCommand();
+	void updateLaunchCommand( LaunchCmdParts changedParts = LaunchCmdPart::All );
+	void flushLaunchCommandUpdate();
 	void executeLaunchCommand();
 	bool makeSureDirExists( const QString & dirPath, QLineEdit * lineEdit = nullptr );
 	int askForExtraPermissions( const EngineInfo & selectedEngine, const QStringList & permissions );
@@ -330,9 +339,8 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 
 	QStringList getSelectedMapPacks() const;
 
-	template< typename Entry, typename Functor > void expandDMB( const QString & filePath, const Functor & loopBody ) const;
-	template< typename Functor > void forEachSelectedMapFileWithExpandedDMBs( const Functor & loopBody ) const;
-	template< typename Functor > void forEachCheckedModFileWithExpandedDMBs( const Functor & loopBody ) const;
+	void startModImport( QStringList paths, int row );
+
 
 	static QStringList getUniqueMapNamesFromWADs( const QList<QString> & selectedWADs );
 
@@ -381,6 +389,8 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 
 	Ui::MainWindow * ui = nullptr;
 	SearchPanel * presetSearchPanel = nullptr;
+	FuzzySearchPanel * mapSearchPanel = nullptr;
+	FuzzySearchPanel * modSearchPanel = nullptr;
 
 	QAction * hideLabelAction = nullptr;
 
@@ -408,6 +418,19 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 
 	QStringList compatOptsCmdArgs;  ///< string with command line args created from compatibility options, cached so that it doesn't need to be regenerated on every command line update
 
+	LaunchCmdSections displayedLaunchCmd;  ///< parts of the command displayed in commandLine, cached so that only the changed parts need to be regenerated
+	LaunchCmdParts dirtyLaunchCmdParts = LaunchCmdPart::All;  ///< parts of displayedLaunchCmd whose source data have changed since they were generated
+	QSet< QString > reportedBundleCycles;  ///< Mod Bundle cycles the user has already been told about, so that the command updates don't repeat it
+	QTimer launchCmdUpdateTimer;  ///< coalesces the requests to update the displayed command into a single regeneration
+
+	struct LaunchCmdUpdateStats
+	{
+		uint requested = 0;   ///< how many times an update of the displayed command was requested
+		uint performed = 0;   ///< how many times the displayed command was actually regenerated
+		uint avoided() const  { return requested > performed ? requested - performed : 0; }
+	};
+	LaunchCmdUpdateStats launchCmdUpdateStats;
+
 	UpdateChecker updateChecker;
 
  #if IS_WINDOWS
@@ -419,6 +442,7 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 	QDir appDataDir;   ///< directory where this application can store its data
 	QString optionsFilePath;  ///< path to file with user options
 	QString cacheFilePath;    ///< path to file with various cached file info
+	QString launchStatsFilePath;  ///< path to file with the recorded launch latencies and session durations
 
 	struct ConfigFile;
 
@@ -482,10 +506,24 @@ class MainWindow : public QMainWindow, private DialogWithPaths {
 	ReadOnlyDirectListModel< IWAD > iwadModel;    ///< user-ordered list of iwads (managed by SetupDialog)
 
 	MapSettings mapSettings;    ///< map-related preferences (value returned by SetupDialog)
-	QFileSystemModel mapModel;  ///< model representing a directory with map files
+	MapPackTreeModel mapModel;  ///< model representing a directory with map files
 
 	ModSettings modSettings;    ///< mod-related preferences (value returned by SetupDialog)
-	EditableDirectListModel< Mod > modModel;
+	EditableExternalListModel< Mod > modModel;  ///< operates directly on the mod list of the selected preset
+
+	QStringList mapSearchResults;    ///< paths relative to the map dir of the last search results, in the displayed order
+	TrigramIndex modSearchIndex;     ///< names of the mods in modModel, entry IDs are the row indexes
+	bool modSearchIndexDirty = true; ///< the mod list has changed since modSearchIndex was built
+	QVector< int > modSearchResults; ///< rows of the last search results, in the displayed order
+
+	AsyncPathChecker pathChecker;    ///< checks existence of the files from the restored preset without blocking the UI
+	FileCacheWarmer gameFilesWarmer; ///< pre-loads the game files of the selected preset into the OS cache
+	QTimer gameFilesWarmUpTimer;     ///< delays the warm-up until the user stays on the selected preset for a while
+
+	BulkFileImporter modImporter;    ///< adds large numbers of dropped or selected mod files without blocking the UI
+	QProgressDialog * modImportProgress = nullptr;  ///< created on the first bulk import
+	const decltype( modModel )::Container * modImportTargetList = nullptr;  ///< the list the import has started in
+	int modImportRow = 0;            ///< where to insert the next chunk of the imported mods
 
 	EditableFilteredListModel< Preset > presetModel;    ///< user-made presets, when one is selected from the list view, it applies its stored options to the other widgets
 
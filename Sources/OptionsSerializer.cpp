@@ -441,6 +441,28 @@ static void deserialize( const JsonObjectCtx & optsJs, AudioOptions & opts )
 	opts.noMusic = optsJs.getBool( "no_music", opts.noMusic );
 }
 
+static QJsonObject serialize( const os::ProcessScheduling & opts )
+{
+	QJsonObject optsJs;
+
+	optsJs["cpu_affinity"] = opts.cpuAffinity;
+	optsJs["nice_level"] = opts.niceLevel;
+	optsJs["sched_policy"] = int( opts.schedPolicy );
+	optsJs["io_prio_class"] = int( opts.ioPrioClass );
+	optsJs["io_prio_level"] = opts.ioPrioLevel;
+
+	return optsJs;
+}
+
+static void deserialize( const JsonObjectCtx & optsJs, os::ProcessScheduling & opts )
+{
+	opts.cpuAffinity = optsJs.getString( "cpu_affinity", opts.cpuAffinity );
+	opts.niceLevel = optsJs.getInt( "nice_level", opts.niceLevel );
+	opts.schedPolicy = optsJs.getEnum< os::SchedPolicy >( "sched_policy", opts.schedPolicy );
+	opts.ioPrioClass = optsJs.getEnum< os::IOPrioClass >( "io_prio_class", opts.ioPrioClass );
+	opts.ioPrioLevel = optsJs.getInt( "io_prio_level", opts.ioPrioLevel );
+}
+
 static QJsonObject serialize( const GlobalOptions & opts )
 {
 	QJsonObject optsJs;
@@ -526,6 +548,8 @@ static QJsonObject serialize( const Preset & preset, const StorageSettings & set
 	if (settings.audioOptsStorage == StoreToPreset)
 		presetJs["audio_options"] = serialize( preset.audioOpts );
 
+	presetJs["scheduling_options"] = serialize( preset.schedulingOpts );
+
 	presetJs["alternative_paths"] = serialize( preset.altPaths );
 
 	// preset-specific args
@@ -607,6 +631,9 @@ static void deserialize( const JsonObjectCtx & presetJs, Preset & preset, const
 		if (JsonObjectCtx optsJs = presetJs.getObject( "audio_options" ))
 			deserialize( optsJs, preset.audioOpts );
 
+	if (JsonObjectCtx optsJs = presetJs.getObject( "scheduling_options", DontShowError ))  // not present in older options
+		deserialize( optsJs, preset.schedulingOpts );
+
 	if (JsonObjectCtx optsJs = presetJs.getObject( "alternative_paths" ))
 		deserialize( optsJs, preset.altPaths );
 
@@ -649,6 +676,7 @@ static void serialize( QJsonObject & settingsJs, const LauncherSettings & settin
 	settingsJs["ask_for_sandbox_permissions"] = settings.askForSandboxPermissions;
 	settingsJs["hide_map_label"] = settings.hideMapHelpLabel;
 	settingsJs["wrap_lines_in_txt_viewer"] = settings.wrapLinesInTxtViewer;
+	settingsJs["warm_up_game_files"] = settings.warmUpGameFiles;
 
 	settingsJs["options_storage"] = serialize( static_cast< const StorageSettings & >( settings ) );
 }
@@ -664,6 +692,7 @@ static void deserialize( const JsonObjectCtx & settingsJs, LauncherSettings & se
 	settings.askForSandboxPermissions = settingsJs.getBool( "ask_for_sandbox_permissions", settings.askForSandboxPermissions, DontShowError );
 	settings.hideMapHelpLabel = settingsJs.getBool( "hide_map_label", settings.hideMapHelpLabel, DontShowError );
 	settings.wrapLinesInTxtViewer = settingsJs.getBool( "wrap_lines_in_txt_viewer", settings.wrapLinesInTxtViewer, DontShowError );
+	settings.warmUpGameFiles = settingsJs.getBool( "warm_up_game_files", settings.warmUpGameFiles, DontShowError );
 
 	if (JsonObjectCtx optsStorageJs = settingsJs.getObject( "options_storage" ))
 	{
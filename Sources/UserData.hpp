@@ -15,7 +15,7 @@
 #include "Utils/PtrList.hpp"                // PtrList
 #include "Utils/EnumTraits.hpp"             // enumName, enumSize
 #include "Utils/FileSystemUtilsTypes.hpp"   // PathStyle
-#include "Utils/OSUtilsTypes.hpp"           // EnvVar
+#include "Utils/OSUtilsTypes.hpp"           // EnvVar, ProcessScheduling
 #include "EngineTraits.hpp"                 // EngineFamily
 #include "Themes.hpp"                       // Theme
 
@@ -27,6 +27,10 @@
 
 template<> inline const char * enumName< Qt::SortOrder >() { return "Qt::SortOrder"; }
 template<> inline int enumSize< Qt::SortOrder >() { return 2; }
+template<> inline const char * enumName< os::SchedPolicy >() { return "SchedPolicy"; }
+template<> inline int enumSize< os::SchedPolicy >() { return size_t( os::SchedPolicy::Idle ) + 1; }
+template<> inline const char * enumName< os::IOPrioClass >() { return "IOPrioClass"; }
+template<> inline int enumSize< os::IOPrioClass >() { return size_t( os::IOPrioClass::Idle ) + 1; }
 
 
 //======================================================================================================================
@@ -109,7 +113,7 @@ struct Mod : public AModelItem
 	bool isChecked() const                  { return checked; }
 	void setChecked( bool checked )         { this->checked = checked; }
 	const QString & getFilePath() const     { return path; }
-	const QIcon & getIcon() const;
+	QIcon getIcon() const;
 	QJsonObject serialize() const;
 	bool deserialize( const JsonObjectCtx & modJs );
 };
@@ -286,7 +290,7 @@ struct Preset : public AModelItem
 	QString selectedConfig;   // we store the config by name instead of index, so that it does't break when user reorders them
 	QString selectedIWAD;   // we store the IWAD by path instead of index, so that it doesn't break when user reorders them
 	QStringList selectedMapPacks;
-	PtrList< Mod > mods;   // this list needs to be kept in sync with mod list widget
+	PtrList< Mod > mods;   // the mod list widget operates directly on this list when the preset is selected
 	bool loadMapsAfterMods = false;
 
 	LaunchOptions launchOpts;
@@ -295,6 +299,7 @@ struct Preset : public AModelItem
 	CompatibilityOptions compatOpts;
 	VideoOptions videoOpts;
 	AudioOptions audioOpts;
+	os::ProcessScheduling schedulingOpts;
 	AlternativePaths altPaths;
 
 	QString cmdArgs;
@@ -371,6 +376,7 @@ struct LauncherSettings : public StorageSettings  // inherited instead of includ
 	bool askForSandboxPermissions = true;
 	bool hideMapHelpLabel = false;
 	bool wrapLinesInTxtViewer = false;
+	bool warmUpGameFiles = false;
 
 	void assign( const StorageSettings & other ) { static_cast< StorageSettings & >( *this ) = other; }
 };
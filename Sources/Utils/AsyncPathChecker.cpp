@@ -0,0 +1,278 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: checking existence of files in a background thread with short-term memoization of the results
+//======================================================================================================================
+
+#include "AsyncPathChecker.hpp"
+
+#include "FileSystemUtils.hpp"  // getAbsoluteParentDir
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QFileInfo>
+#include <QPointer>
+#include <QSet>
+
+#include <vector>
+#include <algorithm>
+
+
+//======================================================================================================================
+// background tasks
+
+static PathStatus queryPathStatus( const QString & path )
+{
+	QFileInfo entry( path );
+	return !entry.exists() ? PathStatus::Missing
+	     : entry.isDir()   ? PathStatus::Dir
+	                       : PathStatus::File;
+}
+
+class CheckPathsTask : public QRunnable {
+
+	AsyncPathChecker * _checker;
+	QStringList _paths;
+	AsyncPathChecker::Results _recentResults;
+	QPointer< QObject > _context;
+	AsyncPathChecker::ResultCallback _onDone;
+
+ public:
+
+	CheckPathsTask(
+		AsyncPathChecker * checker, QStringList paths, AsyncPathChecker::Results recentResults,
+		QObject * context, AsyncPathChecker::ResultCallback onDone
+	)
+		: _checker( checker ), _paths( std::move(paths) ), _recentResults( std::move(recentResults) ),
+		  _context( context ), _onDone( std::move(onDone) ) {}
+
+	virtual void run() override
+	{
+		// The memo belongs to the main thread, the fresh results are stored into it when they are delivered.
+		AsyncPathChecker::Results queriedResults = checkPathsInParallel( _paths );
+
+		AsyncPathChecker::Results results = std::move( _recentResults );
+		for (auto resultIter = queriedResults.begin(); resultIter != queriedResults.end(); ++resultIter)
+			results.insert( resultIter.key(), resultIter.value() );
+
+		// The checker's destructor waits for this task to finish, so it's safe to post to it.
+		// If the checker gets destroyed before the posted call is processed, Qt discards the call.
+		QMetaObject::invokeMethod( _checker,
+			[ checker = _checker, context = _context, onDone = std::move(_onDone),
+			  queriedResults = std::move(queriedResults), results = std::move(results) ]()
+			{
+				checker->storeResults( queriedResults );
+				if (context)  // the receiver may have been destroyed while we were working
+					onDone( results );
+			},
+			Qt::QueuedConnection
+		);
+	}
+
+};
+
+/// Queries a continuous range of the paths, each task writes only into its own range of the statuses.
+class QueryPathRangeTask : public QRunnable {
+
+	const QStringList & _paths;
+	PathStatus * _statuses;
+	int _begin;
+	int _end;
+	QSemaphore & _doneTasks;
+
+ public:
+
+	QueryPathRangeTask( const QStringList & paths, PathStatus * statuses, int begin, int end, QSemaphore & doneTasks )
+		: _paths( paths ), _statuses( statuses ), _begin( begin ), _end( end ), _doneTasks( doneTasks ) {}
+
+	virtual void run() override
+	{
+		for (int i = _begin; i < _end; ++i)
+		{
+			_statuses[i] = queryPathStatus( _paths[i] );
+		}
+		_doneTasks.release();
+	}
+
+};
+
+
+//======================================================================================================================
+// AsyncPathChecker
+
+AsyncPathChecker::AsyncPathChecker( qint64 memoTimeoutMs, QObject * parent )
+:
+	QObject( parent ),
+	LoggingComponent( u"AsyncPathChecker" ),
+	_memoTimeoutMs( memoTimeoutMs )
+{
+	_clock.start();
+	_workerPool.setMaxThreadCount( 1 );
+}
+
+AsyncPathChecker::~AsyncPathChecker()
+{
+	_workerPool.clear();
+	_workerPool.waitForDone();
+}
+
+std::optional< PathStatus > AsyncPathChecker::findRecentResult( const QString & path ) const
+{
+	auto memoIter = _memo.constFind( path );
+	if (memoIter == _memo.constEnd() || _clock.elapsed() - memoIter->checkedAt > _memoTimeoutMs)
+		return std::nullopt;
+
+	return memoIter->status;
+}
+
+void AsyncPathChecker::checkPaths( QStringList paths, QObject * context, ResultCallback onDone )
+{
+	if (paths.isEmpty())
+		return;
+
+	// Switching back and forth between presets checks the same paths again, let's not wait for the storage twice.
+	Results recentResults;
+	QStringList pathsToQuery;
+	for (QString & path : paths)
+	{
+		if (auto status = findRecentResult( path ))
+			recentResults.insert( path, *status );
+		else
+			pathsToQuery.append( std::move(path) );
+	}
+
+	logDebug() << "checking " << pathsToQuery.size() << " paths in background, " << recentResults.size() << " were checked recently";
+
+	// Even when everything is known, the callback is delivered asynchronously as usual, the caller may rely on it.
+	_workerPool.start( new CheckPathsTask( this, std::move(pathsToQuery), std::move(recentResults), context, std::move(onDone) ) );
+}
+
+void AsyncPathChecker::storeResults( const Results & results )
+{
+	const qint64 now = _clock.elapsed();
+
+	// don't let the outdated entries accumulate forever
+	if (_memo.size() > 1024)
+	{
+		for (auto memoIter = _memo.begin(); memoIter != _memo.end(); )
+		{
+			if (now - memoIter->checkedAt > _memoTimeoutMs)
+				memoIter = _memo.erase( memoIter );
+			else
+				++memoIter;
+		}
+	}
+
+	for (auto resultIter = results.begin(); resultIter != results.end(); ++resultIter)
+	{
+		_memo.insert( resultIter.key(), { resultIter.value(), now } );
+	}
+}
+
+
+//======================================================================================================================
+// parallel batch
+
+// The threads spend most of the time waiting for the storage, so there can be more of them than CPU cores.
+constexpr int maxThreadCount = 8;
+
+/// Shared by all the batches, so that the threads don't have to be started again for every launch.
+/** The global pool is not used, because its size is derived from the CPU cores and it can be busy with other work. */
+static QThreadPool & getQueryPool()
+{
+	static QThreadPool pool;
+	if (pool.maxThreadCount() != maxThreadCount)
+		pool.setMaxThreadCount( maxThreadCount );
+	return pool;
+}
+
+static void queryPathsInParallel( const QStringList & paths, std::vector< PathStatus > & statuses )
+{
+	statuses.resize( size_t( paths.size() ) );
+
+	const int threadCount = std::min( maxThreadCount, int( paths.size() ) );
+	if (threadCount <= 1)
+	{
+		for (int i = 0; i < paths.size(); ++i)
+			statuses[i] = queryPathStatus( paths[i] );
+		return;
+	}
+
+	const int chunkSize = (int( paths.size() ) + threadCount - 1) / threadCount;
+
+	// Wait only for our own tasks, the pool may be processing another batch at the same time.
+	QSemaphore doneTasks;
+	int taskCount = 0;
+	for (int begin = 0; begin < paths.size(); begin += chunkSize)
+	{
+		int end = std::min( begin + chunkSize, int( paths.size() ) );
+		getQueryPool().start( new QueryPathRangeTask( paths, statuses.data(), begin, end, doneTasks ) );
+		++taskCount;
+	}
+	doneTasks.acquire( taskCount );
+}
+
+AsyncPathChecker::Results checkPathsInParallel( const QStringList & paths, AsyncPathChecker * resultMemo )
+{
+	AsyncPathChecker::Results results;
+	results.reserve( paths.size() );
+
+	// sort out which paths really need to be queried
+	QStringList pathsToQuery;
+	QStringList parentDirs;   ///< parent dir of each path in pathsToQuery
+	QSet< QString > queuedPaths;
+	QHash< QString, int > pathCountPerDir;
+	for (const QString & path : paths)
+	{
+		if (path.isEmpty() || results.contains( path ) || queuedPaths.contains( path ))
+			continue;  // empty paths are reported by the caller, duplicates are checked only once
+
+		QString parentDir = fs::getAbsoluteParentDir( path );
+		pathCountPerDir[ parentDir ]++;
+		parentDirs.append( std::move(parentDir) );
+		pathsToQuery.append( path );
+		queuedPaths.insert( path );
+	}
+
+	// First check the directories that contain multiple paths, so that we don't have to query all the files
+	// from a directory that doesn't exist (for example a disconnected network drive).
+	QStringList sharedDirs;
+	for (auto dirIter = pathCountPerDir.begin(); dirIter != pathCountPerDir.end(); ++dirIter)
+	{
+		if (dirIter.value() > 1)
+			sharedDirs.append( dirIter.key() );
+	}
+	std::vector< PathStatus > dirStatuses;
+	queryPathsInParallel( sharedDirs, dirStatuses );
+
+	QSet< QString > missingDirs;
+	for (int i = 0; i < sharedDirs.size(); ++i)
+	{
+		if (dirStatuses[i] != PathStatus::Dir)
+			missingDirs.insert( sharedDirs[i] );
+	}
+
+	// then the paths themselves, except those that cannot exist
+	QStringList remainingPaths;
+	remainingPaths.reserve( pathsToQuery.size() );
+	for (int i = 0; i < pathsToQuery.size(); ++i)
+	{
+		if (missingDirs.contains( parentDirs[i] ))
+			results.insert( pathsToQuery[i], PathStatus::Missing );
+		else
+			remainingPaths.append( pathsToQuery[i] );
+	}
+	std::vector< PathStatus > pathStatuses;
+	queryPathsInParallel( remainingPaths, pathStatuses );
+
+	for (int i = 0; i < remainingPaths.size(); ++i)
+	{
+		results.insert( remainingPaths[i], pathStatuses[i] );
+	}
+
+	if (resultMemo)
+		resultMemo->storeResults( results );
+
+	return results;
+}
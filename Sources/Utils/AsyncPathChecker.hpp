@@ -0,0 +1,97 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: checking existence of files in a background thread with short-term memoization of the results
+//======================================================================================================================
+
+#ifndef ASYNC_PATH_CHECKER_INCLUDED
+#define ASYNC_PATH_CHECKER_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include "ErrorHandling.hpp"  // LoggingComponent
+
+#include <QObject>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <optional>
+
+
+//======================================================================================================================
+
+enum class PathStatus : uint8_t
+{
+	Missing,
+	File,
+	Dir,
+};
+
+/// Checks whether files exist in a background thread, so that slow storage (network drives) doesn't block the UI.
+/** The results are remembered for a short time, so that quickly switching back and forth between presets
+  * doesn't repeat the same file-system queries. */
+
+class AsyncPathChecker : public QObject, protected LoggingComponent {
+
+	Q_OBJECT
+
+ public:
+
+	using Results = QHash< QString, PathStatus >;
+	using ResultCallback = std::function< void ( const Results & results ) >;
+
+	AsyncPathChecker( qint64 memoTimeoutMs = 10'000, QObject * parent = nullptr );
+	virtual ~AsyncPathChecker() override;
+
+	/// Returns the status of the path if it was checked recently, otherwise std::nullopt.
+	std::optional< PathStatus > findRecentResult( const QString & path ) const;
+
+	/// Checks all the paths in a single batch in a worker thread.
+	/** The paths that were checked recently are taken from the memo, the rest is queried by checkPathsInParallel().
+	  * When done, \p onDone is called in the main thread, unless \p context has been destroyed in the meantime. */
+	void checkPaths( QStringList paths, QObject * context, ResultCallback onDone );
+
+	/// Remembers results of checks done elsewhere, so that the following checks of the same paths can reuse them.
+	void storeResults( const Results & results );
+
+	/// Forgets all the remembered results, for example when the user explicitly requests a refresh.
+	void clearMemo()  { _memo.clear(); }
+
+ private:
+
+	struct MemoEntry
+	{
+		PathStatus status;
+		qint64 checkedAt;   ///< milliseconds of _clock
+	};
+
+	QHash< QString, MemoEntry > _memo;
+	QElapsedTimer _clock;
+	qint64 _memoTimeoutMs;
+
+	QThreadPool _workerPool;  ///< single thread, the batches are processed one by one
+
+};
+
+
+//======================================================================================================================
+
+/// Checks all the paths in parallel and waits until all of them are done.
+/** Parent directories shared by multiple paths are checked only once first, and the files inside the missing ones
+  * are not queried at all. Every path is queried again, the memoized results are not used here, because they may be
+  * too old to be relied on right before a launch. If \p resultMemo is given, the fresh results are stored into it,
+  * so that the following checks of the same paths don't have to query them again.
+  * The memo is not synchronized, so it can only be given in the thread that owns it. */
+AsyncPathChecker::Results checkPathsInParallel( const QStringList & paths, AsyncPathChecker * resultMemo = nullptr );
+
+
+//======================================================================================================================
+
+
+#endif // ASYNC_PATH_CHECKER_INCLUDED
@@ -0,0 +1,202 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: importing large numbers of files in a background thread
+//======================================================================================================================
+
+#include "BulkFileImporter.hpp"
+
+#include "WADReader.hpp"  // readWadInfo, g_cachedWadInfo
+
+#include <QRunnable>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QElapsedTimer>
+
+
+//======================================================================================================================
+// background tasks
+
+static constexpr int maxChunkSize = 256;       ///< more entries are inserted into the model at once
+static constexpr qint64 maxChunkDelayMs = 50;  ///< but at least this often, so that the progress keeps moving
+
+static bool isWadFileSuffix( const QString & suffix )
+{
+	return suffix.compare( "wad", Qt::CaseInsensitive ) == 0
+	    || suffix.compare( "iwad", Qt::CaseInsensitive ) == 0
+	    || suffix.compare( "pwad", Qt::CaseInsensitive ) == 0;
+}
+
+class CheckImportedFilesTask : public QRunnable {
+
+	BulkFileImporter * _importer;
+	QStringList _paths;
+	BulkFileImporter::CancelFlag _cancelFlag;
+	uint _generation;
+
+ public:
+
+	CheckImportedFilesTask( BulkFileImporter * importer, QStringList paths, BulkFileImporter::CancelFlag cancelFlag, uint generation )
+		: _importer( importer ), _paths( std::move(paths) ), _cancelFlag( std::move(cancelFlag) ), _generation( generation ) {}
+
+	virtual void run() override
+	{
+		const int totalCount = int( _paths.size() );
+
+		QStringList existingPaths;
+		QVector< BulkFileImporter::WadFile > wadFiles;
+		QElapsedTimer sinceLastChunk;
+		sinceLastChunk.start();
+
+		for (int i = 0; i < totalCount; ++i)
+		{
+			if (*_cancelFlag)
+				return;  // the importer has already been told it's finished
+
+			QFileInfo entry( _paths[i] );
+			if (entry.exists())
+			{
+				existingPaths.append( _paths[i] );
+				if (entry.isFile() && isWadFileSuffix( entry.suffix() ))
+					wadFiles.append({ _paths[i], entry.lastModified().toSecsSinceEpoch() });
+			}
+
+			const bool isLast = i == totalCount - 1;
+			if (isLast || existingPaths.size() >= maxChunkSize || sinceLastChunk.elapsed() >= maxChunkDelayMs)
+			{
+				deliverChunk( std::move( existingPaths ), std::move( wadFiles ), i + 1, totalCount );
+				existingPaths.clear();
+				wadFiles.clear();
+				sinceLastChunk.restart();
+			}
+		}
+
+		QMetaObject::invokeMethod( _importer,
+			[ importer = _importer, generation = _generation ]() { importer->onAllChecked( generation ); },
+			Qt::QueuedConnection
+		);
+	}
+
+ private:
+
+	void deliverChunk( QStringList existingPaths, QVector< BulkFileImporter::WadFile > wadFiles, int processedCount, int totalCount )
+	{
+		// The importer's destructor waits for this task to finish, so it's safe to post to it.
+		QMetaObject::invokeMethod( _importer,
+			[ importer = _importer, generation = _generation, existingPaths = std::move( existingPaths ),
+			  wadFiles = std::move( wadFiles ), processedCount, totalCount ]()
+			{
+				importer->onChunkChecked( generation, existingPaths, wadFiles, processedCount, totalCount );
+			},
+			Qt::QueuedConnection
+		);
+	}
+
+};
+
+class PrefetchWadInfoTask : public QRunnable {
+
+	QVector< BulkFileImporter::WadFile > _wadFiles;
+	BulkFileImporter::CancelFlag _cancelFlag;
+	QObject * _receiver;
+
+ public:
+
+	PrefetchWadInfoTask( QVector< BulkFileImporter::WadFile > wadFiles, BulkFileImporter::CancelFlag cancelFlag, QObject * receiver )
+		: _wadFiles( std::move(wadFiles) ), _cancelFlag( std::move(cancelFlag) ), _receiver( receiver ) {}
+
+	virtual void run() override
+	{
+		for (const auto & wadFile : as_const( _wadFiles ))
+		{
+			if (*_cancelFlag)
+				return;
+
+			doom::UncertainWadInfo wadInfo = doom::readWadInfo( wadFile.path );
+
+			// the cache is not thread-safe, it must be updated in the main thread
+			QMetaObject::invokeMethod( _receiver,
+				[ wadFile, wadInfo = std::move( wadInfo ) ]()
+				{
+					doom::g_cachedWadInfo.storeFileInfo( wadFile.path, wadInfo, wadFile.lastModified );
+				},
+				Qt::QueuedConnection
+			);
+		}
+	}
+
+};
+
+
+//======================================================================================================================
+// BulkFileImporter
+
+BulkFileImporter::BulkFileImporter( QObject * parent )
+:
+	QObject( parent ),
+	LoggingComponent( u"BulkFileImporter" ),
+	_cancelFlag( std::make_shared< std::atomic< bool > >( false ) )
+{
+	_workerPool.setMaxThreadCount( 1 );
+}
+
+BulkFileImporter::~BulkFileImporter()
+{
+	*_cancelFlag = true;
+	_workerPool.clear();
+	_workerPool.waitForDone();
+}
+
+void BulkFileImporter::start( QStringList paths )
+{
+	cancel();
+
+	logDebug() << "importing " << paths.size() << " files in background";
+
+	_cancelFlag = std::make_shared< std::atomic< bool > >( false );
+	++_generation;
+	_isImporting = true;
+
+	_workerPool.start( new CheckImportedFilesTask( this, std::move(paths), _cancelFlag, _generation ) );
+}
+
+void BulkFileImporter::cancel()
+{
+	if (!_isImporting)
+		return;
+
+	logDebug() << "import cancelled";
+
+	*_cancelFlag = true;
+	_isImporting = false;
+	emit finished( /*cancelled*/true );
+}
+
+void BulkFileImporter::onChunkChecked(
+	uint generation, const QStringList & existingPaths, const QVector< WadFile > & wadFiles, int processedCount, int totalCount
+){
+	if (generation != _generation || !_isImporting)
+		return;  // cancelled meanwhile
+
+	// Skip the files that have already been read, reading them again would only waste the disk bandwidth.
+	QVector< WadFile > wadFilesToRead;
+	for (const WadFile & wadFile : wadFiles)
+		if (!doom::g_cachedWadInfo.findUpToDateFileInfo( wadFile.path, wadFile.lastModified ))
+			wadFilesToRead.append( wadFile );
+
+	// The pool has a single thread, so this will run after all the chunks are checked.
+	if (!wadFilesToRead.isEmpty())
+		_workerPool.start( new PrefetchWadInfoTask( std::move( wadFilesToRead ), _cancelFlag, this ) );
+
+	emit chunkReady( existingPaths, processedCount, totalCount );
+}
+
+void BulkFileImporter::onAllChecked( uint generation )
+{
+	if (generation != _generation || !_isImporting)
+		return;
+
+	_isImporting = false;
+	emit finished( /*cancelled*/false );
+}
@@ -0,0 +1,86 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: importing large numbers of files in a background thread
+//======================================================================================================================
+
+#ifndef BULK_FILE_IMPORTER_INCLUDED
+#define BULK_FILE_IMPORTER_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include "ErrorHandling.hpp"  // LoggingComponent
+
+#include <QObject>
+#include <QThreadPool>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+
+
+//======================================================================================================================
+/// Checks a large number of dropped or selected files in a worker thread, so that adding them doesn't freeze the UI.
+/** The existing entries are delivered in chunks, so that the caller can add them to its model gradually
+  * and display a progress. The WAD files among them are then read in the same worker thread and their info stored
+  * into doom::g_cachedWadInfo, so that the map names are ready when the user selects them. */
+
+class BulkFileImporter : public QObject, protected LoggingComponent {
+
+	Q_OBJECT
+
+ public:
+
+	BulkFileImporter( QObject * parent = nullptr );
+	virtual ~BulkFileImporter() override;
+
+	/// Starts importing the paths in background, the previous import, if any, is cancelled.
+	void start( QStringList paths );
+
+	/// Stops delivering the chunks, those that have already been delivered stay imported.
+	void cancel();
+
+	bool isImporting() const  { return _isImporting; }
+
+ signals:
+
+	/// Emitted in the main thread for each chunk of the existing entries, in the order of the input paths.
+	/** \param processedCount How many of the input paths have been checked so far, including this chunk. */
+	void chunkReady( const QStringList & existingPaths, int processedCount, int totalCount );
+
+	/// Emitted when all the entries have been delivered or when the import has been cancelled.
+	void finished( bool cancelled );
+
+ private:
+
+	friend class CheckImportedFilesTask;
+	friend class PrefetchWadInfoTask;
+
+	using CancelFlag = std::shared_ptr< std::atomic< bool > >;
+
+	struct WadFile
+	{
+		QString path;
+		qint64 lastModified;   ///< seconds since epoch, the same as doom::g_cachedWadInfo uses
+	};
+
+	void onChunkChecked( uint generation, const QStringList & existingPaths, const QVector< WadFile > & wadFiles,
+	                     int processedCount, int totalCount );
+	void onAllChecked( uint generation );
+
+	QThreadPool _workerPool;  ///< single thread, the file-system is rarely faster with more of them
+	CancelFlag _cancelFlag;
+	uint _generation = 0;     ///< incremented on every start, to discard the results of the cancelled imports
+	bool _isImporting = false;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // BULK_FILE_IMPORTER_INCLUDED
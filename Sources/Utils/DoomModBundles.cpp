@@ -12,7 +12,13 @@
 #include "ErrorHandling.hpp"
 
 #include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
 #include <QTextStream>
+#include <QStringBuilder>
+#include <QHash>
+#include <QSet>
 
 
 namespace dmb {
@@ -99,6 +105,146 @@ static bool writeContent( const QString & filePath, const DMBContent & content )
 
 static FileInfoCache< DMBContent > g_cachedDMBInfo( readContent, writeContent );
 
+/// Flattened content of a bundle together with everything it was expanded from.
+struct ExpandedBundle
+{
+	QStringList entries;   ///< de-duplicated paths of the files to load, shared with the callers
+	QHash< QString, qint64 > bundles;   ///< all the bundles in the chain (including this one) -> their modification time
+	QStringList cycles;           ///< descriptions of the found cycles, the result depends on where the expansion started
+	bool hasUnreadable = false;   ///< some bundle in the chain could not be read, it should be tried again next time
+
+	bool hasCycle() const  { return !cycles.isEmpty(); }
+};
+
+/// Cached expansions, indexed by normalized bundle path. Not thread-safe, just like the g_cachedDMBInfo.
+static QHash< QString, ExpandedBundle > g_expandedBundles;
+
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// The same bundle can be referred to by different paths (relative to different dirs, with "..", ...),
+/// so the cycle detection and the cache must identify it by an absolute clean path.
+static QString normalizePath( const QString & path )
+{
+	return QDir::cleanPath( fs::getAbsolutePath( path ) );
+}
+
+static qint64 getLastModified( const QString & filePath )
+{
+	return QFileInfo( filePath ).lastModified().toMSecsSinceEpoch();
+}
+
+static bool isUpToDate( const ExpandedBundle & expanded )
+{
+	for (auto iter = expanded.bundles.begin(); iter != expanded.bundles.end(); ++iter)
+		if (getLastModified( iter.key() ) != iter.value())
+			return false;
+	return true;
+}
+
+/// Expands the bundle recursively, re-using the cached expansions of the nested bundles when possible.
+/** \p normPath must be normalized by normalizePath().
+  * \p expansionChain contains the normalized paths of the bundles that are being expanded at the moment,
+  * in order to detect cycles. */
+static ExpandedBundle expandBundle( const QString & filePath, const QString & normPath, QStringList & expansionChain )
+{
+	ExpandedBundle expanded;
+	expanded.bundles.insert( normPath, getLastModified( normPath ) );  // take it before reading, so that later change is noticed
+
+	const std::optional< QStringList > entries = getEntries( filePath );
+	if (!entries)
+	{
+		// This is called everytime the launch command is re-generated, so we don't want to pop up a message box here,
+		// because that would be annoying. However by returning the un-expanded bundle file
+		// we can let the PathChecker decide whether to show an error or not.
+		// The detailed error message about what went wrong is logged to errors.txt.
+		expanded.entries.append( filePath );
+		expanded.hasUnreadable = true;
+		return expanded;
+	}
+
+	// the entries keep the paths from the bundle, only the duplicates are found by the normalized paths
+	QSet< QString > addedEntries;
+	auto addEntry = [&]( const QString & entry, const QString & normEntry )
+	{
+		if (!addedEntries.contains( normEntry ))
+		{
+			addedEntries.insert( normEntry );
+			expanded.entries.append( entry );
+		}
+	};
+
+	expansionChain.append( normPath );
+
+	for (const QString & entry : *entries)
+	{
+		const QString normEntry = normalizePath( entry );
+
+		if (fs::getFileSuffix( entry ) != fileSuffix)
+		{
+			addEntry( entry, normEntry );
+			continue;
+		}
+
+		if (expansionChain.contains( normEntry ))
+		{
+			QString cycle = expansionChain.join(" -> ") % " -> " % normEntry;
+			logRuntimeError() << "Mod Bundle "%normEntry%" includes itself ("%cycle%"), skipping it";
+			expanded.cycles.append( std::move( cycle ) );
+			continue;
+		}
+
+		// An expansion without a cycle doesn't depend on where it started, so it can be shared by all the parent bundles.
+		ExpandedBundle nested;
+		auto cacheIter = g_expandedBundles.find( normEntry );
+		if (cacheIter != g_expandedBundles.end() && !cacheIter->hasCycle() && isUpToDate( *cacheIter ))
+		{
+			nested = *cacheIter;  // only increments the reference counters
+		}
+		else
+		{
+			nested = expandBundle( entry, normEntry, expansionChain );
+			if (!nested.hasCycle() && !nested.hasUnreadable)
+				g_expandedBundles.insert( normEntry, nested );
+		}
+
+		for (const QString & nestedEntry : as_const( nested.entries ))
+			addEntry( nestedEntry, normalizePath( nestedEntry ) );
+		for (auto iter = nested.bundles.begin(); iter != nested.bundles.end(); ++iter)
+			expanded.bundles.insert( iter.key(), iter.value() );
+		expanded.cycles.append( nested.cycles );
+		expanded.hasUnreadable = expanded.hasUnreadable || nested.hasUnreadable;
+	}
+
+	expansionChain.removeLast();
+
+	return expanded;
+}
+
+QStringList getExpandedEntries( const QString & filePath, QStringList * cycles )
+{
+	const QString normPath = normalizePath( filePath );
+
+	// We need this everytime the command is re-generated, which is pretty often, so we better cache it.
+	auto cacheIter = g_expandedBundles.find( normPath );
+	if (cacheIter == g_expandedBundles.end() || !isUpToDate( *cacheIter ))
+	{
+		QStringList expansionChain;
+		ExpandedBundle expanded = expandBundle( filePath, normPath, expansionChain );
+		if (expanded.hasUnreadable)
+		{
+			if (cycles)
+				cycles->append( expanded.cycles );
+			return expanded.entries;
+		}
+		cacheIter = g_expandedBundles.insert( normPath, std::move( expanded ) );
+	}
+
+	if (cycles)
+		cycles->append( cacheIter->cycles );
+	return cacheIter->entries;  // implicitly shared, nothing is copied
+}
+
 std::optional< QStringList > getEntries( const QString & filePath )
 {
 	// We need this everytime the command is re-generated, which is pretty often, so we better cache it.
@@ -111,6 +257,10 @@ std::optional< QStringList > getEntries( const QString & filePath )
 
 bool saveEntries( const QString & filePath, QStringList entries )
 {
+	// The bundle might be nested in other bundles, and the modification time may not change when saved within the same
+	// millisecond, so rather expand everything again.
+	g_expandedBundles.clear();
+
 	return g_cachedDMBInfo.setFileInfo( filePath, DMBContent{ std::move( entries ) } );
 }
 
@@ -26,6 +26,14 @@ extern const QString fileSuffix;   ///< Doom Mod Bundle - a batch of paths of fi
 /** On error it pops up a message box and returns a nullopt. */
 std::optional< QStringList > getEntries( const QString & filePath );
 
+/// Returns paths of all files that a Doom Mod Bundle specified by \p filePath refers to,
+/// with the nested bundles recursively expanded and duplicate entries removed.
+/** The result is cached and re-used until any of the bundles it was expanded from is modified.
+  * A bundle that cannot be read is returned un-expanded, so that the caller can report it as an invalid path.
+  * A bundle that includes itself (directly or through other bundles) is expanded only once and the cycle is logged.
+  * \param cycles If not null, a description of each such cycle is appended to it, so that the caller can show it. */
+QStringList getExpandedEntries( const QString & filePath, QStringList * cycles = nullptr );
+
 /// Saves the given entries into a Doom Mod Bundle specified by \p filePath.
 /** On error it pops up a message box and returns false. */
 bool saveEntries( const QString & filePath, QStringList entries );
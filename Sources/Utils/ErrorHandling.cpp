@@ -7,12 +7,10 @@
 
 #include "ErrorHandling.hpp"
 
-#include "WidgetUtils.hpp"      // HYPERLINK
 #include "OSUtils.hpp"          // getThisLauncherDataDir
 #include "FileSystemUtils.hpp"  // getPathFromFileName
 
 #include <QStringBuilder>
-#include <QMessageBox>
 #include <QDebug>
 #include <QDateTime>
 
@@ -22,14 +20,35 @@
 
 static const QString issuePageUrl = "https://github.com/Youda008/DoomRunner/issues";
 
+static MessageBoxFunc g_messageBoxFunc = nullptr;
+
+void setMessageBoxFunc( MessageBoxFunc func )
+{
+	g_messageBoxFunc = func;
+}
+
+bool showMessageBox( QWidget * parent, MessageBoxType type, const QString & title, const QString & message, bool offerToIgnoreRest )
+{
+	if (!g_messageBoxFunc)
+		return false;
+
+	return g_messageBoxFunc( parent, type, title, message, offerToIgnoreRest );
+}
+
 void reportInformation( QWidget * parent, const QString & title, const QString & message )
 {
-	QMessageBox::information( parent, title, message );
+	if (!g_messageBoxFunc)  // nobody will see it otherwise
+		logInfo().noquote() << message;
+
+	showMessageBox( parent, MessageBoxType::Information, title, message );
 }
 
 void reportUserError( QWidget * parent, const QString & title, const QString & message )
 {
-	QMessageBox::warning( parent, title, message );
+	if (!g_messageBoxFunc)  // nobody will see it otherwise
+		logRuntimeError().noquote() << message;
+
+	showMessageBox( parent, MessageBoxType::Warning, title, message );
 }
 
 void reportRuntimeError( QWidget * parent, const QString & title, const QString & message )
@@ -38,7 +57,7 @@ void reportRuntimeError( QWidget * parent, const QString & title, const QString
 	logStream.noquote() << message;
 	logStream.flush();
 
-	QMessageBox::warning( parent, title, message );
+	showMessageBox( parent, MessageBoxType::Warning, title, message );
 }
 
 // Logic errors should be more detailed, so that we have enough information to debug and fix them.
@@ -48,10 +67,10 @@ void reportLogicError( QWidget * parent, QStringView locationTag, const QString
 	logStream.noquote() << message;
 	logStream.flush();
 
-	QMessageBox::critical( parent, !locationTag.isEmpty() ? (locationTag%": "%title) : title,
+	showMessageBox( parent, MessageBoxType::Critical, !locationTag.isEmpty() ? (locationTag%": "%title) : title,
 		"<html><head/><body>"
 		"<p>"
-			%message%" This is a bug, please create an issue at " HYPERLINK( issuePageUrl, issuePageUrl )
+			%message%" This is a bug, please create an issue at <a href=\""%issuePageUrl%"\">"%issuePageUrl%"</a>"
 		"</p>"
 		"</body></html>"
 	);
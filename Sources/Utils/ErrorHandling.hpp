@@ -32,6 +32,25 @@ class QWidget;
 //======================================================================================================================
 // displaying foreground errors that directly thwart features requested by the user
 
+enum class MessageBoxType
+{
+	Information,
+	Warning,
+	Critical,
+};
+
+/// Displays a message box and waits until the user closes it.
+/** If \p offerToIgnoreRest is true, the box has a check box for ignoring the rest of similar messages,
+  * the return value says whether the user checked it. */
+using MessageBoxFunc = bool (*)( QWidget * parent, MessageBoxType type, const QString & title, const QString & message, bool offerToIgnoreRest );
+
+/// Sets how the errors are displayed to the user, the application sets its Qt Widgets implementation at start-up.
+/** Until then the errors are only logged, so that the code reporting them can be used without the Widgets (in the tests). */
+void setMessageBoxFunc( MessageBoxFunc func );
+
+/// Displays a message box using the function from setMessageBoxFunc(), returns false if there is none.
+bool showMessageBox( QWidget * parent, MessageBoxType type, const QString & title, const QString & message, bool offerToIgnoreRest = false );
+
 /// Reports an event that is not necessarily an error, but is worth noting. (example: no update available)
 /** \param parent Parent widget for the error message box. See https://doc.qt.io/qt-6/qdialog.html#QDialog */
 void reportInformation( QWidget * parent, const QString & title, const QString & message );
@@ -0,0 +1,157 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: pre-loading files into the operating system's cache in a background thread
+//======================================================================================================================
+
+#include "FileCacheWarmer.hpp"
+
+#include <QRunnable>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QByteArray>
+
+#if !IS_WINDOWS && !IS_MACOS
+	#include <fcntl.h>   // open, posix_fadvise
+	#include <unistd.h>  // close
+	#define HAS_FADVISE true
+#else
+	#define HAS_FADVISE false
+#endif
+
+
+//======================================================================================================================
+// background task
+
+/// How long the OS is expected to keep the warmed up files in its cache.
+static constexpr qint64 warmedFileValidityMs = 10 * 60 * 1000;
+
+#if HAS_FADVISE
+
+// Tells the kernel to start reading the whole file into the page cache, it does so asynchronously.
+static bool adviseWillNeed( const QString & filePath )
+{
+	int fd = ::open( QFile::encodeName( filePath ).constData(), O_RDONLY | O_CLOEXEC );
+	if (fd < 0)
+		return false;
+
+	int error = posix_fadvise( fd, 0, 0, POSIX_FADV_WILLNEED );  // closing the file doesn't cancel the read-ahead
+	::close( fd );
+	return error == 0;
+}
+
+#else
+
+// The only portable way, reads the whole file in chunks and discards the data.
+static bool readThrough( const QString & filePath, const std::atomic< bool > & cancelled )
+{
+	QFile file( filePath );
+	if (!file.open( QIODevice::ReadOnly ))
+		return false;
+
+	QByteArray buffer( 1024 * 1024, Qt::Uninitialized );
+	while (file.read( buffer.data(), buffer.size() ) > 0)
+	{
+		if (cancelled)
+			return false;
+	}
+	return true;
+}
+
+#endif // HAS_FADVISE
+
+class WarmUpFilesTask : public QRunnable {
+
+	FileCacheWarmer * _warmer;
+	QStringList _filePaths;
+	FileCacheWarmer::CancelFlag _cancelFlag;
+
+ public:
+
+	WarmUpFilesTask( FileCacheWarmer * warmer, QStringList filePaths, FileCacheWarmer::CancelFlag cancelFlag )
+		: _warmer( warmer ), _filePaths( std::move(filePaths) ), _cancelFlag( std::move(cancelFlag) ) {}
+
+	virtual void run() override
+	{
+		// The pool has a single thread, so the tasks never access _warmedFiles concurrently.
+		auto & warmedFiles = _warmer->_warmedFiles;
+
+		int warmedCount = 0;
+		for (const QString & filePath : as_const( _filePaths ))
+		{
+			if (*_cancelFlag)
+				return;
+
+			QFileInfo fileInfo( filePath );
+			if (!fileInfo.isFile())
+				continue;  // missing files are reported when the command is generated
+
+			const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+			const qint64 now = QDateTime::currentMSecsSinceEpoch();
+			auto warmedIter = warmedFiles.find( filePath );
+			if (warmedIter != warmedFiles.end()
+			 && warmedIter->lastModified == lastModified && now - warmedIter->warmedAt < warmedFileValidityMs)
+			{
+				continue;  // still in the cache most likely
+			}
+
+		 #if HAS_FADVISE
+			bool warmed = adviseWillNeed( filePath );
+		 #else
+			bool warmed = readThrough( filePath, *_cancelFlag );
+		 #endif
+
+			if (warmed)
+			{
+				warmedFiles.insert( filePath, { lastModified, now } );
+				++warmedCount;
+			}
+		}
+
+		_warmer->logDebug() << "warmed up " << warmedCount << " of " << _filePaths.size() << " files";
+	}
+
+};
+
+
+//======================================================================================================================
+// FileCacheWarmer
+
+FileCacheWarmer::FileCacheWarmer()
+:
+	LoggingComponent( u"FileCacheWarmer" ),
+	_cancelFlag( std::make_shared< std::atomic< bool > >( false ) )
+{
+	_workerPool.setMaxThreadCount( 1 );
+}
+
+FileCacheWarmer::~FileCacheWarmer()
+{
+	*_cancelFlag = true;
+	_workerPool.clear();
+	_workerPool.waitForDone();
+}
+
+void FileCacheWarmer::warmUp( QStringList filePaths )
+{
+	cancel();
+
+	if (filePaths.isEmpty())
+		return;
+
+	_cancelFlag = std::make_shared< std::atomic< bool > >( false );
+	_workerPool.start( new WarmUpFilesTask( this, std::move(filePaths), _cancelFlag ) );
+}
+
+void FileCacheWarmer::cancel()
+{
+	*_cancelFlag = true;
+	_workerPool.clear();  // the task that hasn't started yet can be dropped right away
+}
+
+void FileCacheWarmer::waitForDone()
+{
+	_workerPool.waitForDone();
+}
@@ -0,0 +1,70 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: pre-loading files into the operating system's cache in a background thread
+//======================================================================================================================
+
+#ifndef FILE_CACHE_WARMER_INCLUDED
+#define FILE_CACHE_WARMER_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include "ErrorHandling.hpp"  // LoggingComponent
+
+#include <QThreadPool>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <memory>
+
+
+//======================================================================================================================
+/// Asks the operating system to load files into its cache in a worker thread,
+/// so that a program started later doesn't have to wait for a slow disk or a network drive.
+/** Where the OS supports it, this only gives the kernel a hint and it reads the files on its own,
+  * elsewhere the files are read through and the data are thrown away. */
+
+class FileCacheWarmer : protected LoggingComponent {
+
+ public:
+
+	FileCacheWarmer();
+	~FileCacheWarmer();
+
+	/// Starts warming up the files, the unfinished part of the previous request is abandoned.
+	/** The files warmed up recently, which haven't changed since then, are skipped. */
+	void warmUp( QStringList filePaths );
+
+	/// Abandons the unfinished part of the last request.
+	void cancel();
+
+	/// Blocks until the worker thread finishes the last request.
+	void waitForDone();
+
+ private:
+
+	friend class WarmUpFilesTask;
+
+	using CancelFlag = std::shared_ptr< std::atomic< bool > >;
+
+	struct WarmedFile
+	{
+		qint64 lastModified;   ///< modification time of the file when it was warmed up
+		qint64 warmedAt;       ///< when it was warmed up, in milliseconds since epoch
+	};
+
+	QThreadPool _workerPool;  ///< single thread, more of them would only fight for the same disk
+	CancelFlag _cancelFlag;
+	QHash< QString, WarmedFile > _warmedFiles;  ///< accessed only from the worker thread
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // FILE_CACHE_WARMER_INCLUDED
@@ -0,0 +1,186 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: file icons resolved once per suffix and kept in memory
+//======================================================================================================================
+
+#include "FileIconProvider.hpp"
+
+#include "DoomFiles.hpp"  // iwadSuffixes, pwadSuffixes
+#include "DoomModBundles.hpp"  // dmb::fileSuffix
+
+#include <QFileInfo>
+#include <QPixmap>
+#include <QPainter>
+#include <QColor>
+#include <QApplication>
+#include <QStyle>
+#include <QMutexLocker>
+#include <QStringBuilder>
+
+#include <algorithm>  // max
+
+
+//======================================================================================================================
+// file kinds
+
+static const QString dirKey = QStringLiteral("<dir>");
+
+enum class FileKind
+{
+	Directory,
+	WAD,
+	Archive,
+	Dehacked,
+	ModBundle,
+	Other,
+};
+
+static FileKind getFileKind( const QString & suffix, bool isDir )
+{
+	if (isDir)
+		return FileKind::Directory;
+	else if (suffix == dmb::fileSuffix)
+		return FileKind::ModBundle;
+	else if (suffix == "deh" || suffix == "bex" || suffix == "hhe")
+		return FileKind::Dehacked;
+	else if (suffix == "wad" || suffix == "iwad" || suffix == "pwad")
+		return FileKind::WAD;
+	else if (doom::iwadSuffixes.contains( suffix ) || doom::pwadSuffixes.contains( suffix ))
+		return FileKind::Archive;  // pk3, pk7, zip, ...
+	else
+		return FileKind::Other;
+}
+
+/// Icon used when the platform icon theme doesn't know the suffix, which is common for the Doom-specific files.
+static QIcon getFallbackIcon( FileKind kind )
+{
+	QStyle * style = QApplication::style();
+	switch (kind)
+	{
+	 case FileKind::Directory:
+		return style->standardIcon( QStyle::SP_DirIcon );
+	 case FileKind::ModBundle:
+		return style->standardIcon( QStyle::SP_FileDialogListView );
+	 case FileKind::Dehacked:
+		return style->standardIcon( QStyle::SP_FileDialogDetailedView );
+	 default:
+		return style->standardIcon( QStyle::SP_FileIcon );
+	}
+}
+
+/// Strips the icon from unnecessary high-res variants that slow down the painting process.
+static QIcon makeLightweightIcon( const QIcon & origIcon )
+{
+	const auto availableSizes = origIcon.availableSizes();
+	if (availableSizes.isEmpty())
+		return origIcon;
+	return QIcon( origIcon.pixmap( availableSizes.at(0) ) );
+}
+
+static QIcon makeBadgedIcon( const QIcon & baseIcon, const QString & gameName )
+{
+	const auto availableSizes = baseIcon.availableSizes();
+	const QSize size = !availableSizes.isEmpty() ? availableSizes.at(0) : QSize( 16, 16 );
+
+	QPixmap pixmap = baseIcon.pixmap( size );
+	if (pixmap.isNull())
+	{
+		pixmap = QPixmap( size );
+		pixmap.fill( Qt::transparent );
+	}
+
+	// the hue is derived from the name, so that each game keeps its own color between the runs
+	const QColor badgeColor = QColor::fromHsv( int( qHash( gameName ) % 360 ), 200, 230 );
+	const int badgeSize = std::max( size.height() / 2, 6 );
+	const QRect badgeRect( size.width() - badgeSize, size.height() - badgeSize, badgeSize - 1, badgeSize - 1 );
+
+	QPainter painter( &pixmap );
+	painter.setRenderHint( QPainter::Antialiasing );
+	painter.setPen( QPen( QColor( 0, 0, 0, 160 ), 1 ) );
+	painter.setBrush( badgeColor );
+	painter.drawEllipse( badgeRect );
+	painter.end();
+
+	return QIcon( pixmap );
+}
+
+
+//======================================================================================================================
+// FileIconProvider
+
+FileIconProvider::FileIconProvider()
+{
+	setOptions( QFileIconProvider::DontUseCustomDirectoryIcons );  // custom dir icons might cause freezes
+}
+
+QIcon FileIconProvider::icon( IconType type ) const
+{
+	if (type == QFileIconProvider::Folder)
+	{
+		QMutexLocker locker( &_mutex );
+		auto iter = _iconsBySuffix.find( dirKey );
+		if (iter == _iconsBySuffix.end())
+			iter = _iconsBySuffix.insert( dirKey, makeLightweightIcon( QFileIconProvider::icon( type ) ) );
+		return iter.value();
+	}
+	return QFileIconProvider::icon( type );
+}
+
+QIcon FileIconProvider::icon( const QFileInfo & info ) const
+{
+	QMutexLocker locker( &_mutex );
+	return getCachedIcon( info, info.isDir() );
+}
+
+QIcon FileIconProvider::getIcon( const QString & path, bool isDir ) const
+{
+	QMutexLocker locker( &_mutex );
+	return getCachedIcon( QFileInfo( path ), isDir );
+}
+
+QIcon FileIconProvider::getIcon( const QString & path, bool isDir, const QString & gameName ) const
+{
+	if (gameName.isEmpty() || isDir)
+	{
+		return getIcon( path, isDir );
+	}
+
+	QMutexLocker locker( &_mutex );
+
+	const QFileInfo entryInfo( path );
+	QString badgeKey = entryInfo.suffix().toLower() % '\n' % gameName;
+	auto iter = _badgedIcons.find( badgeKey );
+	if (iter == _badgedIcons.end())
+	{
+		iter = _badgedIcons.insert( std::move( badgeKey ), makeBadgedIcon( getCachedIcon( entryInfo, isDir ), gameName ) );
+	}
+	return iter.value();
+}
+
+const QIcon & FileIconProvider::getCachedIcon( const QFileInfo & entryInfo, bool isDir ) const
+{
+	// QFileInfo doesn't touch the file system until it's asked for something else than the parts of the path
+	QString entryID = isDir ? dirKey : entryInfo.suffix().toLower();
+
+	auto iter = _iconsBySuffix.find( entryID );
+	if (iter == _iconsBySuffix.end())
+	{
+		QIcon origIcon = isDir ? QFileIconProvider::icon( QFileIconProvider::Folder ) : QFileIconProvider::icon( entryInfo );
+		if (origIcon.isNull())
+			origIcon = getFallbackIcon( getFileKind( entryID, isDir ) );
+
+		iter = _iconsBySuffix.insert( std::move( entryID ), makeLightweightIcon( origIcon ) );
+	}
+	return iter.value();
+}
+
+
+//======================================================================================================================
+
+FileIconProvider & getFileIconProvider()
+{
+	static FileIconProvider iconProvider;
+	return iconProvider;
+}
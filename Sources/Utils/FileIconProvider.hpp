@@ -0,0 +1,71 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: file icons resolved once per suffix and kept in memory
+//======================================================================================================================
+
+#ifndef FILE_ICON_PROVIDER_INCLUDED
+#define FILE_ICON_PROVIDER_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QFileIconProvider>
+#include <QIcon>
+#include <QHash>
+#include <QString>
+#include <QMutex>
+
+
+//======================================================================================================================
+/// Icon provider that asks the platform icon theme only once per file suffix and then serves the icon from memory.
+/** File icons are mostly determined by the suffix, so there is no need to query the icon theme for every single file,
+  * which is notably slow especially on Windows and with large directories.
+  * The only exception is a file without a suffix on Linux, whose icon can be determined by the file header,
+  * but such files are not used as mods or map packs, so we can ignore that.
+  * Directories are handled separately, because they usually don't have suffixes either.
+  *
+  * The cache is guarded by a mutex, because QFileSystemModel calls the provider from its file gatherer thread. */
+
+class FileIconProvider : public QFileIconProvider {
+
+ public:
+
+	FileIconProvider();
+
+	//-- QFileIconProvider interface, so that this can be set to QFileSystemModel --------------------------------------
+
+	virtual QIcon icon( IconType type ) const override;
+	virtual QIcon icon( const QFileInfo & info ) const override;
+
+	//-- direct API ----------------------------------------------------------------------------------------------------
+
+	/// Returns the icon for a file system entry, whose type the caller already knows.
+	/** Touches the file system only when this suffix has not been seen yet. */
+	QIcon getIcon( const QString & path, bool isDir ) const;
+
+	/// Same as getIcon(), but with a small badge in the corner whose color identifies the game.
+	/** \param gameName Name of the game detected from the WAD, empty means no badge. */
+	QIcon getIcon( const QString & path, bool isDir, const QString & gameName ) const;
+
+ private:
+
+	const QIcon & getCachedIcon( const QFileInfo & entryInfo, bool isDir ) const;
+
+ private:
+
+	mutable QMutex _mutex;
+	mutable QHash< QString, QIcon > _iconsBySuffix;   ///< "<dir>" for directories
+	mutable QHash< QString, QIcon > _badgedIcons;     ///< key is suffix + '\n' + game name
+
+};
+
+/// Instance shared by all models, so that each suffix is resolved only once per process.
+FileIconProvider & getFileIconProvider();
+
+
+//======================================================================================================================
+
+
+#endif // FILE_ICON_PROVIDER_INCLUDED
@@ -90,6 +90,32 @@ class FileInfoCache : protected LoggingComponent {
 		return cacheEntry->fileInfo;
 	}
 
+	/// Returns the cached info only if it's up to date with the given file modification time, otherwise nullptr.
+	/** Never reads the file, so it can be used to decide whether the file needs to be read in a background thread. */
+	const UncertainFileInfo< FileInfo > * findUpToDateFileInfo( const QString & filePath, qint64 fileLastModified ) const
+	{
+		auto cacheIter = _cache.find( filePath );
+		if (cacheIter == _cache.end() || cacheIter->lastModified != fileLastModified)
+			return nullptr;
+
+		const ReadStatus status = cacheIter->fileInfo.status;
+		if (status == ReadStatus::CantOpen || status == ReadStatus::FailedToRead || status == ReadStatus::Uninitialized)
+			return nullptr;
+
+		return &cacheIter->fileInfo;
+	}
+
+	/// Stores an info that has been read from the file elsewhere (for example in a background thread).
+	/** \param fileLastModified Modification time of the file at the moment when the info was read. */
+	void storeFileInfo( const QString & filePath, UncertainFileInfo< FileInfo > fileInfo, qint64 fileLastModified )
+	{
+		Entry & newEntry = _cache.insert( filePath, {} ).value();
+
+		newEntry.fileInfo = std::move( fileInfo );
+		newEntry.lastModified = fileLastModified;
+		_dirty = true;
+	}
+
 	/// Manually updates a record in the cache and writes the content to the corresponding file.
 	/** Returns false if the content couldn't be written to the file. */
 	bool setFileInfo( const QString & filePath, FileInfo fileInfo )
@@ -14,6 +14,7 @@
 #include <QFile>
 #include <QSaveFile>
 #include <QStringBuilder>
+#include <QStringView>
 #include <QTextStream>
 #include <QRegularExpression>
 #include <QThread>  // sleep
@@ -234,3 +235,90 @@ void traverseDirectory(
 
 
 } // namespace fs
+
+
+//======================================================================================================================
+// PathBaseDir
+
+// Whether QDir::cleanPath() would keep the path unchanged and it needs no special treatment,
+// that is no "." or ".." elements, no redundant or trailing separators, no backslashes and no Windows drive tricks.
+static bool isSimpleCleanPath( QStringView path )
+{
+	if (path.isEmpty() || path.endsWith( u'/' ))
+		return false;
+
+	qsize_t elemStart = 0;
+	if constexpr (IS_WINDOWS)
+	{
+		// only "C:/..." absolute paths, the rooted paths without a drive and the drive-relative paths are left to QDir
+		if (path.startsWith( u'/' ))
+			return false;
+		if (path.size() >= 2 && path[1] == u':')
+		{
+			if (path.size() < 4 || path[2] != u'/')
+				return false;
+			elemStart = 3;
+		}
+	}
+	else
+	{
+		if (path.startsWith( u'/' ))
+			elemStart = 1;
+	}
+
+	for (qsize_t pos = elemStart; pos <= path.size(); ++pos)
+	{
+		if (pos == path.size() || path[ pos ] == u'/')
+		{
+			QStringView elem = path.mid( elemStart, pos - elemStart );
+			if (elem.isEmpty() || elem == u"." || elem == u"..")
+				return false;
+			elemStart = pos + 1;
+		}
+		else if (path[ pos ] == u'\\' || (IS_WINDOWS && path[ pos ] == u':'))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+QString PathBaseDir::makePathAbsolute( const QString & path ) const
+{
+	if (isSimpleCleanPath( path ))
+	{
+		if (QDir::isAbsolutePath( path ))
+			return path;
+		else if (_absPath.endsWith( '/' ))  // root dir
+			return _absPath % path;
+		else
+			return _absPath % '/' % path;
+	}
+
+	return PathConvertor::makePathAbsolute( path, _dir );
+}
+
+QString PathBaseDir::makePathRelative( const QString & path ) const
+{
+	if (isSimpleCleanPath( path ))
+	{
+		if (QDir::isRelativePath( path ))
+			return path;  // QDir returns clean relative paths as they are
+
+		// The comparison is case-sensitive even where QDir's isn't, the mismatches simply go the slow way.
+		const qsize_t baseLen = _absPath.size();
+		if (_absPath.endsWith( '/' ))  // root dir
+		{
+			if (path.startsWith( _absPath ))
+				return path.mid( baseLen );
+		}
+		else if (path.size() > baseLen && path[ baseLen ] == '/' && path.startsWith( _absPath ))
+		{
+			return path.mid( baseLen + 1 );
+		}
+	}
+
+	// the path is outside of the base dir and needs "..", or it's not clean
+	return PathConvertor::makePathRelativeTo( path, _dir );
+}
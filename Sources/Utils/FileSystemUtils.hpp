@@ -254,12 +254,50 @@ void traverseDirectory(
 } // namespace fs
 
 
+//======================================================================================================================
+/** Base directory for path conversions with its cleaned absolute path computed in advance.
+  * The common cases (clean paths inside the base dir) are converted by plain string operations,
+  * only the rest ("." or ".." elements, paths outside the base dir) goes through the QDir algorithms. */
+
+class PathBaseDir {
+
+	QDir _dir;
+	QString _absPath;  ///< cleaned absolute path of _dir
+
+ public:
+
+	PathBaseDir( const QString & path )
+		: _dir( path ) { updateAbsPath(); }
+
+	PathBaseDir( const PathBaseDir & other ) = default;
+	PathBaseDir( PathBaseDir && other ) = default;
+	PathBaseDir & operator=( const PathBaseDir & other ) = default;
+	PathBaseDir & operator=( PathBaseDir && other ) = default;
+
+	const QDir & dir() const                  { return _dir; }
+	const QString & absolutePath() const      { return _absPath; }
+
+	void setPath( const QString & path )      { _dir.setPath( path ); updateAbsPath(); }
+	void makeAbsolute()                       { _dir.makeAbsolute(); updateAbsPath(); }
+
+	/// Same result as QDir::cleanPath( dir.absoluteFilePath( path ) ).
+	QString makePathAbsolute( const QString & path ) const;
+
+	/// Same result as dir.relativeFilePath( path ).
+	QString makePathRelative( const QString & path ) const;
+
+ private:
+
+	void updateAbsPath()                      { _absPath = QDir::cleanPath( _dir.absolutePath() ); }
+
+};
+
 //======================================================================================================================
 /** Helper for calculating relative and absolute paths according to a working directory and path style settings. */
 
 class PathConvertor {
 
-	QDir _workingDir;  ///< directory which relative paths are relative to
+	PathBaseDir _workingDir;  ///< directory which relative paths are relative to
 	PathStyle _pathStyle;  ///< whether to store paths to engines, IWADs, maps and mods in absolute or relative form
 
  public:
@@ -278,7 +316,7 @@ class PathConvertor {
 	PathConvertor & operator=( const PathConvertor & other ) = default;
 	PathConvertor & operator=( PathConvertor && other ) = default;
 
-	const QDir & workingDir() const                    { return _workingDir; }
+	const QDir & workingDir() const                    { return _workingDir.dir(); }
 	PathStyle pathStyle() const                        { return _pathStyle; }
 	bool usingAbsolutePaths() const                    { return _pathStyle.isAbsolute(); }
 	bool usingRelativePaths() const                    { return _pathStyle.isRelative(); }
@@ -289,11 +327,11 @@ class PathConvertor {
 
 	QString getAbsolutePath( const QString & path ) const
 	{
-		return !path.isEmpty() ? makePathAbsolute( path, _workingDir ) : QString();
+		return !path.isEmpty() ? _workingDir.makePathAbsolute( path ) : QString();
 	}
 	QString getRelativePath( const QString & path ) const
 	{
-		return !path.isEmpty() ? makePathRelativeTo( path, _workingDir ) : QString();
+		return !path.isEmpty() ? _workingDir.makePathRelative( path ) : QString();
 	}
 	QString convertPath( const QString & path, PathStyle pathStyle ) const
 	{
@@ -321,9 +359,9 @@ class PathConvertor {
 		return baseDir.relativeFilePath( inputPath );
 	}
 
-	static QString convertPath( const QString & path, const QDir & baseDir, PathStyle pathStyle )
+	static QString convertPath( const QString & path, const PathBaseDir & baseDir, PathStyle pathStyle )
 	{
-		return pathStyle.isAbsolute() ? makePathAbsolute( path, baseDir ) : makePathRelativeTo( path, baseDir );
+		return pathStyle.isAbsolute() ? baseDir.makePathAbsolute( path ) : baseDir.makePathRelative( path );
 	}
 
 };
@@ -333,8 +371,8 @@ class PathConvertor {
 
 class PathRebaser {
 
-	QDir _origBaseDir;    ///< original base dir for the relative input paths
-	QDir _targetBaseDir;   ///< target base dir for the relative output paths
+	PathBaseDir _origBaseDir;    ///< original base dir for the relative input paths
+	PathBaseDir _targetBaseDir;   ///< target base dir for the relative output paths
 	std::optional< PathStyle > _reqPathStyle;   ///< required output path style - if set, paths will be converted to this style
 	bool _quotePaths;  ///< whether to surround all output paths with quotes (needed when generating a batch)
 
@@ -348,8 +386,8 @@ class PathRebaser {
 	PathRebaser & operator=( const PathRebaser & other ) = default;
 	PathRebaser & operator=( PathRebaser && other ) = default;
 
-	const QDir & origBaseDir() const                   { return _origBaseDir; }
-	const QDir & targetBaseDir() const                 { return _targetBaseDir; }
+	const QDir & origBaseDir() const                   { return _origBaseDir.dir(); }
+	const QDir & targetBaseDir() const                 { return _targetBaseDir.dir(); }
 	auto requiredPathStyle() const                     { return _reqPathStyle; }
 	bool requiresAbsolutePaths() const                 { return _reqPathStyle && _reqPathStyle->isAbsolute(); }
 	bool requiresRelativePaths() const                 { return _reqPathStyle && _reqPathStyle->isRelative(); }
@@ -452,29 +490,29 @@ class PathRebaser {
  private:
 
 	// Keeps the path style of the input path, only performs the rebasing if it's a relative path.
-	static QString rebaseFromTo( const QString & inPath, const QDir & inBaseDir, const QDir & outBaseDir )
+	static QString rebaseFromTo( const QString & inPath, const PathBaseDir & inBaseDir, const PathBaseDir & outBaseDir )
 	{
 		if (inPath.isEmpty() || fs::isAbsolutePath( inPath ))
 			return inPath;
 
-		QString absPath = PathConvertor::makePathAbsolute( inPath, inBaseDir );
-		QString outPath = PathConvertor::makePathRelativeTo( absPath, outBaseDir );
+		QString absPath = inBaseDir.makePathAbsolute( inPath );
+		QString outPath = outBaseDir.makePathRelative( absPath );
 
 		return outPath;
 	}
 
 	// Rebases the path and converts it to absolute or relative based on the requiredPathStyle parameter, if it is set.
 	static QString convertAndRebaseFromTo(
-		const QString & inPath, const QDir & inBaseDir, const QDir & outBaseDir, std::optional< PathStyle > requiredPathStyle
+		const QString & inPath, const PathBaseDir & inBaseDir, const PathBaseDir & outBaseDir, std::optional< PathStyle > requiredPathStyle
 	){
 		if (inPath.isEmpty())
 			return {};
 
 		PathStyle inPathStyle = fs::getPathStyle( inPath );
-		QString absPath = inPathStyle.isAbsolute() ? inPath : PathConvertor::makePathAbsolute( inPath, inBaseDir );
+		QString absPath = inPathStyle.isAbsolute() ? inPath : inBaseDir.makePathAbsolute( inPath );
 
 		PathStyle outPathStyle = requiredPathStyle ? *requiredPathStyle : inPathStyle;
-		QString outPath = outPathStyle.isAbsolute() ? absPath : PathConvertor::makePathRelativeTo( absPath, outBaseDir );
+		QString outPath = outPathStyle.isAbsolute() ? absPath : outBaseDir.makePathRelative( absPath );
 
 		return outPath;
 	}
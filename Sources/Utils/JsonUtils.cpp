@@ -12,8 +12,6 @@
 
 #include <QStringBuilder>
 #include <QTextStream>
-#include <QMessageBox>
-#include <QCheckBox>
 #include <QDebug>
 
 
@@ -432,17 +430,6 @@ QString JsonArrayCtx::getString( qsize_t index, QString defaultVal, bool showErr
 //======================================================================================================================
 // error handling
 
-static bool checkableMessageBox( QMessageBox::Icon icon, const QString & title, const QString & message )
-{
-	QMessageBox msgBox( icon, title, message, QMessageBox::Ok );
-	QCheckBox * chkBox = new QCheckBox( "ignore the rest of these warnings" );
-	msgBox.setCheckBox( chkBox );  // msgBox takes ownership of chkBox
-
-	msgBox.exec();
-
-	return chkBox->isChecked();
-}
-
 static const char * JsonTypeStrings [] =
 {
 	"Null",
@@ -470,7 +457,7 @@ void JsonObjectCtx::missingKey( const QString & key, bool showError ) const
 	if (showError)
 	{
 		if (!_context->dontShowAgain)
-			_context->dontShowAgain = checkableMessageBox( QMessageBox::Warning, "Error loading JSON file", message );
+			_context->dontShowAgain = showMessageBox( nullptr, MessageBoxType::Warning, "Error loading JSON file", message, /*offerToIgnoreRest*/ true );
 		logRuntimeError( u"JsonObjectCtx" ).noquote() << message;
 	}
 }
@@ -487,7 +474,7 @@ void JsonArrayCtx::indexOutOfBounds( qsize_t index, bool showError ) const
 	if (showError)
 	{
 		if (!_context->dontShowAgain)
-			_context->dontShowAgain = checkableMessageBox( QMessageBox::Critical, "Error loading JSON file", message );
+			_context->dontShowAgain = showMessageBox( nullptr, MessageBoxType::Critical, "Error loading JSON file", message, /*offerToIgnoreRest*/ true );
 		logRuntimeError( u"JsonArrayCtx" ).noquote() << message;
 	}
 }
@@ -504,7 +491,7 @@ void JsonObjectCtx::invalidTypeAtKey( const QString & key, const QString & expec
 	if (showError)
 	{
 		if (!_context->dontShowAgain)
-			_context->dontShowAgain = checkableMessageBox( QMessageBox::Warning, "Error loading JSON file", message );
+			_context->dontShowAgain = showMessageBox( nullptr, MessageBoxType::Warning, "Error loading JSON file", message, /*offerToIgnoreRest*/ true );
 		logRuntimeError( u"JsonObjectCtx" ).noquote() << message;
 	}
 }
@@ -521,7 +508,7 @@ void JsonArrayCtx::invalidTypeAtIdx( qsize_t index, const QString & expectedType
 	if (showError)
 	{
 		if (!_context->dontShowAgain)
-			_context->dontShowAgain = checkableMessageBox( QMessageBox::Warning, "Error loading JSON file", message );
+			_context->dontShowAgain = showMessageBox( nullptr, MessageBoxType::Warning, "Error loading JSON file", message, /*offerToIgnoreRest*/ true );
 		logRuntimeError( u"JsonArrayCtx" ).noquote() << message;
 	}
 }
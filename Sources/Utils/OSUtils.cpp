@@ -12,7 +12,7 @@
 #include "ErrorHandling.hpp"
 
 #include <QStandardPaths>
-#include <QApplication>
+#include <QCoreApplication>
 #include <QGuiApplication>
 #include <QDesktopServices>  // fallback for openFileLocation
 #include <QUrl>
@@ -20,13 +20,49 @@
 #include <QRegularExpression>
 #include <QScreen>
 #include <QProcess>
+#include <QProcessEnvironment>
+#include <QFile>
+#include <QSet>
+#include <QHash>
+#include <QSocketNotifier>
 
 #if IS_WINDOWS
 	#include <windows.h>
 	#include <shlobj.h>
+#elif !IS_MACOS
+	#include <spawn.h>
+	#include <sys/wait.h>
+	#include <signal.h>  // sigaction
+	#include <fcntl.h>   // O_CLOEXEC, O_NONBLOCK
+	#include <unistd.h>  // pipe2, read, write
+	#include <cerrno>
+	#include <cstring>  // strerror, strncmp
+	#include <thread>
+	#include <atomic>
+	extern char ** environ;
+	// posix_spawn_file_actions_addchdir_np() and POSIX_SPAWN_SETSID are required to do what QProcess::startDetached() does
+	#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+		#define CAN_SPAWN_DETACHED true
+	#endif
+	#if defined(__linux__)
+		#include <sched.h>         // sched_setaffinity, sched_setscheduler
+		#include <sys/resource.h>  // setpriority
+		#include <sys/syscall.h>   // SYS_ioprio_set, glibc has no wrapper for it
+		#include <unistd.h>        // syscall
+		#include <cerrno>
+		#define CAN_SET_SCHEDULING true
+	#endif
+#endif
+#ifndef CAN_SPAWN_DETACHED
+	#define CAN_SPAWN_DETACHED false
+#endif
+#ifndef CAN_SET_SCHEDULING
+	#define CAN_SET_SCHEDULING false
 #endif
 
 #include <memory>
+#include <vector>
+#include <algorithm>
 
 
 namespace os {
@@ -251,7 +287,7 @@ QString getThisLauncherDataDir()
 
 	if constexpr (IS_WINDOWS)
 	{
-		QString thisExeDir = QApplication::applicationDirPath();
+		QString thisExeDir = QCoreApplication::applicationDirPath();
 		if (fs::isDirectoryWritable( thisExeDir ))
 		{
 			printInfo() << "Saving data (options, cache, errors) into the install directory ("<<thisExeDir<<")";
@@ -636,7 +672,7 @@ ShellCommand getRunCommand(
 
 	// different installations require different ways to launch the program executable
  #if IS_FLATPAK_BUILD
-	if (fs::getAbsoluteParentDir( executablePath ) == QApplication::applicationDirPath())
+	if (fs::getAbsoluteParentDir( executablePath ) == QCoreApplication::applicationDirPath())
 	{
 		// We are inside a Flatpak package but launching an app inside the same Flatpak package,
 		// no special command or permissions needed.
@@ -905,6 +941,453 @@ bool openFileInNotepad( const QString & filePath )
 }
 
 
+//======================================================================================================================
+// starting processes
+
+const QProcessEnvironment & getCachedSystemEnvironment()
+{
+	// The launcher's environment doesn't change while it's running, no need to query it again on every launch.
+	static const QProcessEnvironment systemEnv = QProcessEnvironment::systemEnvironment();
+	return systemEnv;
+}
+
+QProcessEnvironment makeProcessEnvironment( const QList< EnvVar > & envVars )
+{
+	QProcessEnvironment env = getCachedSystemEnvironment();
+	for (const auto & envVar : envVars)
+	{
+		env.insert( envVar.name, envVar.value );
+	}
+	return env;
+}
+
+bool canSpawnDetachedProcess()
+{
+	return CAN_SPAWN_DETACHED;
+}
+
+#if CAN_SPAWN_DETACHED
+
+// Unlike with QProcess::startDetached(), the spawned processes are our direct children, so someone has to collect their
+// exit status, otherwise they would remain zombies until the launcher exits. Instead of a thread waiting for each of
+// them, a single SIGCHLD handler reaps all of them. It must not steal the exit status of the QProcess children,
+// so it waits only for the PIDs registered here, and then passes the signal to the previously installed handler.
+
+struct ReapedChild
+{
+	pid_t pid;
+	int status;
+};
+
+constexpr pid_t reservedChildSlot = -1;
+
+static std::atomic< pid_t > spawnedChildren [64];   ///< PIDs of the running children, 0 marks a free slot
+static int reapedChildrenPipe [2] = { -1, -1 };     ///< passes the exit statuses from the signal handler to the main thread
+static struct sigaction prevChildHandler;
+static QHash< pid_t, ProcessExitCallback > exitCallbacks;  ///< accessed only from the main thread
+
+// Called from both the signal handler and the main thread, so it may use only async-signal-safe functions.
+static void reapSpawnedChildren()
+{
+	for (auto & slot : spawnedChildren)
+	{
+		pid_t pid = slot.load();
+		if (pid <= 0)
+			continue;
+
+		ReapedChild child = { pid, 0 };
+		if (waitpid( pid, &child.status, WNOHANG ) != pid)
+			continue;  // still running, or it has just been reaped by the other caller
+
+		slot.store( 0 );
+		ssize_t written = write( reapedChildrenPipe[1], &child, sizeof(child) );  // smaller than PIPE_BUF, so it's atomic
+		(void)written;  // nothing can be done about it in a signal handler
+	}
+}
+
+static void onChildSignal( int signal, siginfo_t * info, void * context )
+{
+	int origErrno = errno;  // the interrupted code might be just checking it
+	reapSpawnedChildren();
+	errno = origErrno;
+
+	if (prevChildHandler.sa_flags & SA_SIGINFO)
+	{
+		if (prevChildHandler.sa_sigaction)
+			prevChildHandler.sa_sigaction( signal, info, context );
+	}
+	else if (prevChildHandler.sa_handler != SIG_DFL && prevChildHandler.sa_handler != SIG_IGN)
+	{
+		prevChildHandler.sa_handler( signal );
+	}
+}
+
+static void deliverExitStatuses()
+{
+	ReapedChild child;
+	while (read( reapedChildrenPipe[0], &child, sizeof(child) ) == sizeof(child))
+	{
+		ProcessExitCallback onExit = exitCallbacks.take( child.pid );
+		if (!onExit)
+			continue;
+
+		if (WIFEXITED( child.status ))
+			onExit( WEXITSTATUS( child.status ) );
+		else if (WIFSIGNALED( child.status ))
+			onExit( -1 );
+	}
+}
+
+/// Installs the SIGCHLD handler on the first call, returns description of an error or empty string on success.
+static QString initChildReaper()
+{
+	static const QString initError = []() -> QString
+	{
+		if (pipe2( reapedChildrenPipe, O_CLOEXEC | O_NONBLOCK ) != 0)
+			return QString::fromLocal8Bit( strerror( errno ) );
+
+		// Created in the main thread, which spawns the processes, so the statuses are delivered by its event loop.
+		auto * notifier = new QSocketNotifier( reapedChildrenPipe[0], QSocketNotifier::Read );
+		QObject::connect( notifier, &QSocketNotifier::activated, []() { deliverExitStatuses(); } );
+
+		struct sigaction action = {};
+		action.sa_sigaction = &onChildSignal;
+		action.sa_flags = SA_SIGINFO | SA_RESTART | SA_NOCLDSTOP;
+		sigemptyset( &action.sa_mask );
+		if (sigaction( SIGCHLD, &action, &prevChildHandler ) != 0)
+			return QString::fromLocal8Bit( strerror( errno ) );
+
+		return {};
+	}();
+	return initError;
+}
+
+static std::atomic< pid_t > * reserveChildSlot()
+{
+	for (auto & slot : spawnedChildren)
+	{
+		pid_t freeSlot = 0;
+		if (slot.compare_exchange_strong( freeSlot, reservedChildSlot ))
+			return &slot;
+	}
+	return nullptr;
+}
+
+#endif // CAN_SPAWN_DETACHED
+
+QString spawnDetachedProcess(
+	const QString & executable, const QStringList & arguments, const QString & workingDir, const QList< EnvVar > & envVars,
+	const ProcessScheduling & scheduling, QString * schedulingError, ProcessExitCallback onExit
+){
+ #if CAN_SPAWN_DETACHED
+
+	QString reaperError = initChildReaper();
+	if (!reaperError.isEmpty())
+	{
+		return "Cannot collect the exit status of the process ("%reaperError%")";
+	}
+	std::atomic< pid_t > * childSlot = reserveChildSlot();
+	if (!childSlot)
+	{
+		return "Too many processes started from the launcher are still running";
+	}
+
+	// everything must be prepared before spawning, the child cannot allocate memory
+	QByteArray exeBytes = QFile::encodeName( executable );
+	QList< QByteArray > argBytes;
+	argBytes.reserve( arguments.size() );
+	for (const QString & arg : arguments)
+		argBytes.append( arg.toLocal8Bit() );
+
+	std::vector< char * > argv;
+	argv.reserve( size_t( argBytes.size() ) + 2 );
+	argv.push_back( exeBytes.data() );
+	for (QByteArray & arg : argBytes)
+		argv.push_back( arg.data() );
+	argv.push_back( nullptr );
+
+	// Instead of building the whole environment from scratch, pass the launcher's own one and apply only the differences.
+	char ** childEnv = environ;
+	QList< QByteArray > overrides;
+	std::vector< char * > envp;
+	if (!envVars.isEmpty())
+	{
+		auto isSameVar = []( const char * var1, const QByteArray & var2 )
+		{
+			int nameLen = int( var2.indexOf('=') );
+			return strncmp( var1, var2.constData(), size_t( nameLen + 1 ) ) == 0;
+		};
+
+		for (const auto & envVar : envVars)
+		{
+			QByteArray varBytes = envVar.name.toLocal8Bit() + '=' + envVar.value.toLocal8Bit();
+			auto overrideIter = std::find_if( overrides.begin(), overrides.end(), [&]( const QByteArray & other )
+			{
+				return isSameVar( other.constData(), varBytes );
+			});
+			if (overrideIter != overrides.end())
+				*overrideIter = std::move( varBytes );  // the later definition wins, same as in QProcessEnvironment
+			else
+				overrides.append( std::move( varBytes ) );
+		}
+
+		for (char ** var = environ; *var; ++var)
+		{
+			bool isOverridden = std::any_of( overrides.begin(), overrides.end(), [&]( const QByteArray & overrideVar )
+			{
+				return isSameVar( *var, overrideVar );
+			});
+			if (!isOverridden)
+				envp.push_back( *var );
+		}
+		for (QByteArray & overrideVar : overrides)
+			envp.push_back( overrideVar.data() );
+		envp.push_back( nullptr );
+
+		childEnv = envp.data();
+	}
+
+	QByteArray workingDirBytes = QFile::encodeName( workingDir );
+
+	posix_spawn_file_actions_t fileActions;
+	posix_spawn_file_actions_init( &fileActions );
+	if (!workingDirBytes.isEmpty())
+		posix_spawn_file_actions_addchdir_np( &fileActions, workingDirBytes.constData() );
+
+	posix_spawnattr_t attributes;
+	posix_spawnattr_init( &attributes );
+	posix_spawnattr_setflags( &attributes, POSIX_SPAWN_SETSID );  // don't get killed together with the launcher's terminal
+
+	// posix_spawnp() searches the PATH for the executable like QProcess does, and glibc reports exec errors directly
+	pid_t pid = 0;
+	int error = 0;
+
+	if (scheduling.isDefault())
+	{
+		error = posix_spawnp( &pid, exeBytes.constData(), &fileActions, &attributes, argv.data(), childEnv );
+	}
+	else
+	{
+		// The scheduling attributes are inherited from the thread that spawns the process, so spawn it from a dedicated
+		// thread that applies them to itself first. Unlike changing them after the process has started, this has no race
+		// with the threads the process creates, and the launcher's own threads remain unaffected.
+		QString schedError;
+		std::thread spawningThread( [&]()
+		{
+			schedError = setProcessScheduling( 0, scheduling );
+			error = posix_spawnp( &pid, exeBytes.constData(), &fileActions, &attributes, argv.data(), childEnv );
+		});
+		spawningThread.join();
+
+		if (schedulingError)
+			*schedulingError = std::move( schedError );
+	}
+
+	if (error == 0)
+	{
+		if (onExit)
+			exitCallbacks.insert( pid, std::move( onExit ) );
+		childSlot->store( pid );
+		reapSpawnedChildren();  // it might have exited before it was registered, then its SIGCHLD has been missed
+	}
+	else
+	{
+		childSlot->store( 0 );
+	}
+
+	posix_spawnattr_destroy( &attributes );
+	posix_spawn_file_actions_destroy( &fileActions );
+
+	if (error != 0)
+	{
+		return QString::fromLocal8Bit( strerror( error ) );
+	}
+
+	return {};
+
+ #else
+
+	(void)executable; (void)arguments; (void)workingDir; (void)envVars; (void)scheduling; (void)schedulingError; (void)onExit;
+	return "Spawning processes directly is not supported on this system.";
+
+ #endif // CAN_SPAWN_DETACHED
+}
+
+bool canSetProcessScheduling()
+{
+	return CAN_SET_SCHEDULING;
+}
+
+#if CAN_SET_SCHEDULING
+
+// the kernel's ioprio constants, they are not exported in any userspace header
+constexpr int IOPRIO_WHO_PROCESS_ = 1;
+constexpr int IOPRIO_CLASS_SHIFT_ = 13;
+constexpr int IOPRIO_CLASS_BE_ = 2;
+constexpr int IOPRIO_CLASS_IDLE_ = 3;
+
+/// Parses a list of CPUs in the taskset format ("0-3,6") into a CPU set.
+static bool parseCpuList( const QString & cpuList, cpu_set_t & cpuSet )
+{
+	CPU_ZERO( &cpuSet );
+
+	const QStringList ranges = cpuList.split( ',', Qt::SkipEmptyParts );
+	for (const QString & range : ranges)
+	{
+		qsize_t dashPos = range.indexOf( '-' );
+		bool firstValid = true, lastValid = true;
+		int first = range.left( dashPos ).trimmed().toInt( &firstValid );  // left(-1) returns the whole string
+		int last = dashPos >= 0 ? range.mid( dashPos + 1 ).trimmed().toInt( &lastValid ) : first;
+		if (!firstValid || !lastValid || first < 0 || last < first || last >= CPU_SETSIZE)
+		{
+			return false;
+		}
+		for (int cpu = first; cpu <= last; ++cpu)
+		{
+			CPU_SET( cpu, &cpuSet );
+		}
+	}
+
+	return CPU_COUNT( &cpuSet ) > 0;
+}
+
+static QString describeLastError( const char * what )
+{
+	return QStringLiteral("failed to set %1 (%2)").arg( what, QString::fromLocal8Bit( strerror( errno ) ) );
+}
+
+/// Applies the scheduling options to a single thread, 0 means the calling thread.
+static QString setThreadScheduling( pid_t tid, const ProcessScheduling & scheduling )
+{
+	// Each of these calls affects only the thread with the given ID, even when it's a process ID.
+	// The threads started later inherit the attributes from the thread that started them.
+	QString firstError;
+
+	if (!scheduling.cpuAffinity.isEmpty())
+	{
+		cpu_set_t cpuSet;
+		if (!parseCpuList( scheduling.cpuAffinity, cpuSet ))
+			firstError = "invalid CPU list \"" % scheduling.cpuAffinity % "\"";
+		else if (sched_setaffinity( tid, sizeof(cpuSet), &cpuSet ) != 0)
+			firstError = describeLastError( "CPU affinity" );
+	}
+
+	if (scheduling.schedPolicy != SchedPolicy::Default)
+	{
+		int policy = scheduling.schedPolicy == SchedPolicy::Batch ? SCHED_BATCH
+		           : scheduling.schedPolicy == SchedPolicy::Idle  ? SCHED_IDLE
+		           :                                                SCHED_OTHER;
+		struct sched_param param = {};  // the static priority must be 0 for all the non-realtime policies
+		if (sched_setscheduler( tid, policy, &param ) != 0 && firstError.isEmpty())
+			firstError = describeLastError( "scheduling policy" );
+	}
+
+	// sched_setscheduler() keeps the nice value, so the order doesn't matter
+	if (scheduling.niceLevel != 0)
+	{
+		if (setpriority( PRIO_PROCESS, id_t( tid ), scheduling.niceLevel ) != 0 && firstError.isEmpty())
+			firstError = describeLastError( "nice level" );
+	}
+
+	if (scheduling.ioPrioClass != IOPrioClass::Default)
+	{
+		int ioPrio = scheduling.ioPrioClass == IOPrioClass::Idle
+		             ? IOPRIO_CLASS_IDLE_ << IOPRIO_CLASS_SHIFT_  // the idle class has no levels
+		             : (IOPRIO_CLASS_BE_ << IOPRIO_CLASS_SHIFT_) | qBound( 0, scheduling.ioPrioLevel, 7 );
+		if (syscall( SYS_ioprio_set, IOPRIO_WHO_PROCESS_, int( tid ), ioPrio ) != 0 && firstError.isEmpty())
+			firstError = describeLastError( "I/O priority" );
+	}
+
+	return firstError;
+}
+
+#endif // CAN_SET_SCHEDULING
+
+QString setProcessScheduling( qint64 pid, const ProcessScheduling & scheduling )
+{
+ #if CAN_SET_SCHEDULING
+
+	if (pid == 0)
+	{
+		return setThreadScheduling( 0, scheduling );
+	}
+
+	// The process may have already started other threads, which would keep the original attributes,
+	// so they have to be applied to every thread listed in /proc/<pid>/task. Threads can be started while we iterate,
+	// therefore repeat the listing until it contains no thread that hasn't been processed yet.
+	const QString taskDir = "/proc/" % QString::number( pid ) % "/task";
+	QSet< QString > processedThreads;
+	QString firstError;
+	for (int pass = 0; pass < 10; ++pass)  // a limit for a process that keeps starting threads indefinitely
+	{
+		const QStringList threadIDs = QDir( taskDir ).entryList( QDir::Dirs | QDir::NoDotAndDotDot );
+		bool foundNewThread = false;
+		for (const QString & threadIDStr : threadIDs)
+		{
+			if (processedThreads.contains( threadIDStr ))
+				continue;
+			processedThreads.insert( threadIDStr );
+			foundNewThread = true;
+
+			bool isValid = false;
+			pid_t tid = pid_t( threadIDStr.toInt( &isValid ) );
+			if (!isValid)
+				continue;
+
+			QString error = setThreadScheduling( tid, scheduling );
+			if (!error.isEmpty() && firstError.isEmpty() && QDir( taskDir ).exists( threadIDStr ))  // ignore threads that have already exited
+				firstError = std::move( error );
+		}
+		if (!foundNewThread)
+			break;
+	}
+
+	if (processedThreads.isEmpty())  // /proc is not mounted or the process has already exited
+	{
+		firstError = setThreadScheduling( pid_t( pid ), scheduling );
+	}
+
+	return firstError;
+
+ #else
+
+	(void)pid;
+	return scheduling.isDefault() ? QString() : "Process scheduling options are not supported on this system.";
+
+ #endif // CAN_SET_SCHEDULING
+}
+
+QStringList getSchedulingCommandPrefix( const ProcessScheduling & scheduling )
+{
+	// Each of these tools applies its setting to itself and then executes the rest of the command line.
+	QStringList prefix;
+
+	if (!scheduling.cpuAffinity.isEmpty())
+	{
+		prefix << "taskset" << "-c" << scheduling.cpuAffinity;
+	}
+
+	if (scheduling.schedPolicy == SchedPolicy::Normal)
+		prefix << "chrt" << "--other" << "0";
+	else if (scheduling.schedPolicy == SchedPolicy::Batch)
+		prefix << "chrt" << "--batch" << "0";
+	else if (scheduling.schedPolicy == SchedPolicy::Idle)
+		prefix << "chrt" << "--idle" << "0";
+
+	if (scheduling.niceLevel != 0)
+	{
+		prefix << "nice" << "-n" << QString::number( scheduling.niceLevel );
+	}
+
+	if (scheduling.ioPrioClass == IOPrioClass::BestEffort)
+		prefix << "ionice" << "-c" << "2" << "-n" << QString::number( qBound( 0, scheduling.ioPrioLevel, 7 ) );
+	else if (scheduling.ioPrioClass == IOPrioClass::Idle)
+		prefix << "ionice" << "-c" << "3";
+
+	return prefix;
+}
+
+
 //======================================================================================================================
 
 
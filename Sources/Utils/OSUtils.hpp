@@ -15,7 +15,11 @@
 class PathRebaser;
 
 #include <QString>
+#include <QStringList>
 #include <QList>
+class QProcessEnvironment;
+
+#include <functional>
 
 
 namespace os {
@@ -129,6 +133,47 @@ const QString & getLinuxDesktopEnv();
 QList< MonitorInfo > listMonitors();
 
 
+//======================================================================================================================
+// starting processes
+
+/// Environment of this launcher, resolved only once and then reused for every started process.
+const QProcessEnvironment & getCachedSystemEnvironment();
+
+/// The environment of this launcher with the given variables added or overridden, the later ones take precedence.
+QProcessEnvironment makeProcessEnvironment( const QList< EnvVar > & envVars );
+
+/// Called when a process started by spawnDetachedProcess() exits.
+/** It's called from the main thread's event loop. The exit code is -1 if the process was killed by a signal,
+  * the same value that is used when QProcess reports a crash, because QProcess doesn't provide the signal number. */
+using ProcessExitCallback = std::function< void ( int exitCode ) >;
+
+/// Whether spawnDetachedProcess() is available on this system.
+bool canSpawnDetachedProcess();
+
+/// Starts a process detached from the launcher directly via posix_spawn, without the overhead of QProcess.
+/** The environment of the launcher is passed to the process as is, only the given variables are added or overridden.
+  * The scheduling options are set up before the process is spawned, so that it inherits them from its very first
+  * instruction. Failure to apply them doesn't prevent the process from starting, it's only reported via schedulingError.
+  * The exit status of the process is collected by a SIGCHLD handler shared by all the spawned processes.
+  * Must be called from the main thread. Returns description of an error that might potentially happen, or empty string on success. */
+QString spawnDetachedProcess(
+	const QString & executable, const QStringList & arguments, const QString & workingDir, const QList< EnvVar > & envVars,
+	const ProcessScheduling & scheduling = {}, QString * schedulingError = nullptr, ProcessExitCallback onExit = {}
+);
+
+/// Whether the process scheduling options can be applied on this system.
+bool canSetProcessScheduling();
+
+/// Applies the scheduling options to an already running process, 0 means the calling thread.
+/** The options are applied to every thread the process has started so far, not only to its main thread.
+  * Returns description of the first error that happened, or empty string on success. */
+QString setProcessScheduling( qint64 pid, const ProcessScheduling & scheduling );
+
+/// Command line tools (taskset, nice, ionice, chrt) that start the following command with the scheduling options.
+/** Intended for exported scripts, returns empty list if all options are at their defaults. */
+QStringList getSchedulingCommandPrefix( const ProcessScheduling & scheduling );
+
+
 //======================================================================================================================
 // miscellaneous
 
@@ -69,6 +69,43 @@ struct MonitorInfo
 };
 
 
+//----------------------------------------------------------------------------------------------------------------------
+// process scheduling
+
+/// CPU scheduling policy of a process, corresponds to the Linux SCHED_* policies
+enum class SchedPolicy
+{
+	Default,   ///< keep the policy inherited from the launcher
+	Normal,    ///< SCHED_OTHER
+	Batch,     ///< SCHED_BATCH
+	Idle,      ///< SCHED_IDLE
+};
+
+/// I/O scheduling class of a process, corresponds to the Linux IOPRIO_CLASS_* classes
+enum class IOPrioClass
+{
+	Default,      ///< keep the class inherited from the launcher
+	BestEffort,   ///< IOPRIO_CLASS_BE
+	Idle,         ///< IOPRIO_CLASS_IDLE
+};
+
+/// How the operating system should schedule a started process.
+struct ProcessScheduling
+{
+	QString cpuAffinity;   ///< list of allowed CPUs in the taskset format (for example "0-3,6"), empty means all CPUs
+	int niceLevel = 0;     ///< from -20 (highest priority) to 19 (lowest priority), 0 keeps the inherited niceness
+	SchedPolicy schedPolicy = SchedPolicy::Default;
+	IOPrioClass ioPrioClass = IOPrioClass::Default;
+	int ioPrioLevel = 4;   ///< from 0 (highest priority) to 7 (lowest priority), used only with IOPrioClass::BestEffort
+
+	bool isDefault() const
+	{
+		return cpuAffinity.isEmpty() && niceLevel == 0
+		    && schedPolicy == SchedPolicy::Default && ioPrioClass == IOPrioClass::Default;
+	}
+};
+
+
 //----------------------------------------------------------------------------------------------------------------------
 // miscellaneous
 
@@ -12,12 +12,58 @@
 #include <QStringList>
 #include <QTextStream>
 
+#include <algorithm>  // min
+
 
 //======================================================================================================================
 
 const QString emptyString;
 
 
+static bool isAsciiDigit( QChar c )
+{
+	return c >= '0' && c <= '9';
+}
+
+// the number of digits of each number is written with 4 digits, longer numbers are compared as if they had 9999 digits
+static constexpr qsize_t digitCountMarkerBase = 1000;
+static constexpr qsize_t maxMarkedDigitCount = 9999;
+
+QString makeNaturalSortKey( const QString & str )
+{
+	const QString folded = str.toCaseFolded();
+
+	QString key;
+	key.reserve( folded.size() + 16 );
+
+	for (qsize_t i = 0; i < folded.size(); )
+	{
+		if (!isAsciiDigit( folded[i] ))
+		{
+			key += folded[i];
+			++i;
+			continue;
+		}
+
+		qsize_t runStart = i;
+		while (i < folded.size() && isAsciiDigit( folded[i] ))
+			++i;
+
+		// leading zeros would make a smaller number look longer, but a lone zero has to stay
+		while (runStart < i - 1 && folded[ runStart ] == '0')
+			++runStart;
+
+		// The length is written as a fixed-width decimal number, so that the lengths compare correctly as text,
+		// and the numbers keep sorting after ' ', '-', '.' and before the letters, like in a plain string comparison.
+		const qsize_t digitCount = std::min( i - runStart, maxMarkedDigitCount );
+		for (qsize_t divisor = digitCountMarkerBase; divisor > 0; divisor /= 10)
+			key += QChar( char16_t( '0' + digitCount / divisor % 10 ) );
+		key.append( folded.constData() + runStart, i - runStart );
+	}
+
+	return key;
+}
+
 QString replaceStringBetween( QString source, char startingChar, char endingChar, const QString & replaceWith )
 {
 	qsize_t startIdx = source.indexOf( startingChar );
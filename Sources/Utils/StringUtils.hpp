@@ -41,6 +41,13 @@ inline QString capitalize( const QString & str )
 	return capitalize( strCopy );
 }
 
+/// Makes a key that orders the strings naturally when compared as plain strings, so that MAP2 < MAP10, E1M2 < E1M10.
+/** The text is case-folded and every run of digits is prefixed with its number of significant digits written
+  * as a 4-digit number, so that a longer number is always greater. Only numbers with more than 9999 digits are compared
+  * digit by digit regardless of their length. Computing the key once per item and then comparing the keys is much
+  * cheaper than doing a natural comparison of the original strings in each of the O(n*log(n)) comparisons. */
+QString makeNaturalSortKey( const QString & str );
+
 /// Replaces everything between startingChar and endingChar with replaceWith
 QString replaceStringBetween( QString source, char startingChar, char endingChar, const QString & replaceWith );
 
@@ -0,0 +1,301 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: index for fast searching in large lists of short texts (file names, paths)
+//======================================================================================================================
+
+#include "TrigramIndex.hpp"
+
+#include <algorithm>
+
+
+//======================================================================================================================
+// helpers
+
+static quint64 makeTrigram( const QChar * chars )
+{
+	return (quint64( chars[0].unicode() ) << 32) | (quint64( chars[1].unicode() ) << 16) | quint64( chars[2].unicode() );
+}
+
+/// Calls \p func for every distinct trigram of every word of a normalized text.
+template< typename Func >
+static void forEachTrigram( const QString & normalizedText, Func func )
+{
+	QVector< quint64 > trigrams;
+	const QChar * chars = normalizedText.constData();
+	for (qsize_t i = 0; i + 3 <= normalizedText.size(); ++i)
+	{
+		if (chars[i] != ' ' && chars[i+1] != ' ' && chars[i+2] != ' ')  // don't cross the word boundaries
+			trigrams.append( makeTrigram( chars + i ) );
+	}
+
+	std::sort( trigrams.begin(), trigrams.end() );
+	auto uniqueEnd = std::unique( trigrams.begin(), trigrams.end() );
+
+	for (auto iter = trigrams.begin(); iter != uniqueEnd; ++iter)
+		func( *iter );
+}
+
+static bool containsAllWords( const QString & normalizedText, const QStringList & words )
+{
+	for (const QString & word : words)
+		if (!normalizedText.contains( word ))
+			return false;
+	return true;
+}
+
+/// Returns the length of the shortest part of the text that contains the characters of the word in the same order,
+/// or -1 if the text doesn't contain them.
+static int findSubsequenceSpan( const QString & text, const QString & word )
+{
+	int shortestSpan = -1;
+	for (qsize_t start = text.indexOf( word[0] ); start >= 0; start = text.indexOf( word[0], start + 1 ))
+	{
+		qsize_t textPos = start;
+		qsize_t wordPos = 0;
+		for (; textPos < text.size() && wordPos < word.size(); ++textPos)
+			if (text[ textPos ] == word[ wordPos ])
+				++wordPos;
+
+		if (wordPos < word.size())
+			break;  // starting later can't help
+
+		const int span = int( textPos - start );
+		if (shortestSpan < 0 || span < shortestSpan)
+			shortestSpan = span;
+		if (shortestSpan == int( word.size() ))
+			break;  // can't be any shorter
+	}
+	return shortestSpan;
+}
+
+
+//======================================================================================================================
+// TrigramIndex
+
+void TrigramIndex::clear()
+{
+	_entries.clear();
+	_removedCount = 0;
+	_postings.clear();
+	_lastPhrase.clear();
+	_lastCandidates.clear();
+	_lastFuzzyCandidates.clear();
+	_lastFuzzyValid = false;
+}
+
+void TrigramIndex::reserve( qsize_t entryCount )
+{
+	_entries.reserve( entryCount );
+}
+
+QString TrigramIndex::normalize( const QString & text )
+{
+	QString normalized = text.toCaseFolded();
+	for (QChar & c : normalized)
+		if (!c.isLetterOrNumber())
+			c = ' ';
+	return normalized.simplified();
+}
+
+TrigramIndex::EntryID TrigramIndex::addEntry( const QString & text )
+{
+	const EntryID id = EntryID( _entries.size() );
+
+	Entry entry;
+	entry.text = text;
+	entry.normalizedText = normalize( text );
+
+	// the IDs are increasing, so the posting lists stay sorted
+	forEachTrigram( entry.normalizedText, [&]( quint64 trigram ) { _postings[ trigram ].append( id ); } );
+
+	_entries.append( std::move( entry ) );
+
+	// the new entry wasn't considered in the last search, so the next one can't be narrowed from it
+	_lastPhrase.clear();
+
+	return id;
+}
+
+void TrigramIndex::removeEntry( EntryID id )
+{
+	if (id < 0 || id >= _entries.size() || _entries[ id ].removed)
+		return;
+
+	// It's cheaper to leave the ID in the posting lists and skip it when searching.
+	_entries[ id ].removed = true;
+	_entries[ id ].normalizedText.clear();
+	_removedCount++;
+}
+
+int TrigramIndex::scoreMatch( const QString & normalizedText, const QString & normalizedPhrase, const QStringList & words )
+{
+	int score = 0;
+
+	if (normalizedText == normalizedPhrase)
+		score += 100;
+
+	const qsize_t phrasePos = normalizedText.indexOf( normalizedPhrase );
+	if (phrasePos >= 0)  // the whole phrase together, not just the separate words
+		score += (phrasePos == 0) ? 40 : 20;
+
+	for (const QString & word : words)
+	{
+		const qsize_t wordPos = normalizedText.indexOf( word );
+		if (wordPos == 0)
+			score += 10;
+		else if (wordPos > 0 && normalizedText[ wordPos - 1 ] == ' ')  // beginning of a word
+			score += 5;
+	}
+
+	// prefer the shorter texts, because the phrase covers bigger part of them
+	score -= int( normalizedText.size() / 8 );
+
+	return score;
+}
+
+std::optional< int > TrigramIndex::scoreFuzzyMatch( const QString & normalizedText, const QStringList & words )
+{
+	// always below the exact matches, their score can't get this low
+	int score = -1000;
+
+	for (const QString & word : words)
+	{
+		const int span = findSubsequenceSpan( normalizedText, word );
+		if (span < 0)
+			return std::nullopt;
+		score -= span - int( word.size() );  // the more scattered the characters, the worse
+	}
+
+	score -= int( normalizedText.size() / 8 );
+
+	return score;
+}
+
+QVector< TrigramIndex::Match > TrigramIndex::search( const QString & phrase, qsize_t maxResults )
+{
+	const QString normalizedPhrase = normalize( phrase );
+	if (normalizedPhrase.isEmpty())
+	{
+		_lastPhrase.clear();
+		_lastCandidates.clear();
+		_lastFuzzyCandidates.clear();
+		_lastFuzzyValid = false;
+		return {};
+	}
+
+	const QStringList words = normalizedPhrase.split( ' ' );
+	const bool isNarrowing = !_lastPhrase.isEmpty() && normalizedPhrase.startsWith( _lastPhrase );
+
+	QVector< EntryID > candidates;
+
+	if (isNarrowing)
+	{
+		// Every word of the new phrase contains the corresponding word of the old phrase (or is a new word),
+		// so anything that didn't match the old phrase can't match the new one.
+		candidates = std::move( _lastCandidates );
+	}
+	else
+	{
+		// start with the shortest posting list of all the phrase's trigrams
+		const QVector< EntryID > * shortestPostings = nullptr;
+		bool someTrigramMissing = false;
+		forEachTrigram( normalizedPhrase, [&]( quint64 trigram )
+		{
+			auto postingsIter = _postings.constFind( trigram );
+			if (postingsIter == _postings.constEnd())
+				someTrigramMissing = true;
+			else if (!shortestPostings || postingsIter->size() < shortestPostings->size())
+				shortestPostings = &postingsIter.value();
+		});
+
+		if (someTrigramMissing)
+		{
+			// no entry contains this trigram, so none can contain the word
+		}
+		else if (shortestPostings)
+		{
+			candidates = *shortestPostings;
+		}
+		else  // all words are shorter than 3 characters, there's nothing to look up
+		{
+			candidates.reserve( _entries.size() );
+			for (EntryID id = 0; id < _entries.size(); ++id)
+				candidates.append( id );
+		}
+	}
+
+	// verify the candidates, the trigrams only say the words might be there
+	QVector< EntryID > verified;
+	verified.reserve( candidates.size() );
+	for (EntryID id : as_const( candidates ))
+	{
+		const Entry & entry = _entries[ id ];
+		if (!entry.removed && containsAllWords( entry.normalizedText, words ))
+			verified.append( id );
+	}
+
+	QVector< Match > matches;
+	matches.reserve( verified.size() );
+	for (EntryID id : as_const( verified ))
+		matches.append({ id, scoreMatch( _entries[ id ].normalizedText, normalizedPhrase, words ) });
+
+	// The fuzzy matching has to go through all the entries, do it only when the exact matches are not enough.
+	QVector< EntryID > fuzzyVerified;
+	const bool doFuzzy = maxResults < 0 || verified.size() < maxResults;
+	if (doFuzzy)
+	{
+		QVector< EntryID > fuzzyCandidates;
+		if (isNarrowing && _lastFuzzyValid)
+		{
+			// Anything that contains the words also contains their characters in order, so the new fuzzy matches
+			// can only be among the previous exact and fuzzy matches. Both lists are sorted by ID.
+			fuzzyCandidates.resize( candidates.size() + _lastFuzzyCandidates.size() );
+			std::merge( candidates.begin(), candidates.end(), _lastFuzzyCandidates.begin(), _lastFuzzyCandidates.end(), fuzzyCandidates.begin() );
+		}
+		else
+		{
+			fuzzyCandidates.reserve( _entries.size() );
+			for (EntryID id = 0; id < _entries.size(); ++id)
+				fuzzyCandidates.append( id );
+		}
+
+		for (EntryID id : as_const( fuzzyCandidates ))
+		{
+			const Entry & entry = _entries[ id ];
+			if (entry.removed || std::binary_search( verified.begin(), verified.end(), id ))
+				continue;  // the exact matches are already there with a better score
+
+			if (auto score = scoreFuzzyMatch( entry.normalizedText, words ))
+			{
+				fuzzyVerified.append( id );
+				matches.append({ id, *score });
+			}
+		}
+	}
+
+	_lastPhrase = normalizedPhrase;
+	_lastCandidates = std::move( verified );
+	_lastFuzzyCandidates = std::move( fuzzyVerified );
+	_lastFuzzyValid = doFuzzy;
+
+	auto isBetter = [this]( const Match & m1, const Match & m2 )
+	{
+		if (m1.score != m2.score)
+			return m1.score > m2.score;
+		return _entries[ m1.id ].text < _entries[ m2.id ].text;
+	};
+
+	if (maxResults >= 0 && maxResults < matches.size())
+	{
+		std::partial_sort( matches.begin(), matches.begin() + maxResults, matches.end(), isBetter );
+		matches.resize( maxResults );
+	}
+	else
+	{
+		std::sort( matches.begin(), matches.end(), isBetter );
+	}
+
+	return matches;
+}
@@ -0,0 +1,101 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: index for fast searching in large lists of short texts (file names, paths)
+//======================================================================================================================
+
+#ifndef TRIGRAM_INDEX_INCLUDED
+#define TRIGRAM_INDEX_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include "CommonTypes.hpp"  // qsize_t
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+
+#include <optional>
+
+
+//======================================================================================================================
+/// Index of short texts allowing to quickly find those that contain all the words of a search phrase.
+/**
+  * The texts are normalized (case-folded, separators like '_', '-', '.' or '/' treated as spaces) and every
+  * 3-character sequence of every word (trigram) points to a list of texts where it occurs. Searching then
+  * starts from the shortest list of any of the phrase's trigrams and only verifies those candidates.
+  * The phrase words may appear in any order and anywhere inside the text's words.
+  *
+  * When there are not enough of these exact matches, the texts are also matched fuzzily: the characters of each
+  * phrase word must appear in the text in the same order, but there may be other characters between them
+  * ("sgl" finds "sigil"). The fuzzy matches are always ranked below the exact ones.
+  *
+  * When the phrase only extends the phrase of the previous search (the user types more characters),
+  * the result can only be a subset of the previous result, so only the previous result is searched.
+  *
+  * The index is a plain value, it can be built in a background thread and then moved into the main thread.
+  */
+class TrigramIndex {
+
+ public:
+
+	using EntryID = int;
+
+	struct Match
+	{
+		EntryID id;
+		int score;   ///< the higher the better
+	};
+
+	TrigramIndex() = default;
+
+	void clear();
+	void reserve( qsize_t entryCount );
+
+	/// Adds a new text to the index and returns its ID, which is stable until clear() is called.
+	EntryID addEntry( const QString & text );
+	/// Removes the text from the search results. Its ID will not be re-used.
+	void removeEntry( EntryID id );
+
+	const QString & entryText( EntryID id ) const  { return _entries[ id ].text; }
+	qsize_t entryCount() const                     { return _entries.size() - _removedCount; }
+	bool isEmpty() const                           { return entryCount() == 0; }
+
+	/// Returns the entries matching all words of the phrase, sorted from the best match to the worst.
+	/** \param maxResults Maximum number of results to return, -1 means unlimited. */
+	QVector< Match > search( const QString & phrase, qsize_t maxResults = -1 );
+
+ private:
+
+	struct Entry
+	{
+		QString text;
+		QString normalizedText;
+		bool removed = false;
+	};
+
+	static QString normalize( const QString & text );
+	static int scoreMatch( const QString & normalizedText, const QString & normalizedPhrase, const QStringList & words );
+	/// Returns std::nullopt if the text doesn't contain the characters of all the words in order.
+	static std::optional< int > scoreFuzzyMatch( const QString & normalizedText, const QStringList & words );
+
+	QVector< Entry > _entries;
+	qsize_t _removedCount = 0;
+	QHash< quint64, QVector< EntryID > > _postings;  ///< trigram -> IDs of entries containing it, in increasing order
+
+	// state for incremental narrowing of the results
+	QString _lastPhrase;                  ///< normalized phrase of the last search
+	QVector< EntryID > _lastCandidates;   ///< all (not truncated) exact matches of the last search
+	QVector< EntryID > _lastFuzzyCandidates;  ///< all fuzzy matches of the last search, that weren't matched exactly
+	bool _lastFuzzyValid = false;         ///< whether the fuzzy matching was done in the last search
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // TRIGRAM_INDEX_INCLUDED
@@ -7,10 +7,14 @@
 
 #include "WidgetUtils.hpp"
 
+#include "LangUtils.hpp"  // correspondingValue
+
 #include <QPalette>
 #include <QApplication>
 #include <QTableWidget>
 #include <QAbstractButton>
+#include <QMessageBox>
+#include <QCheckBox>
 
 
 namespace wdg {
@@ -462,6 +466,27 @@ void restoreButtonColor( QAbstractButton * button )
 	button->setStyleSheet( QString() );
 }
 
+bool showMessageBox( QWidget * parent, MessageBoxType type, const QString & title, const QString & message, bool offerToIgnoreRest )
+{
+	QMessageBox::Icon icon = correspondingValue( type,
+		correspondsTo( MessageBoxType::Information, QMessageBox::Information ),
+		correspondsTo( MessageBoxType::Warning,     QMessageBox::Warning ),
+		correspondsTo( MessageBoxType::Critical,    QMessageBox::Critical )
+	);
+
+	QMessageBox msgBox( icon, title, message, QMessageBox::Ok, parent );
+	QCheckBox * chkBox = nullptr;
+	if (offerToIgnoreRest)
+	{
+		chkBox = new QCheckBox( "ignore the rest of these warnings" );
+		msgBox.setCheckBox( chkBox );  // msgBox takes ownership of chkBox
+	}
+
+	msgBox.exec();
+
+	return chkBox && chkBox->isChecked();
+}
+
 
 
 
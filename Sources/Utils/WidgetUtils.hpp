@@ -187,6 +187,15 @@ QList<int> getSortedRows( const QModelIndexList & selectedIndexes, const IsLessT
 	return selectedRowsAsc;
 }
 
+inline QList<int> makeIdentityOrder( int rowCount )
+{
+	QList<int> order;
+	order.reserve( rowCount );
+	for (int row = 0; row < rowCount; ++row)
+		order.append( row );
+	return order;
+}
+
 } // namespace impl
 
 
@@ -287,16 +296,9 @@ QList<int> removeSelectedItems( QListView * view, ListModel & model )
 
 	deselectAllAndUnsetCurrent( view );
 
-	// remove all the selected items
-	uint removedCnt = 0;
-	for (int selectedIdx : as_const( selectedRowsAsc ))
-	{
-		model.startRemovingItems( selectedIdx - removedCnt );
-		model.removeAt( selectedIdx - removedCnt );  // every removed item shifts the indexes of the following items
-		model.finishRemovingItems();
-		// we're modifying the model ourselves so we don't need to be notified about it
-		removedCnt++;
-	}
+	// remove all the selected items in a single batch, so that the view doesn't re-layout after each of them
+	model.removeItems( selectedRowsAsc );
+	// we're modifying the model ourselves so we don't need to be notified about it
 
 	// try to select some nearest item, so that user can click 'delete' repeatedly to delete all of them
 	if (topMostSelectedIdx < model.size())                       // if the first removed item index is still within range of existing ones,
@@ -383,18 +385,13 @@ QList<int> moveSelectedItemsUp( QListView * view, ListModel & model )
 
 	int currentIdx = getCurrentItemIndex( view );
 
-	deselectAllAndUnsetCurrent( view );
-
-	model.startReorderingItems();
-
-	// do the move and select the new positions
+	// every selected item swaps places with the item above it
+	QList<int> newOrder = impl::makeIdentityOrder( int( model.size() ) );
 	for (int selectedIdx : as_const( selectedRowsAsc ))
-	{
-		model.move( selectedIdx, selectedIdx - 1 );
-		selectItemByIndex( view, selectedIdx - 1 );
-	}
+		std::swap( newOrder[ selectedIdx - 1 ], newOrder[ selectedIdx ] );
 
-	model.finishReorderingItems();
+	// apply the whole move at once, the selection follows the moved items
+	model.reorderItems( newOrder );
 	// we're modifying the model ourselves so we don't need to be notified about it
 
 	if (currentIdx >= 1)                                // if the current item was not the first one,
@@ -441,18 +438,13 @@ QList<int> moveSelectedItemsDown( QListView * view, ListModel & model )
 
 	int currentIdx = getCurrentItemIndex( view );
 
-	deselectAllAndUnsetCurrent( view );
-
-	model.startReorderingItems();
-
-	// do the move and select the new positions
+	// every selected item swaps places with the item below it
+	QList<int> newOrder = impl::makeIdentityOrder( int( model.size() ) );
 	for (int selectedIdx : as_const( selectedRowsDesc ))
-	{
-		model.move( selectedIdx, selectedIdx + 1 );
-		selectItemByIndex( view, selectedIdx + 1 );
-	}
+		std::swap( newOrder[ selectedIdx ], newOrder[ selectedIdx + 1 ] );
 
-	model.finishReorderingItems();
+	// apply the whole move at once, the selection follows the moved items
+	model.reorderItems( newOrder );
 	// we're modifying the model ourselves so we don't need to be notified about it
 
 	if (currentIdx < model.size() - 1)                    // if the current item was not the last one,
@@ -491,29 +483,24 @@ QList<int> moveSelectedItemsToTop( QListView * view, ListModel & model )
 	// but for the move, we need them sorted in ascending order
 	QList<int> selectedRowsAsc = impl::getSortedRows( selectedIndexes, []( int i1, int i2 ) { return i1 < i2; } );
 
-	int currentIdx = getCurrentItemIndex( view );
-
-	deselectAllAndUnsetCurrent( view );
-
-	model.startReorderingItems();
-
-	// do the move and select the new positions
-	// move the items from top to bottom so that the remaining indexes remain valid
-	int movedCnt = 0;
-	for (int selectedIdx : as_const( selectedRowsAsc ))
+	// the selected items first, then the rest, both in their original order
+	QList<int> newOrder = selectedRowsAsc;
+	newOrder.reserve( int( model.size() ) );
+	for (int row = 0, nextSelected = 0; row < model.size(); ++row)
 	{
-		int destIdx = movedCnt;  // move below the already moved items
-		if (selectedIdx != destIdx)
-			model.move( selectedIdx, destIdx );
-		selectItemByIndex( view, destIdx );
-		if (selectedIdx == currentIdx)  // if we just moved the current item, set the new location as current too
-			setCurrentItemByIndex( view, destIdx );
-		movedCnt++;
+		if (nextSelected < selectedRowsAsc.size() && selectedRowsAsc[ nextSelected ] == row)
+			nextSelected++;
+		else
+			newOrder.append( row );
 	}
 
-	model.finishReorderingItems();
+	// apply the whole move at once, the selection and the current item follow the moved items
+	model.reorderItems( newOrder );
 	// we're modifying the model ourselves so we don't need to be notified about it
 
+	if (int newCurrentIdx = getCurrentItemIndex( view ); newCurrentIdx >= 0)
+		setCurrentItemByIndex( view, newCurrentIdx );  // scroll to where the current item went
+
 	return selectedRowsAsc;
 }
 
@@ -541,29 +528,26 @@ QList<int> moveSelectedItemsToBottom( QListView * view, ListModel & model )
 	// but for the move, we need them sorted in descending order
 	QList<int> selectedRowsDesc = impl::getSortedRows( selectedIndexes, []( int i1, int i2 ) { return i1 > i2; } );
 
-	int currentIdx = getCurrentItemIndex( view );
-
-	deselectAllAndUnsetCurrent( view );
-
-	model.startReorderingItems();
-
-	// do the move and select the new positions
-	// move the items from bottom to top so that the remaining indexes remain valid
-	int movedCnt = 0;
-	for (int selectedIdx : as_const( selectedRowsDesc ))
+	// the rest first, then the selected items, both in their original order
+	QList<int> newOrder;
+	newOrder.reserve( int( model.size() ) );
+	for (int row = 0, nextSelected = selectedRowsDesc.size() - 1; row < model.size(); ++row)
 	{
-		int destIdx = model.size() - 1 - movedCnt;  // move above the already moved items
-		if (selectedIdx != destIdx)
-			model.move( selectedIdx, destIdx );
-		selectItemByIndex( view, destIdx );
-		if (selectedIdx == currentIdx)  // if we just moved the current item, set the new location as current too
-			setCurrentItemByIndex( view, destIdx );
-		movedCnt++;
+		if (nextSelected >= 0 && selectedRowsDesc[ nextSelected ] == row)
+			nextSelected--;
+		else
+			newOrder.append( row );
 	}
+	for (auto rowIter = selectedRowsDesc.rbegin(); rowIter != selectedRowsDesc.rend(); ++rowIter)
+		newOrder.append( *rowIter );
 
-	model.finishReorderingItems();
+	// apply the whole move at once, the selection and the current item follow the moved items
+	model.reorderItems( newOrder );
 	// we're modifying the model ourselves so we don't need to be notified about it
 
+	if (int newCurrentIdx = getCurrentItemIndex( view ); newCurrentIdx >= 0)
+		setCurrentItemByIndex( view, newCurrentIdx );  // scroll to where the current item went
+
 	return selectedRowsDesc;
 }
 
@@ -666,11 +650,9 @@ QString getSelectedItemID( QListView * view, const ListModel & model )
 template< typename ListModel >  // Item must have getID() method that returns some kind of persistant unique identifier
 bool setCurrentItemByID( QListView * view, const ListModel & model, const QString & itemID )
 {
-	using Item = typename ListModel::Item;
-
 	if (!itemID.isEmpty())
 	{
-		int newItemIdx = findSuch( model, [&]( const Item & item ) { return item.getID() == itemID; } );
+		int newItemIdx = int( model.findIndexByID( itemID ) );
 		if (newItemIdx >= 0)
 		{
 			setCurrentItemByIndex( view, newItemIdx );
@@ -684,11 +666,9 @@ bool setCurrentItemByID( QListView * view, const ListModel & model, const QStrin
 template< typename ListModel >  // Item must have getID() method that returns some kind of persistant unique identifier
 bool selectItemByID( QListView * view, const ListModel & model, const QString & itemID )
 {
-	using Item = typename ListModel::Item;
-
 	if (!itemID.isEmpty())
 	{
-		int newItemIdx = findSuch( model, [&]( const Item & item ) { return item.getID() == itemID; } );
+		int newItemIdx = int( model.findIndexByID( itemID ) );
 		if (newItemIdx >= 0)
 		{
 			selectItemByIndex( view, newItemIdx );
@@ -714,11 +694,9 @@ auto getSelectedItemIDs( QListView * view, const ListModel & model ) -> QStringL
 template< typename ListModel >  // Item must have getID() method that returns some kind of persistant unique identifier
 void selectItemsByIDs( QListView * view, const ListModel & model, const QStringList & itemIDs )
 {
-	using Item = typename ListModel::Item;
-
 	for (const auto & itemID : itemIDs)
 	{
-		int newItemIdx = findSuch( model, [&]( const Item & item ) { return item.getID() == itemID; } );
+		int newItemIdx = int( model.findIndexByID( itemID ) );  // O(1) after the first lookup
 		if (newItemIdx >= 0)
 			selectItemByIndex( view, newItemIdx );
 	}
@@ -797,11 +775,9 @@ QString getCurrentItemID( QComboBox * comboBox, const ListModel & model )
 template< typename ListModel >  // Item must have getID() method that returns some kind of persistant unique identifier
 bool setCurrentItemByID( QComboBox * comboBox, const ListModel & model, const QString & itemID )
 {
-	using Item = typename ListModel::Item;
-
 	if (!itemID.isEmpty())
 	{
-		int newItemIdx = findSuch( model, [&]( const Item & item ) { return item.getID() == itemID; } );
+		int newItemIdx = int( model.findIndexByID( itemID ) );
 		if (newItemIdx >= 0)
 		{
 			setCurrentItemByIndex( comboBox, newItemIdx );
@@ -863,6 +839,9 @@ void setButtonColor( QAbstractButton * button, QColor color );
 /// Restores the background color of a button.
 void restoreButtonColor( QAbstractButton * button );
 
+/// Displays the errors reported by the functions from ErrorHandling.hpp, pass it to setMessageBoxFunc().
+bool showMessageBox( QWidget * parent, MessageBoxType type, const QString & title, const QString & message, bool offerToIgnoreRest );
+
 /// makes a hyperlink for a widget's text
 #define HYPERLINK( text, url ) \
 	"<a href=\""%url%"\"><span style=\"\">"%text%"</span></a>"
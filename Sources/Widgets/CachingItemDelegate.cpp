@@ -0,0 +1,83 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: item delegate that caches the text layout of the rows
+//======================================================================================================================
+
+#include "CachingItemDelegate.hpp"
+
+#include <QStyle>
+#include <QApplication>
+#include <QFontMetrics>
+#include <QWidget>
+
+
+//======================================================================================================================
+
+CachingItemDelegate::CachingItemDelegate( QObject * parent ) : QStyledItemDelegate( parent ) {}
+
+void CachingItemDelegate::invalidateCache()
+{
+	elidedTexts.clear();
+	elidedTextsWidth = -1;
+}
+
+const QString & CachingItemDelegate::getElidedText( const QString & text, const QFont & font, Qt::TextElideMode mode, int width ) const
+{
+	if (width != elidedTextsWidth || mode != elidedTextsMode || font != elidedTextsFont || elidedTexts.size() >= maxCachedTexts)
+	{
+		elidedTexts.clear();
+		elidedTextsWidth = width;
+		elidedTextsMode = mode;
+		elidedTextsFont = font;
+	}
+
+	auto iter = elidedTexts.find( text );
+	if (iter == elidedTexts.end())
+	{
+		iter = elidedTexts.insert( text, QFontMetrics( font ).elidedText( text, mode, width ) );
+	}
+	return iter.value();
+}
+
+void CachingItemDelegate::paint( QPainter * painter, const QStyleOptionViewItem & option, const QModelIndex & index ) const
+{
+	QStyleOptionViewItem opt = option;
+	initStyleOption( &opt, index );
+
+	const QWidget * widget = opt.widget;
+	QStyle * style = widget ? widget->style() : QApplication::style();
+
+	// Multi-line texts are laid out by the style line by line, we can't replace that with a single elidedText().
+	if (opt.features.testFlag( QStyleOptionViewItem::HasDisplay ) && opt.textElideMode != Qt::ElideNone
+	 && !opt.features.testFlag( QStyleOptionViewItem::WrapText ) && !opt.text.contains( QChar::LineSeparator ))
+	{
+		// the same margins QCommonStyle subtracts before it elides the text itself
+		QRect textRect = style->subElementRect( QStyle::SE_ItemViewItemText, &opt, widget );
+		const int textMargin = style->pixelMetric( QStyle::PM_FocusFrameHMargin, nullptr, widget ) + 1;
+		const int availableWidth = textRect.width() - 2 * textMargin;
+
+		opt.text = getElidedText( opt.text, opt.font, opt.textElideMode, availableWidth );
+		opt.textElideMode = Qt::ElideNone;
+	}
+
+	style->drawControl( QStyle::CE_ItemViewItem, &opt, painter, widget );
+}
+
+QSize CachingItemDelegate::sizeHint( const QStyleOptionViewItem & option, const QModelIndex & index ) const
+{
+	if (!reserveDecorationSpace)
+	{
+		return SuperClass::sizeHint( option, index );
+	}
+
+	QStyleOptionViewItem opt = option;
+	initStyleOption( &opt, index );
+	// rows without icons (separators, command line arguments) must not make the uniform row height too small
+	opt.features |= QStyleOptionViewItem::HasDecoration;
+
+	const QWidget * widget = opt.widget;
+	QStyle * style = widget ? widget->style() : QApplication::style();
+	return style->sizeFromContents( QStyle::CT_ItemViewItem, &opt, QSize(), widget );
+}
@@ -0,0 +1,71 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: item delegate that caches the text layout of the rows
+//======================================================================================================================
+
+#ifndef CACHING_ITEM_DELEGATE_INCLUDED
+#define CACHING_ITEM_DELEGATE_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QStyledItemDelegate>
+#include <QHash>
+#include <QString>
+#include <QFont>
+
+
+//======================================================================================================================
+/// Item delegate for views with many rows, that remembers the results of the text layout between repaints.
+/** QStyledItemDelegate elides the text of every visible row on every repaint, which means measuring the whole string
+  * with the font metrics again and again while the user is only scrolling. This delegate elides the text once
+  * per (text, available width, font) and then hands the style a text that already fits, so that it doesn't have to. */
+
+class CachingItemDelegate : public QStyledItemDelegate {
+
+	Q_OBJECT
+
+	using ThisClass = CachingItemDelegate;
+	using SuperClass = QStyledItemDelegate;
+
+ public:
+
+	CachingItemDelegate( QObject * parent );
+
+	/// When enabled, the size hint of every row is computed as if the row had an icon,
+	/// so that the first row (which QListView uses for all rows when uniformItemSizes is on) is high enough for all.
+	void toggleDecorationSpace( bool enabled )  { reserveDecorationSpace = enabled; }
+
+	/// Drops all the cached text layouts.
+	void invalidateCache();
+
+	virtual void paint( QPainter * painter, const QStyleOptionViewItem & option, const QModelIndex & index ) const override;
+	virtual QSize sizeHint( const QStyleOptionViewItem & option, const QModelIndex & index ) const override;
+
+ private:
+
+	const QString & getElidedText( const QString & text, const QFont & font, Qt::TextElideMode mode, int width ) const;
+
+ private:
+
+	bool reserveDecorationSpace = false;
+
+	// All visible rows share the same width, font and elide mode, so the cache is keyed only by the text
+	// and gets cleared when one of the others changes (typically when the view is resized).
+	mutable QHash< QString, QString > elidedTexts;
+	mutable QFont elidedTextsFont;
+	mutable int elidedTextsWidth = -1;
+	mutable Qt::TextElideMode elidedTextsMode = Qt::ElideRight;
+
+	/// Keeps the memory bounded when the user scrolls through a huge list without resizing it.
+	static constexpr int maxCachedTexts = 4096;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // CACHING_ITEM_DELEGATE_INCLUDED
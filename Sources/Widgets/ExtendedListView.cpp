@@ -9,6 +9,7 @@
 #include "ExtendedListView.hpp"
 
 #include "ExtendedViewCommon.impl.hpp"
+#include "CachingItemDelegate.hpp"
 #include "DataModels/GenericListModel.hpp"
 #include "Utils/EventFilters.hpp"
 #include "Utils/WidgetUtils.hpp"
@@ -106,6 +107,12 @@ void ExtendedListView::toggleIcons( bool enabled )
 		{
 			toggleIconsAction->setText( enabled ? "Hide icons" : "Show icons" );
 		}
+		if (cachingDelegate)
+		{
+			cachingDelegate->toggleDecorationSpace( enabled );
+		}
+		// with uniform item sizes the view remembers the row size computed before the icons appeared or disappeared
+		QBaseView::scheduleDelayedItemsLayout();
 	}
 }
 
@@ -115,6 +122,42 @@ void ExtendedListView::toggleIcons()
 }
 
 
+//----------------------------------------------------------------------------------------------------------------------
+// performance
+
+static constexpr int highVolumeBatchSize = 256;  ///< number of rows laid out before the event loop gets control again
+
+void ExtendedListView::toggleHighVolumeMode( bool enabled )
+{
+	if (enabled == isHighVolumeModeEnabled())
+	{
+		return;
+	}
+
+	if (enabled)
+	{
+		if (!cachingDelegate)
+		{
+			cachingDelegate = new CachingItemDelegate( this );
+		}
+		cachingDelegate->toggleDecorationSpace( areIconsEnabled() );
+		cachingDelegate->invalidateCache();
+
+		// the default delegate is owned by QAbstractItemView, so it's still alive and we can switch back to it later
+		defaultDelegate = QBaseView::itemDelegate();
+		QBaseView::setItemDelegate( cachingDelegate );
+	}
+	else
+	{
+		QBaseView::setItemDelegate( defaultDelegate );
+	}
+
+	QBaseView::setUniformItemSizes( enabled );
+	QBaseView::setLayoutMode( enabled ? QListView::Batched : QListView::SinglePass );
+	QBaseView::setBatchSize( highVolumeBatchSize );
+}
+
+
 //----------------------------------------------------------------------------------------------------------------------
 // editing item content
 
@@ -17,6 +17,7 @@
 #include "Utils/EventFilters.hpp"      // ModifierHandler
 class AListModel;
 class DnDProgressGuard;
+class CachingItemDelegate;
 
 #include <QListView>
 class QString;
@@ -88,6 +89,16 @@ class ExtendedListView : public QListView, public ExtendedViewCommon< ExtendedLi
 
 	bool areIconsEnabled() const;
 
+	//-- performance ---------------------------------------------------------------------------------------------------
+
+	/// Enables/disables rendering optimized for lists with thousands of items, default is disabled.
+	/** All rows are assumed to have the same height, the layout is done in batches in between the event processing,
+	  * and the text layout of the rows is cached by a special item delegate. Because the sizes of the rows are not
+	  * measured one by one, the model is asked for the icons only of the rows that are actually painted. */
+	void toggleHighVolumeMode( bool enabled );
+
+	bool isHighVolumeModeEnabled() const  { return cachingDelegate != nullptr && itemDelegate() == cachingDelegate; }
+
 	//-- editing item content ------------------------------------------------------------------------------------------
 
 	/// Enables/disables checkboxes in front of items, default is disabled.
@@ -216,6 +227,8 @@ class ExtendedListView : public QListView, public ExtendedViewCommon< ExtendedLi
  private: // internal members
 
 	AListModel * ownModel = nullptr;  ///< quick access to our own specialized model
+	QAbstractItemDelegate * defaultDelegate = nullptr;  ///< the delegate to restore when high-volume mode is disabled
+	CachingItemDelegate * cachingDelegate = nullptr;  ///< created on first use of high-volume mode, owned by this view
 	ModifierHandler modifierHandler;
 	bool isBeingDraggedFrom = false;
 	bool isBeingDroppedTo = false;
@@ -8,7 +8,9 @@
 #include "ExtendedTreeView.hpp"
 
 #include "ExtendedViewCommon.impl.hpp"
+#include "DataModels/MapPackTreeModel.hpp"
 #include "Utils/OSUtils.hpp"  // openFileLocation
+#include "Utils/FileIconProvider.hpp"
 
 #include <QFileSystemModel>
 #include <QFileIconProvider>
@@ -36,6 +38,7 @@ void ExtendedTreeView::setModel( QAbstractItemModel * model )
 	QBaseView::setModel( model );
 
 	fsModel = dynamic_cast< QFileSystemModel * >( model );
+	mapPackModel = dynamic_cast< MapPackTreeModel * >( model );
 
 	updateColumnSize();  // adapt view to the current state of the new model
 	connect( model, &QAbstractItemModel::dataChanged, this, &ThisClass::onDataChanged );  // prepare for future changes
@@ -54,6 +57,8 @@ struct EmptyIconProvider : public QFileIconProvider
 
 bool ExtendedTreeView::areIconsEnabled() const
 {
+	if (mapPackModel)
+		return mapPackModel->areIconsEnabled();
 	return fsModel && !dynamic_cast< EmptyIconProvider * >( fsModel->iconProvider() );
 }
 
@@ -63,7 +68,7 @@ void ExtendedTreeView::toggleIcons( bool enabled )
 	{
 		if (enabled)
 		{
-			fsModel->setIconProvider( new QFileIconProvider );
+			fsModel->setIconProvider( &getFileIconProvider() );  // shared instance, resolves the icons once per suffix
 		}
 		else
 		{
@@ -71,6 +76,11 @@ void ExtendedTreeView::toggleIcons( bool enabled )
 		}
 		toggleIconsAction->setText( enabled ? "Hide icons" : "Show icons" );
 	}
+	else if (mapPackModel)
+	{
+		mapPackModel->toggleIcons( enabled );
+		toggleIconsAction->setText( enabled ? "Hide icons" : "Show icons" );
+	}
 }
 
 void ExtendedTreeView::toggleIcons()
@@ -209,13 +219,19 @@ QString ExtendedTreeView::getCurrentFilePath() const
 	}
 
 
-	if (!fsModel)
+	if (mapPackModel)
+	{
+		return mapPackModel->filePath( currentIdx );
+	}
+	else if (fsModel)
+	{
+		return fsModel->filePath( currentIdx );
+	}
+	else
 	{
-		reportLogicError( u"getCurrentFilePath", "Unsupported model", "This action is only possible with QFileSystemModel." );
+		reportLogicError( u"getCurrentFilePath", "Unsupported model", "This action is only possible with a file-system model." );
 		return {};
 	}
-
-	return fsModel->filePath( currentIdx );
 }
 
 void ExtendedTreeView::openCurrentFile()
@@ -16,6 +16,7 @@
 #include <QTreeView>
 #include <QList>
 class QFileSystemModel;
+class MapPackTreeModel;
 
 
 //======================================================================================================================
@@ -113,6 +114,7 @@ class ExtendedTreeView : public QTreeView, public ExtendedViewCommon< ExtendedTr
  private: // internal members
 
 	QFileSystemModel * fsModel = nullptr;  ///< quick access to specialized file-system model
+	MapPackTreeModel * mapPackModel = nullptr;  ///< quick access to our own file-system model
 
  private: // configuration
 
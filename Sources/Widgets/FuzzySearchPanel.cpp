@@ -0,0 +1,73 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: line edit with a popup of ranked search results
+//======================================================================================================================
+
+#include "FuzzySearchPanel.hpp"
+
+#include <QString>
+#include <QLineEdit>
+#include <QCompleter>
+#include <QStringListModel>
+#include <QAbstractItemView>
+
+
+//======================================================================================================================
+
+FuzzySearchPanel::FuzzySearchPanel( QLineEdit * searchLine )
+:
+	searchLine( searchLine )
+{
+	resultModel = new QStringListModel( this );
+
+	// the results are already filtered and ordered by the owner, the completer must display them as they are
+	completer = new QCompleter( resultModel, this );
+	completer->setCompletionMode( QCompleter::UnfilteredPopupCompletion );
+	completer->setMaxVisibleItems( 15 );
+	searchLine->setCompleter( completer );
+
+	searchLine->setClearButtonEnabled( true );
+
+	connect( searchLine, &QLineEdit::textEdited, this, &ThisClass::searchPhraseChanged );
+	connect( searchLine, &QLineEdit::editingFinished, this, &ThisClass::onEditingFinished );
+	connect( completer, QOverload< const QModelIndex & >::of( &QCompleter::activated ), this, &ThisClass::onResultActivated );
+}
+
+void FuzzySearchPanel::setResults( const QStringList & resultTexts )
+{
+	resultModel->setStringList( resultTexts );
+
+	if (!resultTexts.isEmpty() && searchLine->hasFocus())
+		completer->complete();
+	else
+		completer->popup()->hide();
+}
+
+void FuzzySearchPanel::expand()
+{
+	searchLine->setVisible( true );
+	searchLine->setFocus();
+	searchLine->selectAll();
+}
+
+void FuzzySearchPanel::collapse()
+{
+	searchLine->clear();
+	resultModel->setStringList( {} );
+	searchLine->setVisible( false );
+}
+
+void FuzzySearchPanel::onResultActivated( const QModelIndex & index )
+{
+	// the completion mode is unfiltered, so the row is the same as in our list of results
+	emit resultChosen( index.row() );
+}
+
+void FuzzySearchPanel::onEditingFinished()
+{
+	// nothing to search for, no reason to occupy the space
+	if (searchLine->text().isEmpty() && !completer->popup()->isVisible())
+		collapse();
+}
@@ -0,0 +1,74 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: line edit with a popup of ranked search results
+//======================================================================================================================
+
+#ifndef FUZZY_SEARCH_PANEL_INCLUDED
+#define FUZZY_SEARCH_PANEL_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QObject>
+#include <QStringList>
+class QString;
+class QLineEdit;
+class QCompleter;
+class QStringListModel;
+class QModelIndex;
+
+
+//======================================================================================================================
+/// Line edit with a popup of ranked search results, for quickly finding an entry in a long list or tree.
+/** Unlike SearchPanel, this doesn't filter the view. The owner searches its own index whenever the phrase changes,
+  * passes the results back via setResults() and gets notified when the user chooses one of them. */
+
+class FuzzySearchPanel : public QObject {
+
+	Q_OBJECT
+
+	using ThisClass = FuzzySearchPanel;
+
+ public:
+
+	FuzzySearchPanel( QLineEdit * searchLine );
+	~FuzzySearchPanel() override = default;
+
+	/// Displays the texts of the results in the popup, in the given order.
+	void setResults( const QStringList & resultTexts );
+
+ public slots:
+
+	void expand();
+	void collapse();
+
+ signals:
+
+	void searchPhraseChanged( const QString & phrase );
+
+	/// Emitted when the user picks one of the results, \p resultIdx is the index into the last list of results.
+	void resultChosen( int resultIdx );
+
+ private slots:
+
+	void onResultActivated( const QModelIndex & index );
+	void onEditingFinished();
+
+ public:
+
+	QLineEdit * searchLine;
+
+ private:
+
+	QStringListModel * resultModel;
+	QCompleter * completer;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // FUZZY_SEARCH_PANEL_INCLUDED
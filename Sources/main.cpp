@@ -9,6 +9,7 @@
 #include "MainWindowPtr.hpp"
 #include "Themes.hpp"
 #include "Utils/StandardOutput.hpp"
+#include "Utils/WidgetUtils.hpp"  // showMessageBox
 
 #include <QApplication>
 #include <QDir>
@@ -21,6 +22,9 @@ int main( int argc, char * argv [] )
 {
 	QApplication a( argc, argv );
 
+	// the errors are displayed in message boxes from now on, until now they could only be logged
+	setMessageBoxFunc( wdg::showMessageBox );
+
 	// All stored relative paths are relative to the directory of this application,
 	// launching it from a different current working directory would break it.
 	QDir::setCurrent( QApplication::applicationDirPath() );
@@ -0,0 +1,15 @@
+#-------------------------------------------------
+#
+# The user interface code without main(), linked into the test executables that need it on top of the CoreLib
+#
+#-------------------------------------------------
+
+TARGET = AppLib
+
+TEMPLATE = lib
+CONFIG += staticlib
+QT += core gui widgets network
+CONFIG -= qml_debug
+
+include(../../DoomRunnerConfig.pri)
+include(../../DoomRunnerSources.pri)
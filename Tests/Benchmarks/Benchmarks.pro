@@ -0,0 +1,32 @@
+#-------------------------------------------------
+#
+# Micro-benchmarks of the performance-sensitive code, run the executable directly,
+# see the QTest documentation for the options (-iterations, -minimumvalue, -callgrind, ...)
+#
+#-------------------------------------------------
+
+TARGET = Benchmarks
+
+TEMPLATE = app
+QT += widgets network
+
+# some of the benchmarked code belongs to the user interface
+TEST_LIBS = AppLib CoreLib
+include(../TestCommon.pri)
+
+HEADERS += \
+	FileCacheWarmerBenchmark.hpp \
+	LaunchCommandBenchmark.hpp \
+	ListModelBenchmark.hpp \
+	MapSearchBenchmark.hpp \
+	PathConversionBenchmark.hpp \
+	ProcessStartBenchmark.hpp \
+
+SOURCES += \
+	FileCacheWarmerBenchmark.cpp \
+	LaunchCommandBenchmark.cpp \
+	ListModelBenchmark.cpp \
+	MapSearchBenchmark.cpp \
+	PathConversionBenchmark.cpp \
+	ProcessStartBenchmark.cpp \
+	main.cpp \
@@ -0,0 +1,186 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of pre-loading the game files into the operating system's cache
+//======================================================================================================================
+
+#include "FileCacheWarmerBenchmark.hpp"
+
+#include "Utils/FileCacheWarmer.hpp"
+
+#include <QTest>
+#include <QCoreApplication>
+#include <QProcess>
+#include <QDir>
+#include <QFile>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QThread>  // msleep
+
+#include <memory>
+#include <algorithm>  // min
+#include <cstdio>     // puts, fflush
+
+#if !IS_WINDOWS && !IS_MACOS
+	#include <fcntl.h>   // open, posix_fadvise
+	#include <unistd.h>  // fsync, close
+	#define CAN_EVICT true
+#else
+	#define CAN_EVICT false
+#endif
+
+
+//======================================================================================================================
+
+static const int gameFileCount = 50;
+static const qint64 gameFileSize = 256 * 1024;
+static const qint64 largeFileSize = 64 * 1024 * 1024;
+static const int readRepetitions = 5;
+
+static bool createFile( const QString & filePath, qint64 size )
+{
+	QFile file( filePath );
+	if (!file.open( QIODevice::WriteOnly ))
+		return false;
+
+	// not zeros, so that no file system can store it sparse or compressed
+	QByteArray chunk( 1024 * 1024, Qt::Uninitialized );
+	for (int i = 0; i < chunk.size(); ++i)
+		chunk[i] = char( i * 31 );
+
+	for (qint64 written = 0; written < size; written += chunk.size())
+		if (file.write( chunk.constData(), std::min( qint64( chunk.size() ), size - written ) ) < 0)
+			return false;
+	return true;
+}
+
+#if CAN_EVICT
+
+// Removes the file from the page cache, which doesn't require root privileges unlike dropping the whole cache.
+static bool evictFromCache( const QString & filePath )
+{
+	int fd = ::open( QFile::encodeName( filePath ).constData(), O_RDONLY | O_CLOEXEC );
+	if (fd < 0)
+		return false;
+
+	bool evicted = ::fsync( fd ) == 0  // the dirty pages would stay in the cache
+	            && posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED ) == 0;
+	::close( fd );
+	return evicted;
+}
+
+#endif // CAN_EVICT
+
+static bool readThrough( const QString & filePath )
+{
+	QFile file( filePath );
+	if (!file.open( QIODevice::ReadOnly ))
+		return false;
+
+	QByteArray buffer( 1024 * 1024, Qt::Uninitialized );
+	while (file.read( buffer.data(), buffer.size() ) > 0) {}
+	return true;
+}
+
+
+//======================================================================================================================
+
+void FileCacheWarmerBenchmark::initTestCase()
+{
+	QVERIFY( _dir.isValid() );
+
+	for (int i = 0; i < gameFileCount; ++i)
+	{
+		_gameFiles.append( QDir( _dir.path() ).filePath( QStringLiteral("mod%1.pk3").arg( i ) ) );
+		QVERIFY( createFile( _gameFiles.last(), gameFileSize ) );
+	}
+
+	_largeFile = QDir( _dir.path() ).filePath("large.wad");
+	QVERIFY( createFile( _largeFile, largeFileSize ) );
+}
+
+void FileCacheWarmerBenchmark::warmUpRequest_data()
+{
+	QTest::addColumn< bool >("alreadyWarmed");
+
+	QTest::newRow("first time") << false;
+	QTest::newRow("already warmed") << true;
+}
+
+void FileCacheWarmerBenchmark::warmUpRequest()
+{
+	QFETCH( bool, alreadyWarmed );
+
+	auto warmer = std::make_unique< FileCacheWarmer >();
+	if (alreadyWarmed)
+	{
+		warmer->warmUp( _gameFiles );
+		warmer->waitForDone();
+	}
+
+	QBENCHMARK {
+		if (!alreadyWarmed)
+			warmer = std::make_unique< FileCacheWarmer >();  // doesn't remember anything
+		warmer->warmUp( _gameFiles );
+		warmer->waitForDone();
+	}
+}
+
+void FileCacheWarmerBenchmark::engineFirstOutput_data()
+{
+	QTest::addColumn< bool >("warmUp");
+
+	QTest::newRow("cold") << false;
+	QTest::newRow("warmed up") << true;
+}
+
+void FileCacheWarmerBenchmark::engineFirstOutput()
+{
+ #if CAN_EVICT
+	QFETCH( bool, warmUp );
+
+	const QStringList engineFiles = QStringList{ _largeFile } + _gameFiles;
+
+	// Only the engine's start-up is measured, the warm-up happens while the user is still looking at the preset.
+	qint64 totalStartNs = 0;
+	for (int i = 0; i < readRepetitions; ++i)
+	{
+		for (const QString & filePath : engineFiles)
+			QVERIFY( evictFromCache( filePath ) );
+
+		if (warmUp)
+		{
+			FileCacheWarmer warmer;
+			warmer.warmUp( engineFiles );
+			warmer.waitForDone();
+			QThread::msleep( 500 );  // the kernel reads the files asynchronously
+		}
+
+		QProcess engine;
+		QElapsedTimer timer;
+		timer.start();
+		engine.start( QCoreApplication::applicationFilePath(), QStringList{ standInEngineArg } + engineFiles );
+		QVERIFY( engine.waitForReadyRead( 60'000 ) );
+		totalStartNs += timer.nsecsElapsed();
+
+		QVERIFY( engine.waitForFinished( 60'000 ) );
+		QCOMPARE( engine.exitCode(), 0 );
+	}
+
+	QTest::setBenchmarkResult( qreal( totalStartNs ) / readRepetitions / 1'000'000, QTest::WalltimeMilliseconds );
+ #else
+	QSKIP("a single file cannot be evicted from the cache on this system");
+ #endif
+}
+
+int FileCacheWarmerBenchmark::runStandInEngine( int argc, char * argv [] )
+{
+	for (int i = 2; i < argc; ++i)
+		if (!readThrough( QFile::decodeName( argv[i] ) ))
+			return 1;
+
+	std::puts( "game files loaded" );
+	std::fflush( stdout );
+	return 0;
+}
@@ -0,0 +1,61 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of pre-loading the game files into the operating system's cache
+//======================================================================================================================
+
+#ifndef FILE_CACHE_WARMER_BENCHMARK_INCLUDED
+#define FILE_CACHE_WARMER_BENCHMARK_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QObject>
+#include <QTemporaryDir>
+#include <QStringList>
+
+
+//======================================================================================================================
+
+/// Measures both sides of the warm-up: what it costs when a preset is selected and what it saves the engine later.
+/** The temporary directory must be on a real disk (set TMPDIR), on a RAM-backed file system there is nothing to save.
+  * The engine is played by this executable started with standInEngineArg, it loads the given files
+  * and only then prints its first line, like an engine does when it has loaded its WADs. */
+class FileCacheWarmerBenchmark : public QObject {
+
+	Q_OBJECT
+
+ public:
+
+	static constexpr const char * standInEngineArg = "--stand-in-engine";
+
+	/// Reads all the files given after standInEngineArg and prints a line, to be called from main().
+	static int runStandInEngine( int argc, char * argv [] );
+
+ private slots:
+
+	void initTestCase();
+
+	/// Time of the worker to process a request for a preset's files, the first time or when they are warmed already.
+	void warmUpRequest_data();
+	void warmUpRequest();
+
+	/// Time from starting the engine until its first output, when the game files were evicted from the cache,
+	/// with or without warming them up during the user's think time.
+	void engineFirstOutput_data();
+	void engineFirstOutput();
+
+ private:
+
+	QTemporaryDir _dir;
+	QStringList _gameFiles;
+	QString _largeFile;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // FILE_CACHE_WARMER_BENCHMARK_INCLUDED
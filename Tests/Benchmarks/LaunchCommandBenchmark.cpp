@@ -0,0 +1,88 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of the launch command generation
+//======================================================================================================================
+
+#include "LaunchCommandBenchmark.hpp"
+
+#include "Utils/FileSystemUtils.hpp"  // getAbsoluteParentDir
+
+#include <QTest>
+#include <QDir>
+
+
+//======================================================================================================================
+
+void LaunchCommandBenchmark::initTestCase()
+{
+	QVERIFY( _fixture.setUp() );
+}
+
+void LaunchCommandBenchmark::generateVerified()
+{
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily::ZDoom );
+	const QString workingDir = QDir::currentPath();
+	const LaunchCommandOptions opts = {
+		.selectedEngine = engine,
+		.exePathStyle = PathStyle::Absolute,
+		.runnersWorkingDir = workingDir,
+		.quotePaths = false,
+		.verifyPaths = true,
+	};
+	const LaunchCommandInput input = _fixture.makeFullInput();
+	LaunchCommandBuilder builder( opts );
+
+	QBENCHMARK {
+		LaunchCmdReport report;
+		os::ShellCommand cmd = builder.generate( input, report );
+		QVERIFY( !cmd.executable.isNull() );
+	}
+}
+
+void LaunchCommandBenchmark::generateAll()
+{
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily::ZDoom );
+	const QString engineExeDir = fs::getAbsoluteParentDir( engine.executablePath );
+	const LaunchCommandOptions opts = {
+		.selectedEngine = engine,
+		.exePathStyle = PathStyle::Relative,
+		.runnersWorkingDir = engineExeDir,
+		.quotePaths = true,
+		.verifyPaths = false,
+	};
+	const LaunchCommandInput input = _fixture.makeFullInput();
+	LaunchCommandBuilder builder( opts );
+
+	QBENCHMARK {
+		LaunchCmdReport report;
+		LaunchCmdSections sections;
+		builder.generateParts( input, LaunchCmdPart::All, sections, report );
+		os::ShellCommand cmd = LaunchCommandBuilder::joinParts( sections );
+	}
+}
+
+void LaunchCommandBenchmark::generateSinglePart()
+{
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily::ZDoom );
+	const QString engineExeDir = fs::getAbsoluteParentDir( engine.executablePath );
+	const LaunchCommandOptions opts = {
+		.selectedEngine = engine,
+		.exePathStyle = PathStyle::Relative,
+		.runnersWorkingDir = engineExeDir,
+		.quotePaths = true,
+		.verifyPaths = false,
+	};
+	const LaunchCommandInput input = _fixture.makeFullInput();
+	LaunchCommandBuilder builder( opts );
+
+	LaunchCmdReport report;
+	LaunchCmdSections sections;
+	builder.generateParts( input, LaunchCmdPart::All, sections, report );
+
+	QBENCHMARK {
+		builder.generateParts( input, LaunchCmdPart::Gameplay, sections, report );
+		os::ShellCommand cmd = LaunchCommandBuilder::joinParts( sections );
+	}
+}
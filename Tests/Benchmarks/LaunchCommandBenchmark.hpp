@@ -0,0 +1,44 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of the launch command generation
+//======================================================================================================================
+
+#ifndef LAUNCH_COMMAND_BENCHMARK_INCLUDED
+#define LAUNCH_COMMAND_BENCHMARK_INCLUDED
+
+
+#include "LaunchCommandFixture.hpp"
+
+#include <QObject>
+
+
+//======================================================================================================================
+
+class LaunchCommandBenchmark : public QObject {
+
+	Q_OBJECT
+
+ private slots:
+
+	void initTestCase();
+
+	/// What the launch costs: the whole command with all the paths verified.
+	void generateVerified();
+	/// What the displayed command costs when everything changes: the whole command without the verification.
+	void generateAll();
+	/// What the displayed command costs when the user changes a single option.
+	void generateSinglePart();
+
+ private:
+
+	LaunchCommandFixture _fixture;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // LAUNCH_COMMAND_BENCHMARK_INCLUDED
@@ -0,0 +1,235 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of the list models and their list implementations
+//======================================================================================================================
+
+#include "ListModelBenchmark.hpp"
+
+#include "DataModels/GenericListModel.hpp"
+#include "Widgets/ExtendedListView.hpp"
+#include "UserData.hpp"  // Preset, Mod
+#include "Themes.hpp"    // invalid entry color
+
+#include <QTest>
+#include <QCollator>
+#include <QPixmap>
+
+#include <iterator>  // size
+#include <vector>
+#include <algorithm>  // shuffle, max
+#include <random>
+
+
+//======================================================================================================================
+
+static const int presetCount = 20'000;
+
+static PtrList< Preset > makePresets()
+{
+	static const char * const kinds [] = { "Doom II map pack", "Heretic episode", "Hexen hub", "Doom 64 maps" };
+
+	PtrList< Preset > presets;
+	presets.reserve( presetCount );
+	for (int i = 0; i < presetCount; ++i)
+		presets.append( Preset( QStringLiteral("%1 %2").arg( kinds[ i % std::size(kinds) ] ).arg( i ) ) );
+	return presets;
+}
+
+static const int modCount = 10'000;
+
+static PtrList< Mod > makeMods()
+{
+	static const char * const suffixes [] = { ".pk3", ".wad", ".deh", "" };  // the one without suffix is asked whether it's a dir
+
+	PtrList< Mod > mods;
+	mods.reserve( modCount );
+	for (int i = 0; i < modCount; ++i)
+	{
+		Mod mod( QStringLiteral("Mods/mod%1%2").arg( i ).arg( suffixes[ i % std::size(suffixes) ] ) );
+		if (i % 50 == 0)
+		{
+			mod.isSeparator = true;
+			mod.name = QStringLiteral("Group %1").arg( i / 50 );
+		}
+		else if (i % 7 == 0)
+		{
+			mod.textColor = themes::getCurrentPalette().invalidEntryText;  // the same as a missing file
+		}
+		mods.append( std::move( mod ) );
+	}
+	return mods;
+}
+
+static const int mapFileCount = 5'000;
+
+/// Map files whose names differ in the numbers, in a random but repeatable order.
+static PtrList< Mod > makeShuffledMapFiles()
+{
+	std::vector< int > numbers( mapFileCount );
+	for (int i = 0; i < mapFileCount; ++i)
+		numbers[i] = i;
+	std::shuffle( numbers.begin(), numbers.end(), std::mt19937( 42 ) );
+
+	PtrList< Mod > mapFiles;
+	mapFiles.reserve( mapFileCount );
+	for (int number : numbers)
+		mapFiles.append( Mod( QStringLiteral("Maps/E%1M%2.wad").arg( number / 100 ).arg( number % 100 ) ) );
+	return mapFiles;
+}
+
+
+//======================================================================================================================
+
+void ListModelBenchmark::searchWhileTyping_data()
+{
+	QTest::addColumn< bool >("narrowing");
+	QTest::addColumn< bool >("caseSensitive");
+
+	QTest::newRow("narrowing, case-insensitive") << true << false;
+	QTest::newRow("full scan, case-insensitive") << false << false;
+	QTest::newRow("narrowing, case-sensitive") << true << true;
+	QTest::newRow("full scan, case-sensitive") << false << true;
+}
+
+void ListModelBenchmark::searchWhileTyping()
+{
+	QFETCH( bool, narrowing );
+	QFETCH( bool, caseSensitive );
+
+	FilteredList< Preset > list( makePresets() );
+	const QString phrase = caseSensitive ? "Doom II map" : "doom ii map";
+
+	QBENCHMARK {
+		for (qsize_t length = 1; length <= phrase.size(); ++length)
+		{
+			if (!narrowing)
+				list.restore();  // forgets the previous results, so the whole list is scanned again
+			list.search( phrase.left( length ), caseSensitive, /*useRegex*/ false );
+		}
+		QCOMPARE( list.size(), qsize_t( presetCount / 4 ) );
+		list.restore();
+	}
+}
+
+void ListModelBenchmark::repaintRows_data()
+{
+	QTest::addColumn< bool >("cached");
+
+	QTest::newRow("cached") << true;
+	QTest::newRow("invalidated") << false;
+}
+
+void ListModelBenchmark::repaintRows()
+{
+	QFETCH( bool, cached );
+
+	ReadOnlyDirectListModel< Mod > model( u"modModel", makeMods(), []( const Mod & mod ) { return mod.name; } );
+	model.toggleIcons( true );
+
+	static const int paintedRoles [] =
+	{
+		Qt::DisplayRole, Qt::DecorationRole, Qt::CheckStateRole, Qt::ForegroundRole, Qt::BackgroundRole, Qt::TextAlignmentRole
+	};
+
+	QBENCHMARK {
+		if (!cached)
+			model.invalidateDisplayCache();
+		for (int row = 0; row < model.rowCount(); ++row)
+		{
+			const QModelIndex index = model.index( row, 0 );
+			for (int role : paintedRoles)
+				model.data( index, role );
+		}
+	}
+}
+
+void ListModelBenchmark::paintListView_data()
+{
+	QTest::addColumn< bool >("cached");
+
+	QTest::newRow("cached") << true;
+	QTest::newRow("invalidated") << false;
+}
+
+void ListModelBenchmark::paintListView()
+{
+	QFETCH( bool, cached );
+
+	EditableDirectListModel< Mod > model( u"modModel", makeMods(), []( const Mod & mod ) { return mod.name; } );
+
+	// configured the same way as the mod list in the main window
+	ExtendedListView view( nullptr );
+	view.setModel( &model );
+	view.toggleHighVolumeMode( true );
+	view.toggleCheckboxes( true );
+	view.toggleIcons( true );
+	view.resize( 400, 600 );
+	view.doItemsLayout();
+
+	QPixmap canvas( view.viewport()->size() );
+	const int rowsPerPage = std::max( view.viewport()->height() / std::max( view.sizeHintForRow( 0 ), 1 ), 1 );
+
+	QBENCHMARK {
+		// scroll through the whole list page by page, like when holding the Page Down key
+		for (int row = 0; row < model.rowCount(); row += rowsPerPage)
+		{
+			if (!cached)
+				model.invalidateDisplayCache();
+			view.scrollTo( model.makeModelIndex( row ), QAbstractItemView::PositionAtTop );
+			view.viewport()->render( &canvas );
+		}
+	}
+}
+
+enum class SortMethod
+{
+	PlainComparison,
+	NaturalKey,
+	NaturalComparison,
+};
+
+void ListModelBenchmark::sortByID_data()
+{
+	QTest::addColumn< int >("method");
+
+	QTest::newRow("plain comparison") << int( SortMethod::PlainComparison );
+	QTest::newRow("natural key") << int( SortMethod::NaturalKey );
+	QTest::newRow("natural comparison") << int( SortMethod::NaturalComparison );
+}
+
+void ListModelBenchmark::sortByID()
+{
+	QFETCH( int, method );
+
+	const PtrList< Mod > unsorted = makeShuffledMapFiles();
+	DirectList< Mod > list;
+
+	QCollator collator;
+	collator.setNumericMode( true );
+	collator.setCaseSensitivity( Qt::CaseInsensitive );
+
+	QBENCHMARK {
+		list.updateList( unsorted );
+		switch (SortMethod( method ))
+		{
+		 case SortMethod::PlainComparison:
+			list.sortBy( []( const Mod & m1, const Mod & m2 ) { return m1.getID() < m2.getID(); } );
+			break;
+		 case SortMethod::NaturalKey:
+			list.sortByID();
+			break;
+		 case SortMethod::NaturalComparison:
+			list.sortBy( [&]( const Mod & m1, const Mod & m2 ) { return collator.compare( m1.getID(), m2.getID() ) < 0; } );
+			break;
+		}
+	}
+
+	if (SortMethod( method ) != SortMethod::PlainComparison)
+	{
+		QCOMPARE( list.first().getID(), QStringLiteral("Maps/E0M0.wad") );
+		QCOMPARE( list[1].getID(), QStringLiteral("Maps/E0M1.wad") );
+		QCOMPARE( list.last().getID(), QStringLiteral("Maps/E49M99.wad") );
+	}
+}
@@ -0,0 +1,51 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of the list models and their list implementations
+//======================================================================================================================
+
+#ifndef LIST_MODEL_BENCHMARK_INCLUDED
+#define LIST_MODEL_BENCHMARK_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QObject>
+
+
+//======================================================================================================================
+
+class ListModelBenchmark : public QObject {
+
+	Q_OBJECT
+
+ private slots:
+
+	/// Typing a phrase into the preset search, one search per keystroke,
+	/// either narrowing the previous results or scanning the whole list every time like before.
+	void searchWhileTyping_data();
+	void searchWhileTyping();
+
+	/// Asking the model for all the roles that a list view of mods paints, for every row,
+	/// either with the display cache of the model or with the cache invalidated before every repaint.
+	void repaintRows_data();
+	void repaintRows();
+
+	/// Painting a list view of mods configured like the one in the main window, scrolled through page by page,
+	/// either with the display cache of the model or with the cache invalidated before every page.
+	void paintListView_data();
+	void paintListView();
+
+	/// Sorting the items of a directory-updated list by their IDs, in the natural order via precomputed keys,
+	/// compared with the plain string comparison used before and with a natural comparison in each step.
+	void sortByID_data();
+	void sortByID();
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // LIST_MODEL_BENCHMARK_INCLUDED
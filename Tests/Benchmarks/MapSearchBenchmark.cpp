@@ -0,0 +1,112 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of searching in a large directory tree with map packs
+//======================================================================================================================
+
+#include "MapSearchBenchmark.hpp"
+
+#include "DataModels/MapPackTreeModel.hpp"
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <QStringBuilder>
+
+#include <algorithm>  // max
+
+
+//======================================================================================================================
+
+static const int dirCount = 500;
+static const int filesPerDir = 100;   // 50 000 files in total
+
+static const QStringList nameWords = {
+	"doom", "sigil", "plutonia", "evilution", "hell", "revealed", "alien", "vendetta", "scythe", "memento",
+	"mori", "eviternity", "sunlust", "ancient", "aliens", "valiant", "deus", "vult", "requiem", "hexen",
+};
+
+static QString makeName( int number )
+{
+	return nameWords[ number % nameWords.size() ] % '_' % nameWords[ (number / 7) % nameWords.size() ]
+	     % QStringLiteral("_%1").arg( number );
+}
+
+static const int scanTimeoutMs = 120'000;
+
+
+//======================================================================================================================
+
+MapSearchBenchmark::MapSearchBenchmark() = default;
+MapSearchBenchmark::~MapSearchBenchmark() = default;
+
+void MapSearchBenchmark::initTestCase()
+{
+	QVERIFY( _dir.isValid() );
+
+	QDir rootDir( _dir.path() );
+	for (int dirIdx = 0; dirIdx < dirCount; ++dirIdx)
+	{
+		QString dirName = makeName( dirIdx );
+		QVERIFY( rootDir.mkdir( dirName ) );
+		for (int fileIdx = 0; fileIdx < filesPerDir; ++fileIdx)
+		{
+			// not WADs, reading them would compete with the measured work
+			QFile file( rootDir.filePath( dirName % '/' % makeName( dirIdx * filesPerDir + fileIdx ) % ".pk3" ) );
+			QVERIFY( file.open( QIODevice::WriteOnly ) );
+		}
+	}
+
+	_model = std::make_unique< MapPackTreeModel >();
+	QSignalSpy indexUpdatedSpy( _model.get(), &MapPackTreeModel::searchIndexUpdated );
+	_model->setRootPath( _dir.path() );
+	QVERIFY( indexUpdatedSpy.wait( scanTimeoutMs ) );
+}
+
+void MapSearchBenchmark::scanTree()
+{
+	MapPackTreeModel model;
+	QSignalSpy indexUpdatedSpy( &model, &MapPackTreeModel::searchIndexUpdated );
+
+	QBENCHMARK {
+		model.setRootPath( _dir.path() );
+		QVERIFY( indexUpdatedSpy.wait( scanTimeoutMs ) );
+	}
+}
+
+void MapSearchBenchmark::typePhrase_data()
+{
+	QTest::addColumn< QString >("phrase");
+
+	QTest::newRow("exact words") << "sigil vendetta 31";
+	QTest::newRow("fuzzy") << "sgl vndt 31";
+	QTest::newRow("no match") << "xyzzy";
+}
+
+void MapSearchBenchmark::typePhrase()
+{
+	QFETCH( QString, phrase );
+
+	qint64 slowestKeyPressNs = 0;
+
+	for (qsize_t length = 1; length <= phrase.size(); ++length)
+	{
+		QElapsedTimer timer;
+		timer.start();
+
+		// the same as MainWindow::onMapSearchPhraseChanged()
+		const QStringList results = _model->searchEntries( phrase.left( length ), 50 );
+		if (!results.isEmpty())
+			(void)_model->index( _model->rootDirectory().filePath( results.first() ) );
+
+		slowestKeyPressNs = std::max( slowestKeyPressNs, timer.nsecsElapsed() );
+	}
+
+	_model->searchEntries( {}, 50 );  // start the next phrase from scratch
+
+	QTest::setBenchmarkResult( qreal( slowestKeyPressNs ) / 1'000'000, QTest::WalltimeMilliseconds );
+}
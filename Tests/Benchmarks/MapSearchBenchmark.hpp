@@ -0,0 +1,57 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of searching in a large directory tree with map packs
+//======================================================================================================================
+
+#ifndef MAP_SEARCH_BENCHMARK_INCLUDED
+#define MAP_SEARCH_BENCHMARK_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QObject>
+#include <QTemporaryDir>
+
+#include <memory>
+
+class MapPackTreeModel;
+
+
+//======================================================================================================================
+
+/// Measures the search over a map directory with 50 000 files, from the scan of the tree to the individual key presses.
+class MapSearchBenchmark : public QObject {
+
+	Q_OBJECT
+
+ public:
+
+	MapSearchBenchmark();
+	~MapSearchBenchmark() override;
+
+ private slots:
+
+	void initTestCase();
+
+	/// Time from setRootPath() until the whole tree is scanned and indexed.
+	void scanTree();
+
+	/// The slowest key press while typing the phrase character by character,
+	/// each key press searches the index and jumps to the best match like MainWindow does.
+	void typePhrase_data();
+	void typePhrase();
+
+ private:
+
+	QTemporaryDir _dir;
+	std::unique_ptr< MapPackTreeModel > _model;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // MAP_SEARCH_BENCHMARK_INCLUDED
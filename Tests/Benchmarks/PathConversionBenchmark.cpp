@@ -0,0 +1,106 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of the conversions between relative and absolute paths
+//======================================================================================================================
+
+#include "PathConversionBenchmark.hpp"
+
+#include "Utils/FileSystemUtils.hpp"  // PathBaseDir, PathConvertor
+
+#include <QTest>
+#include <QDir>
+#include <QStringList>
+#include <QStringBuilder>
+
+
+//======================================================================================================================
+
+static const int pathCount = 100'000;
+
+// doesn't need to exist, the conversions don't access the file system
+static const QString baseDirPath = IS_WINDOWS ? "C:/Games/Doom" : "/home/player/games/doom";
+
+/// Paths of files inside the base dir, or next to it when withDotDot is true.
+static QStringList makePaths( bool absolute, bool withDotDot )
+{
+	QString prefix = withDotDot ? "../Shared/" : "Mods/";
+	if (absolute)
+		prefix.prepend( baseDirPath % '/' );
+
+	QStringList paths;
+	paths.reserve( pathCount );
+	for (int i = 0; i < pathCount; ++i)
+		paths.append( prefix % QStringLiteral("pack%1/mod%2.pk3").arg( i / 100 ).arg( i ) );
+	return paths;
+}
+
+static void addRows()
+{
+	QTest::addColumn< bool >("precomputed");
+	QTest::addColumn< bool >("withDotDot");
+
+	QTest::newRow("PathBaseDir, inside") << true << false;
+	QTest::newRow("QDir, inside") << false << false;
+	QTest::newRow("PathBaseDir, with ..") << true << true;
+	QTest::newRow("QDir, with ..") << false << true;
+}
+
+
+//======================================================================================================================
+
+void PathConversionBenchmark::makePathAbsolute_data()
+{
+	addRows();
+}
+
+void PathConversionBenchmark::makePathAbsolute()
+{
+	QFETCH( bool, precomputed );
+	QFETCH( bool, withDotDot );
+
+	const QStringList paths = makePaths( /*absolute*/ false, withDotDot );
+	const PathBaseDir baseDir( baseDirPath );
+	const QDir qDir( baseDirPath );
+
+	// both must give the same results, otherwise the comparison makes no sense
+	QCOMPARE( baseDir.makePathAbsolute( paths.last() ), PathConvertor::makePathAbsolute( paths.last(), qDir ) );
+
+	QString result;
+	QBENCHMARK {
+		if (precomputed)
+			for (const QString & path : paths)
+				result = baseDir.makePathAbsolute( path );
+		else
+			for (const QString & path : paths)
+				result = PathConvertor::makePathAbsolute( path, qDir );
+	}
+}
+
+void PathConversionBenchmark::makePathRelative_data()
+{
+	addRows();
+}
+
+void PathConversionBenchmark::makePathRelative()
+{
+	QFETCH( bool, precomputed );
+	QFETCH( bool, withDotDot );
+
+	const QStringList paths = makePaths( /*absolute*/ true, withDotDot );
+	const PathBaseDir baseDir( baseDirPath );
+	const QDir qDir( baseDirPath );
+
+	QCOMPARE( baseDir.makePathRelative( paths.last() ), PathConvertor::makePathRelativeTo( paths.last(), qDir ) );
+
+	QString result;
+	QBENCHMARK {
+		if (precomputed)
+			for (const QString & path : paths)
+				result = baseDir.makePathRelative( path );
+		else
+			for (const QString & path : paths)
+				result = PathConvertor::makePathRelativeTo( path, qDir );
+	}
+}
@@ -0,0 +1,39 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of the conversions between relative and absolute paths
+//======================================================================================================================
+
+#ifndef PATH_CONVERSION_BENCHMARK_INCLUDED
+#define PATH_CONVERSION_BENCHMARK_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QObject>
+
+
+//======================================================================================================================
+
+/// Compares PathBaseDir, which converts the common paths by string operations, with the QDir algorithms used before.
+/** Each benchmark converts a batch of paths that either take the fast path or need the fallback because of "..". */
+class PathConversionBenchmark : public QObject {
+
+	Q_OBJECT
+
+ private slots:
+
+	void makePathAbsolute_data();
+	void makePathAbsolute();
+
+	void makePathRelative_data();
+	void makePathRelative();
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // PATH_CONVERSION_BENCHMARK_INCLUDED
@@ -0,0 +1,122 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of starting the engine process
+//======================================================================================================================
+
+#include "ProcessStartBenchmark.hpp"
+
+#include "Utils/OSUtils.hpp"  // spawnDetachedProcess, makeProcessEnvironment
+
+#include <QTest>
+#include <QCoreApplication>
+#include <QProcess>
+#include <QFile>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QThread>  // usleep
+
+#include <chrono>
+#include <cstdio>  // fopen, fprintf, rename
+
+
+//======================================================================================================================
+
+static const int startRepetitions = 20;
+
+/// Monotonic time that is comparable between processes, steady_clock uses CLOCK_MONOTONIC where it matters.
+static qint64 getMonotonicTimeNs()
+{
+	using namespace std::chrono;
+	return duration_cast< nanoseconds >( steady_clock::now().time_since_epoch() ).count();
+}
+
+/// Waits until the started process writes its start time, returns -1 on timeout.
+static qint64 waitForReportedTime( const QString & reportPath )
+{
+	QElapsedTimer timeout;
+	timeout.start();
+	while (timeout.elapsed() < 10'000)
+	{
+		QFile report( reportPath );
+		if (report.open( QIODevice::ReadOnly ))  // it's renamed into place only when complete
+			return report.readAll().trimmed().toLongLong();
+		QThread::usleep( 100 );
+	}
+	return -1;
+}
+
+
+//======================================================================================================================
+
+void ProcessStartBenchmark::initTestCase()
+{
+	QVERIFY( _dir.isValid() );
+}
+
+void ProcessStartBenchmark::startDetached_data()
+{
+	QTest::addColumn< bool >("spawnDirectly");
+
+	QTest::newRow("QProcess::startDetached") << false;
+	QTest::newRow("os::spawnDetachedProcess") << true;
+}
+
+void ProcessStartBenchmark::startDetached()
+{
+	QFETCH( bool, spawnDirectly );
+
+	if (spawnDirectly && !os::canSpawnDetachedProcess())
+		QSKIP("spawning processes directly is not supported on this system");
+
+	const QString executable = QCoreApplication::applicationFilePath();
+	const QString reportPath = QDir( _dir.path() ).filePath("startTime.txt");
+
+	// The same steps as in ProcessOutputWindow's startDetachedProcess(), from the click until the process runs.
+	qint64 totalStartNs = 0;
+	for (int i = 0; i < startRepetitions; ++i)
+	{
+		QFile::remove( reportPath );
+		const QStringList arguments = { startTimeReporterArg, reportPath };
+
+		const qint64 launchTime = getMonotonicTimeNs();
+		if (spawnDirectly)
+		{
+			QString error = os::spawnDetachedProcess( executable, arguments, {}, {} );
+			QVERIFY2( error.isEmpty(), qUtf8Printable( error ) );
+		}
+		else
+		{
+			QProcess process;
+			process.setProgram( executable );
+			process.setArguments( arguments );
+			process.setProcessEnvironment( os::makeProcessEnvironment( {} ) );
+			QVERIFY( process.startDetached() );
+		}
+
+		qint64 startTime = waitForReportedTime( reportPath );
+		QVERIFY( startTime > 0 );
+		totalStartNs += startTime - launchTime;
+	}
+
+	QTest::setBenchmarkResult( qreal( totalStartNs ) / startRepetitions / 1'000'000, QTest::WalltimeMilliseconds );
+}
+
+int ProcessStartBenchmark::runStartTimeReporter( int argc, char * argv [] )
+{
+	const qint64 startTime = getMonotonicTimeNs();  // first, so that the rest of this function is not measured
+
+	if (argc < 3)
+		return 1;
+
+	// write it under another name first, so that the benchmark never reads it incomplete
+	QByteArray reportPath = argv[2];
+	QByteArray tempPath = reportPath + ".tmp";
+	std::FILE * report = std::fopen( tempPath.constData(), "w" );
+	if (!report)
+		return 1;
+	std::fprintf( report, "%lld\n", static_cast< long long >( startTime ) );
+	std::fclose( report );
+	return std::rename( tempPath.constData(), reportPath.constData() ) == 0 ? 0 : 1;
+}
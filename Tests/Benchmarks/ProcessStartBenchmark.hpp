@@ -0,0 +1,51 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: micro-benchmarks of starting the engine process
+//======================================================================================================================
+
+#ifndef PROCESS_START_BENCHMARK_INCLUDED
+#define PROCESS_START_BENCHMARK_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QObject>
+#include <QTemporaryDir>
+
+
+//======================================================================================================================
+
+/// Compares how long it takes from the launch until the started process runs, with QProcess and with posix_spawn.
+/** The started process is this executable with startTimeReporterArg, it writes the time when its main() was entered
+  * into a file. Loading of its libraries is included, but it's the same for both ways of starting it. */
+class ProcessStartBenchmark : public QObject {
+
+	Q_OBJECT
+
+ public:
+
+	static constexpr const char * startTimeReporterArg = "--report-start-time";
+
+	/// Writes the current time into the file given after startTimeReporterArg, to be called from main().
+	static int runStartTimeReporter( int argc, char * argv [] );
+
+ private slots:
+
+	void initTestCase();
+
+	void startDetached_data();
+	void startDetached();
+
+ private:
+
+	QTemporaryDir _dir;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // PROCESS_START_BENCHMARK_INCLUDED
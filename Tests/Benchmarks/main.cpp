@@ -0,0 +1,60 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: runs all the micro-benchmarks
+//======================================================================================================================
+
+#include "LaunchCommandBenchmark.hpp"
+#include "ListModelBenchmark.hpp"
+#include "MapSearchBenchmark.hpp"
+#include "PathConversionBenchmark.hpp"
+#include "FileCacheWarmerBenchmark.hpp"
+#include "ProcessStartBenchmark.hpp"
+
+#include "MainWindowPtr.hpp"
+#include "Themes.hpp"
+
+#include <QApplication>
+#include <QTest>
+
+#include <cstring>  // strcmp
+
+
+// normally defined in the application's main.cpp, which is not a part of the AppLib
+QMainWindow * qMainWindow = nullptr;
+
+
+//======================================================================================================================
+
+template< typename BenchmarkClass >
+static int runBenchmark( int argc, char * argv [] )
+{
+	BenchmarkClass benchmark;
+	return QTest::qExec( &benchmark, argc, argv );
+}
+
+int main( int argc, char * argv [] )
+{
+	// Some benchmarks start this executable again in place of the engine.
+	if (argc >= 2 && std::strcmp( argv[1], FileCacheWarmerBenchmark::standInEngineArg ) == 0)
+		return FileCacheWarmerBenchmark::runStandInEngine( argc, argv );
+	if (argc >= 2 && std::strcmp( argv[1], ProcessStartBenchmark::startTimeReporterArg ) == 0)
+		return ProcessStartBenchmark::runStartTimeReporter( argc, argv );
+
+	// Some of the measured code works with the item colors and the palette, which need the GUI application.
+	// Use QT_QPA_PLATFORM=offscreen on a headless machine.
+	QApplication app( argc, argv );
+
+	themes::init();
+
+	int failedCount = 0;
+	failedCount += runBenchmark< LaunchCommandBenchmark >( argc, argv );
+	failedCount += runBenchmark< ListModelBenchmark >( argc, argv );
+	failedCount += runBenchmark< MapSearchBenchmark >( argc, argv );
+	failedCount += runBenchmark< PathConversionBenchmark >( argc, argv );
+	failedCount += runBenchmark< FileCacheWarmerBenchmark >( argc, argv );
+	failedCount += runBenchmark< ProcessStartBenchmark >( argc, argv );
+
+	return failedCount != 0 ? 1 : 0;
+}
@@ -0,0 +1,190 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: temporary directory with dummy engines and game files for generating launch commands
+//======================================================================================================================
+
+#include "LaunchCommandFixture.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QColor>
+
+
+//======================================================================================================================
+
+// names that EngineTraits recognize as the corresponding family, in the order of EngineFamily
+static const char * const engineExeNames [] =
+{
+	"gzdoom",
+	"chocolate-doom",
+	"prboom-plus",
+	"woof",
+	"edge-classic",
+	"doom_gog",
+};
+static_assert( std::size(engineExeNames) == size_t(EngineFamily::_EnumEnd), "Please update this table too" );
+
+static const char * const gameFiles [] =
+{
+	"Configs/engine.cfg",
+	"IWADs/DOOM2.WAD",
+	"Maps/mapset.wad",
+	"Mods/weapons.pk3",
+	"Mods/patch.deh",
+};
+
+static const char * const dataDirs [] =
+{
+	"Saves",
+	"Screenshots",
+	"Demos",
+};
+
+
+//======================================================================================================================
+
+LaunchCommandFixture::~LaunchCommandFixture()
+{
+	if (!_origWorkingDir.isEmpty())
+		QDir::setCurrent( _origWorkingDir );
+}
+
+bool LaunchCommandFixture::setUp()
+{
+	if (!_rootDir.isValid())
+		return false;
+
+	for (size_t i = 0; i < std::size(engineExeNames); ++i)
+		if (!createFile( engineExePath( EngineFamily(i) ) ))
+			return false;
+
+	for (const char * filePath : gameFiles)
+		if (!createFile( filePath ))
+			return false;
+
+	for (const char * dirPath : dataDirs)
+		if (!QDir( _rootDir.path() ).mkpath( dirPath ))
+			return false;
+
+	// the launcher also resolves the stored relative paths against its working directory
+	_origWorkingDir = QDir::currentPath();
+	if (!QDir::setCurrent( _rootDir.path() ))
+		return false;
+
+	_iwad = IWAD( QStringLiteral("IWADs/DOOM2.WAD") );
+
+	_mods.append( Mod( QStringLiteral("Mods/weapons.pk3") ) );  // a string literal would select Mod( bool )
+	_mods.append( Mod( QStringLiteral("Mods/patch.deh") ) );
+	Mod cmdArg( true );
+	cmdArg.isCmdArg = true;
+	cmdArg.name = "-noautoload";
+	_mods.append( std::move( cmdArg ) );
+	_mods.append( Mod( QStringLiteral("Mods/unchecked.pk3"), false ) );  // doesn't exist, but it's not used either
+
+	return true;
+}
+
+bool LaunchCommandFixture::createFile( const QString & relativePath, const QByteArray & content ) const
+{
+	QString filePath = QDir( _rootDir.path() ).filePath( relativePath );
+	if (!QDir().mkpath( QFileInfo( filePath ).path() ))
+		return false;
+
+	QFile file( filePath );
+	return file.open( QIODevice::WriteOnly ) && file.write( content ) == content.size();
+}
+
+QString LaunchCommandFixture::engineExePath( EngineFamily family )
+{
+	return QStringLiteral("Engines/") + engineExeNames[ size_t(family) ] + (IS_WINDOWS ? ".exe" : "");
+}
+
+EngineInfo LaunchCommandFixture::makeEngine( EngineFamily family )
+{
+	Engine engine( QFileInfo( engineExePath( family ) ) );
+	engine.name = familyToStr( family );
+	engine.family = family;
+
+	EngineInfo engineInfo( std::move( engine ) );
+	engineInfo.autoDetectTraits( engineInfo.executablePath );
+	engineInfo.setFamilyTraits( family );  // in case the auto-detection changes in the future
+	return engineInfo;
+}
+
+LaunchCommandInput LaunchCommandFixture::makeFullInput() const
+{
+	LaunchCommandInput input;
+
+	input.workingDir = QDir::currentPath();
+
+	input.configFilePath = "Configs/engine.cfg";
+
+	input.iwad = &_iwad;
+
+	input.selectedMapPacks = { "Maps/mapset.wad" };
+	input.mods = &_mods;
+
+	input.altSaveDir = "Saves";
+	input.altScreenshotDir = "Screenshots";
+
+	input.launchOpts.mode = LaunchMap;
+	input.launchOpts.mapName = "MAP07";
+	input.mapIdx = 6;
+	input.saveDir = "Saves";
+	input.demoDir = "Demos";
+
+	input.gameOpts.skillIdx = 4;
+	input.gameOpts.skillNum = 4;
+	input.gameOpts.fastMonsters = true;
+	input.gameOpts.pistolStart = true;
+	input.gameOpts.allowCheats = true;
+	input.gameOpts.dmflags1 = 4;
+
+	input.compatOpts.compatMode = 2;
+	input.compatOptsCmdArgs = QStringList{ "+compatflags", "4" };
+
+	input.multOpts.isMultiplayer = true;
+	input.multOpts.multRole = Server;
+	input.multOpts.gameMode = Deathmatch;
+	input.multOpts.playerCount = 2;
+	input.multOpts.timeLimit = 10;
+	input.multOpts.playerName = "Player";
+	input.multOpts.playerColor = QColor( 255, 0, 0 );
+
+	input.videoOpts.resolutionX = 1920;
+	input.videoOpts.resolutionY = 1080;
+	input.videoOpts.showFPS = true;
+
+	input.audioOpts.noMusic = true;
+
+	input.globalCmdArgs = "-nograbmouse";
+	input.presetCmdArgs = "-extratic";
+
+	return input;
+}
+
+QStringList LaunchCommandFixture::normalizeCommand( const os::ShellCommand & cmd ) const
+{
+	// The canonical path is longer when the temporary dir is behind a symlink (macOS), so it must be replaced first.
+	const QString rootPaths [] = { QDir( _rootDir.path() ).canonicalPath(), QDir( _rootDir.path() ).absolutePath() };
+
+	auto normalize = [&]( const QString & arg )
+	{
+		QString normalized = QDir::fromNativeSeparators( arg );
+		for (const QString & rootPath : rootPaths)
+			normalized.replace( rootPath, "<root>" );
+		return normalized;
+	};
+
+	QStringList lines;
+	QString executable = normalize( cmd.executable );
+	if (IS_WINDOWS && executable.endsWith(".exe"))
+		executable.chop( 4 );
+	lines << executable;
+	for (const QString & arg : cmd.arguments)
+		lines << normalize( arg );
+	return lines;
+}
@@ -0,0 +1,69 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: temporary directory with dummy engines and game files for generating launch commands
+//======================================================================================================================
+
+#ifndef LAUNCH_COMMAND_FIXTURE_INCLUDED
+#define LAUNCH_COMMAND_FIXTURE_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include "LaunchCommandBuilder.hpp"  // LaunchCommandInput, EngineInfo
+
+#include <QTemporaryDir>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+
+
+//======================================================================================================================
+
+/// Creates a directory tree with empty files that the generated commands refer to and makes it the working directory.
+/** All the paths in the input are relative to that directory, the same way as the launcher stores them. */
+class LaunchCommandFixture {
+
+ public:
+
+	LaunchCommandFixture() = default;
+	~LaunchCommandFixture();
+
+	/// Creates the files and switches the working directory. Returns false if any of that failed.
+	bool setUp();
+
+	/// Absolute path of the directory containing all the files.
+	QString rootDir() const   { return _rootDir.path(); }
+
+	/// Relative path of a dummy executable whose name is recognized as an engine of this family.
+	static QString engineExePath( EngineFamily family );
+
+	/// Engine of this family with its traits initialized the same way as when the user adds it.
+	static EngineInfo makeEngine( EngineFamily family );
+
+	/// Input that exercises every part of the command with options supported by at least one engine family.
+	LaunchCommandInput makeFullInput() const;
+
+	/// Creates a file at this path relative to the root directory, empty by default.
+	bool createFile( const QString & relativePath, const QByteArray & content = {} ) const;
+
+	/// Makes the output independent of the location of the temporary directory and of the path separators.
+	/** The root directory is replaced by "<root>" and the ".exe" suffix of the executable is removed. */
+	QStringList normalizeCommand( const os::ShellCommand & cmd ) const;
+
+ private:
+
+	QTemporaryDir _rootDir;
+	QString _origWorkingDir;
+
+	IWAD _iwad;
+	PtrList< Mod > _mods;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // LAUNCH_COMMAND_FIXTURE_INCLUDED
@@ -0,0 +1,15 @@
+#-------------------------------------------------
+#
+# The application code that doesn't depend on Qt Widgets, linked into all the test executables
+#
+#-------------------------------------------------
+
+TARGET = CoreLib
+
+TEMPLATE = lib
+CONFIG += staticlib
+QT = core gui
+CONFIG -= qml_debug
+
+include(../../DoomRunnerConfig.pri)
+include(../../DoomRunnerCoreSources.pri)
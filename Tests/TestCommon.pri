@@ -0,0 +1,43 @@
+#-------------------------------------------------
+#
+# Settings shared by the test executables
+#
+#-------------------------------------------------
+
+QT += core gui testlib
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qml_debug
+
+
+#-- application code -----------------------------
+
+# The application code is compiled only once into the static libraries and linked into the test executables.
+# Each executable lists the libraries it needs in TEST_LIBS, the ones depending on the others first (AppLib CoreLib).
+# The static libraries must precede the system libraries they depend on, so they are added before the build configuration.
+for(testLib, TEST_LIBS) {
+	win32 {
+		CONFIG(release, debug|release): TEST_LIB_DIR = $$OUT_PWD/../$$testLib/release
+		else: TEST_LIB_DIR = $$OUT_PWD/../$$testLib/debug
+	} else {
+		TEST_LIB_DIR = $$OUT_PWD/../$$testLib
+	}
+
+	LIBS += -L$$TEST_LIB_DIR -l$$testLib
+
+	win32-msvc*: PRE_TARGETDEPS += $$TEST_LIB_DIR/$${testLib}.lib
+	else: PRE_TARGETDEPS += $$TEST_LIB_DIR/lib$${testLib}.a
+}
+
+include(../DoomRunnerConfig.pri)
+
+
+#-- shared test code -----------------------------
+
+INCLUDEPATH += $$PWD/Common
+
+HEADERS += \
+	$$PWD/Common/LaunchCommandFixture.hpp \
+
+SOURCES += \
+	$$PWD/Common/LaunchCommandFixture.cpp \
@@ -0,0 +1,16 @@
+#-------------------------------------------------
+#
+# Unit tests and micro-benchmarks, built separately from the application
+#
+#-------------------------------------------------
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+	CoreLib \
+	AppLib \
+	UnitTests \
+	Benchmarks \
+
+UnitTests.depends = CoreLib
+Benchmarks.depends = CoreLib AppLib
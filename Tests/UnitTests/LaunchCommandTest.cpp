@@ -0,0 +1,230 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: tests of the launch command generation against the expected commands stored in files
+//======================================================================================================================
+
+#include "LaunchCommandTest.hpp"
+
+#include <QTest>
+#include <QDir>
+#include <QFile>
+#include <QStringBuilder>
+
+
+//======================================================================================================================
+
+static const char * const updateGoldenEnvVar = "DOOMRUNNER_UPDATE_GOLDEN";
+
+static LaunchCommandOptions makeOptions( const EngineInfo & engine, const QString & runnersWorkingDir, bool verifyPaths )
+{
+	// the same options as for the launch, except that the executable is relative to keep the golden files portable
+	return {
+		.selectedEngine = engine,
+		.exePathStyle = PathStyle::Relative,
+		.runnersWorkingDir = runnersWorkingDir,
+		.quotePaths = false,
+		.verifyPaths = verifyPaths,
+	};
+}
+
+static QString describeIssues( const LaunchCmdReport & report )
+{
+	QStringList messages;
+	for (const LaunchCmdIssue & issue : report.issues)
+		messages << issue.message;
+	return messages.join('\n');
+}
+
+
+//======================================================================================================================
+
+void LaunchCommandTest::initTestCase()
+{
+	QVERIFY( _fixture.setUp() );
+}
+
+void LaunchCommandTest::goldenOutput_data()
+{
+	QTest::addColumn< int >("family");
+
+	for (int family = 0; family < int(EngineFamily::_EnumEnd); ++family)
+		QTest::newRow( familyToStr( EngineFamily( family ) ) ) << family;
+}
+
+void LaunchCommandTest::goldenOutput()
+{
+	QFETCH( int, family );
+
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily( family ) );
+	const QString workingDir = QDir::currentPath();
+	const LaunchCommandOptions opts = makeOptions( engine, workingDir, true );
+
+	LaunchCmdReport report;
+	os::ShellCommand cmd = LaunchCommandBuilder( opts ).generate( _fixture.makeFullInput(), report );
+	QVERIFY2( report.issues.isEmpty(), qPrintable( describeIssues( report ) ) );
+
+	const QStringList actual = _fixture.normalizeCommand( cmd );
+
+	const QString goldenDir = QFINDTESTDATA("golden");
+	QVERIFY2( !goldenDir.isEmpty(), "The golden directory was not found next to the test sources." );
+	const QString goldenFilePath = goldenDir % '/' % familyToStr( EngineFamily( family ) ) % ".txt";
+	QFile goldenFile( goldenFilePath );
+
+	if (qEnvironmentVariableIsSet( updateGoldenEnvVar ))
+	{
+		QVERIFY2( goldenFile.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ), qPrintable( goldenFile.errorString() ) );
+		goldenFile.write( actual.join('\n').toUtf8() + '\n' );
+		qInfo().noquote() << "updated" << goldenFilePath;
+		return;
+	}
+
+	QVERIFY2( goldenFile.open( QIODevice::ReadOnly | QIODevice::Text ), qPrintable( goldenFilePath % ": " % goldenFile.errorString() ) );
+	const QStringList expected = QString::fromUtf8( goldenFile.readAll() ).split( '\n', Qt::SkipEmptyParts );
+
+	QCOMPARE( actual, expected );
+}
+
+void LaunchCommandTest::missingFileIsReported()
+{
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily::ZDoom );
+	const QString workingDir = QDir::currentPath();
+	const LaunchCommandOptions opts = makeOptions( engine, workingDir, true );
+
+	PtrList< Mod > mods;
+	mods.append( Mod( QStringLiteral("Mods/missing.pk3") ) );
+	LaunchCommandInput input = _fixture.makeFullInput();
+	input.mods = &mods;
+
+	LaunchCmdReport report;
+	os::ShellCommand cmd = LaunchCommandBuilder( opts ).generate( input, report );
+
+	QVERIFY( cmd.executable.isNull() );
+	QVERIFY( report.hasInvalidPaths() );
+	QCOMPARE( report.issues.size(), 1 );
+	QCOMPARE( report.issues[0].type, LaunchCmdIssue::InvalidPath );
+	QCOMPARE( report.issues[0].item, static_cast< const AModelItem * >( &mods[0] ) );
+	QVERIFY( report.issues[0].message.contains("Mods/missing.pk3") );
+	QVERIFY( report.verifiedItems.contains( &mods[0] ) );
+	QVERIFY( report.verifiedItems.contains( &engine ) );  // so that the caller can remove its old highlighting
+}
+
+void LaunchCommandTest::missingAltDirIsReported()
+{
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily::ZDoom );
+	const QString workingDir = QDir::currentPath();
+	const LaunchCommandOptions opts = makeOptions( engine, workingDir, true );
+
+	LaunchCommandInput input = _fixture.makeFullInput();
+	input.altSaveDir = "MissingSaves";
+
+	LaunchCmdReport report;
+	os::ShellCommand cmd = LaunchCommandBuilder( opts ).generate( input, report );
+
+	QVERIFY( cmd.executable.isNull() );
+	QCOMPARE( report.issues.size(), 1 );
+	QCOMPARE( report.issues[0].type, LaunchCmdIssue::InvalidPath );
+	QCOMPARE( report.issues[0].path, QStringLiteral("MissingSaves") );  // so that the caller can highlight the line it came from
+	QVERIFY( report.issues[0].item == nullptr );
+	QVERIFY( report.verifiedPaths.contains("MissingSaves") );
+	QVERIFY( report.verifiedPaths.contains("Screenshots") );
+}
+
+void LaunchCommandTest::existingDemoNeedsConfirmation()
+{
+	QVERIFY( _fixture.createFile("Demos/existing.lmp") );
+
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily::PrBoom );
+	const QString workingDir = QDir::currentPath();
+	const LaunchCommandOptions opts = makeOptions( engine, workingDir, true );
+
+	LaunchCommandInput input = _fixture.makeFullInput();
+	input.launchOpts.mode = RecordDemo;
+	input.launchOpts.demoFile_record = "existing";
+	input.launchOpts.mapName_demo = "MAP01";
+
+	LaunchCmdReport report;
+	os::ShellCommand cmd = LaunchCommandBuilder( opts ).generate( input, report );
+
+	QVERIFY( !cmd.executable.isNull() );  // overwriting is up to the user, the command is still valid
+	QCOMPARE( report.issues.size(), 1 );
+	QCOMPARE( report.issues[0].type, LaunchCmdIssue::FileExists );
+	QVERIFY( cmd.arguments.contains("-record") );
+}
+
+void LaunchCommandTest::invalidInputIsReported()
+{
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily::ZDoom );
+	const QString workingDir = QDir::currentPath();
+	const LaunchCommandOptions opts = makeOptions( engine, workingDir, false );
+
+	LaunchCommandInput input = _fixture.makeFullInput();
+	input.multOpts.gameMode = GameMode( 100 );
+
+	LaunchCmdReport report;
+	os::ShellCommand cmd = LaunchCommandBuilder( opts ).generate( input, report );
+
+	QVERIFY( !cmd.executable.isNull() );
+	QCOMPARE( report.issues.size(), 1 );
+	QCOMPARE( report.issues[0].type, LaunchCmdIssue::InvalidInput );
+}
+
+void LaunchCommandTest::bundleCycleIsReported()
+{
+	// the second bundle refers back to the first one by a different path, the cycle must be found anyway
+	QVERIFY( _fixture.createFile( "Mods/first.dmb", "second.dmb\nweapons.pk3\n" ) );
+	QVERIFY( _fixture.createFile( "Mods/second.dmb", "../Mods/./first.dmb\npatch.deh\n" ) );
+
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily::ZDoom );
+	const QString workingDir = QDir::currentPath();
+	const LaunchCommandOptions opts = makeOptions( engine, workingDir, true );
+
+	PtrList< Mod > mods;
+	mods.append( Mod( QStringLiteral("Mods/first.dmb") ) );
+	LaunchCommandInput input = _fixture.makeFullInput();
+	input.selectedMapPacks.clear();
+	input.mods = &mods;
+
+	LaunchCmdReport report;
+	os::ShellCommand cmd = LaunchCommandBuilder( opts ).generate( input, report );
+
+	QVERIFY( !cmd.executable.isNull() );  // the cycle is only a warning, the bundle is expanded once
+	QCOMPARE( report.issues.size(), 1 );
+	QCOMPARE( report.issues[0].type, LaunchCmdIssue::BundleCycle );
+	QVERIFY2( report.issues[0].message.contains("first.dmb"), qUtf8Printable( describeIssues( report ) ) );
+	QCOMPARE( cmd.arguments.filter("weapons.pk3").size(), 1 );
+	QCOMPARE( cmd.arguments.filter("patch.deh").size(), 1 );
+
+	// the cached expansion must still carry the cycle
+	LaunchCmdReport secondReport;
+	LaunchCommandBuilder( opts ).generate( input, secondReport );
+	QCOMPARE( secondReport.issues.size(), 1 );
+	QCOMPARE( secondReport.issues[0].type, LaunchCmdIssue::BundleCycle );
+}
+
+void LaunchCommandTest::partsAreGeneratedIndependently()
+{
+	const EngineInfo engine = LaunchCommandFixture::makeEngine( EngineFamily::ZDoom );
+	const QString workingDir = QDir::currentPath();
+	const LaunchCommandOptions opts = makeOptions( engine, workingDir, false );
+	LaunchCommandBuilder builder( opts );
+	LaunchCmdReport report;
+
+	LaunchCommandInput input = _fixture.makeFullInput();
+	LaunchCmdSections sections;
+	builder.generateParts( input, LaunchCmdPart::All, sections, report );
+
+	// only the changed part is regenerated, the rest of the sections is reused
+	input.audioOpts.noSound = true;
+	input.videoOpts = {};
+	builder.generateParts( input, LaunchCmdPart::Audio, sections, report );
+
+	// the video options were not regenerated, so they must still be there
+	LaunchCommandInput expectedInput = input;
+	expectedInput.videoOpts = _fixture.makeFullInput().videoOpts;
+	os::ShellCommand expected = builder.generate( expectedInput, report );
+
+	QCOMPARE( LaunchCommandBuilder::joinParts( sections ).arguments, expected.arguments );
+	QVERIFY( report.issues.isEmpty() );
+}
@@ -0,0 +1,51 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: tests of the launch command generation against the expected commands stored in files
+//======================================================================================================================
+
+#ifndef LAUNCH_COMMAND_TEST_INCLUDED
+#define LAUNCH_COMMAND_TEST_INCLUDED
+
+
+#include "LaunchCommandFixture.hpp"
+
+#include <QObject>
+
+
+//======================================================================================================================
+
+/// Compares the command generated for each EngineFamily with the golden file golden/<family>.txt.
+/** The golden file contains the executable and then one argument per line.
+  * When the change of the output is intended, run the test with DOOMRUNNER_UPDATE_GOLDEN=1 to rewrite the golden files
+  * and review the differences before committing them. */
+class LaunchCommandTest : public QObject {
+
+	Q_OBJECT
+
+ private slots:
+
+	void initTestCase();
+
+	void goldenOutput_data();
+	void goldenOutput();
+
+	void missingFileIsReported();
+	void missingAltDirIsReported();
+	void existingDemoNeedsConfirmation();
+	void invalidInputIsReported();
+	void bundleCycleIsReported();
+	void partsAreGeneratedIndependently();
+
+ private:
+
+	LaunchCommandFixture _fixture;
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // LAUNCH_COMMAND_TEST_INCLUDED
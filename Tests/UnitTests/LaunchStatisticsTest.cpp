@@ -0,0 +1,227 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: tests of the evaluation of the recorded launch statistics
+//======================================================================================================================
+
+#include "LaunchStatisticsTest.hpp"
+
+#include "LaunchStatistics.hpp"
+
+#include <QTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+
+
+//======================================================================================================================
+
+/// Writes the content into a new statistics file and reads the records back from it.
+static QList< LaunchRecord > readRecordsFrom( const QByteArray & content )
+{
+	QTemporaryDir dir;
+	if (!dir.isValid())
+	{
+		qWarning() << "cannot create a temporary directory";
+		return {};
+	}
+
+	QString filePath = QDir( dir.path() ).filePath("launch_stats.txt");
+	QFile file( filePath );
+	if (!file.open( QIODevice::WriteOnly ) || file.write( content ) != content.size())
+	{
+		qWarning() << "cannot write" << filePath;
+		return {};
+	}
+	file.close();
+
+	return readLaunchRecords( filePath );
+}
+
+
+//======================================================================================================================
+
+void LaunchStatisticsTest::percentilesOfNoValues()
+{
+	Percentiles result = computePercentiles( {} );
+
+	QCOMPARE( result.count, 0 );
+}
+
+void LaunchStatisticsTest::percentilesOfSingleValue()
+{
+	Percentiles result = computePercentiles( { 5 } );
+
+	QCOMPARE( result.count, 1 );
+	QCOMPARE( result.p50, qint64( 5 ) );
+	QCOMPARE( result.p90, qint64( 5 ) );
+	QCOMPARE( result.p99, qint64( 5 ) );
+	QCOMPARE( result.last, qint64( 5 ) );
+}
+
+void LaunchStatisticsTest::percentilesUseNearestRank()
+{
+	// the values are in the order of measurement, so they must be sorted, but the last one must stay the last measured
+	std::vector< qint64 > values;
+	for (qint64 value = 100; value >= 1; --value)
+		values.push_back( value );
+
+	Percentiles result = computePercentiles( values );
+
+	QCOMPARE( result.count, 100 );
+	QCOMPARE( result.p50, qint64( 50 ) );
+	QCOMPARE( result.p90, qint64( 90 ) );
+	QCOMPARE( result.p99, qint64( 99 ) );
+	QCOMPARE( result.last, qint64( 1 ) );
+
+	// ranks that are not whole numbers are rounded up
+	result = computePercentiles( { 10, 40, 20, 30 } );
+
+	QCOMPARE( result.p50, qint64( 20 ) );
+	QCOMPARE( result.p90, qint64( 40 ) );
+	QCOMPARE( result.p99, qint64( 40 ) );
+	QCOMPARE( result.last, qint64( 30 ) );
+}
+
+void LaunchStatisticsTest::missingFileHasNoRecords()
+{
+	QTemporaryDir dir;
+	QVERIFY( dir.isValid() );
+
+	QVERIFY( readLaunchRecords( QDir( dir.path() ).filePath("launch_stats.txt") ).isEmpty() );
+}
+
+void LaunchStatisticsTest::interleavedLinesAreMerged()
+{
+	// Two engines running at the same time, the exit of the second one was written before its start.
+	const QList< LaunchRecord > records = readRecordsFrom(
+		"S\ta\t100\t1500\tPreset A\tGZDoom\n"
+		"E\tb\t0\t60000\n"
+		"O\ta\t350\n"
+		"S\tb\t200\t2500\tPreset B\tWoof\n"
+		"E\ta\t-1\t1200\n"
+	);
+
+	QCOMPARE( records.size(), 2 );
+
+	const LaunchRecord & first = records[0];
+	QCOMPARE( first.launchID, QStringLiteral("a") );
+	QCOMPARE( first.launchTime, qint64( 100 ) );
+	QCOMPARE( first.presetName, QStringLiteral("Preset A") );
+	QCOMPARE( first.engineName, QStringLiteral("GZDoom") );
+	QCOMPARE( first.spawnTimeUs, qint64( 1500 ) );
+	QCOMPARE( first.firstOutputMs, qint64( 350 ) );
+	QVERIFY( first.exited );
+	QCOMPARE( first.exitCode, -1 );
+	QCOMPARE( first.sessionDurationMs, qint64( 1200 ) );
+
+	const LaunchRecord & second = records[1];
+	QCOMPARE( second.launchID, QStringLiteral("b") );
+	QCOMPARE( second.launchTime, qint64( 200 ) );
+	QCOMPARE( second.presetName, QStringLiteral("Preset B") );
+	QCOMPARE( second.spawnTimeUs, qint64( 2500 ) );
+	QCOMPARE( second.firstOutputMs, qint64( -1 ) );
+	QVERIFY( second.exited );
+	QCOMPARE( second.exitCode, 0 );
+	QCOMPARE( second.sessionDurationMs, qint64( 60000 ) );
+}
+
+void LaunchStatisticsTest::damagedLinesAreSkipped()
+{
+	const QList< LaunchRecord > records = readRecordsFrom(
+		"S\ta\t100\t1500\tPreset A\tGZDoom\r\n"      // written on Windows
+		"O\ta\n"                                      // truncated
+		"garbage\n"
+		"\n"
+		"E\tc\t0\t100\n"                              // the start line of this launch is missing
+		"S\td\t400\t700\tPreset C\tChocolate Doom\n"
+		"E\td\t0S\te\t500\t10\tPreset D\tWoof\n"      // the launcher was killed while writing the exit, the next start follows
+		"E\ta\t0\t5000\n"
+		"S\tf\t600\t12"                                // the launcher was killed while writing the last line
+	);
+
+	QCOMPARE( records.size(), 2 );
+
+	QCOMPARE( records[0].launchID, QStringLiteral("a") );
+	QCOMPARE( records[0].engineName, QStringLiteral("GZDoom") );
+	QCOMPARE( records[0].firstOutputMs, qint64( -1 ) );
+	QVERIFY( records[0].exited );
+	QCOMPARE( records[0].sessionDurationMs, qint64( 5000 ) );
+
+	QCOMPARE( records[1].launchID, QStringLiteral("d") );
+	QCOMPARE( records[1].engineName, QStringLiteral("Chocolate Doom") );
+	QVERIFY( !records[1].exited );
+}
+
+void LaunchStatisticsTest::launchesInSameMillisecondAreDistinct()
+{
+	QTemporaryDir dir;
+	QVERIFY( dir.isValid() );
+	QString filePath = QDir( dir.path() ).filePath("launch_stats.txt");
+
+	// constructed right after each other, so they have the same launch time most of the time
+	LaunchStatsRecorder first( filePath, "Preset A", "GZDoom" );
+	LaunchStatsRecorder second( filePath, "Preset A", "GZDoom" );
+	first.recordStart( 100 );
+	second.recordStart( 200 );
+	second.recordExit( 0, 5000 );
+
+	const QList< LaunchRecord > records = readLaunchRecords( filePath );
+
+	QCOMPARE( records.size(), 2 );
+	QVERIFY( records[0].launchID != records[1].launchID );
+	QCOMPARE( int( records[0].exited ) + int( records[1].exited ), 1 );
+}
+
+void LaunchStatisticsTest::rotatedFileIsMerged()
+{
+	QTemporaryDir dir;
+	QVERIFY( dir.isValid() );
+	QString filePath = QDir( dir.path() ).filePath("launch_stats.txt");
+
+	// the engine was still running when the file got rotated
+	QFile rotatedFile( getRotatedLaunchStatsFilePath( filePath ) );
+	QVERIFY( rotatedFile.open( QIODevice::WriteOnly ) );
+	rotatedFile.write( "S\ta\t100\t1500\tPreset A\tGZDoom\n" );
+	rotatedFile.close();
+	QFile file( filePath );
+	QVERIFY( file.open( QIODevice::WriteOnly ) );
+	file.write( "S\tb\t200\t2500\tPreset B\tWoof\nE\ta\t0\t60000\n" );
+	file.close();
+
+	const QList< LaunchRecord > records = readLaunchRecords( filePath );
+
+	QCOMPARE( records.size(), 2 );
+	QCOMPARE( records[0].launchID, QStringLiteral("a") );
+	QVERIFY( records[0].exited );
+	QCOMPARE( records[0].sessionDurationMs, qint64( 60000 ) );
+	QCOMPARE( records[1].launchID, QStringLiteral("b") );
+}
+
+void LaunchStatisticsTest::largeFileIsRotated()
+{
+	QTemporaryDir dir;
+	QVERIFY( dir.isValid() );
+	QString filePath = QDir( dir.path() ).filePath("launch_stats.txt");
+
+	QFile file( filePath );
+	QVERIFY( file.open( QIODevice::WriteOnly ) );
+	QByteArray oldLine = "S\told\t100\t1500\tPreset A\tGZDoom\n";
+	for (qint64 written = 0; written <= maxLaunchStatsFileSize; written += oldLine.size())
+		file.write( oldLine );
+	file.close();
+
+	LaunchStatsRecorder recorder( filePath, "Preset B", "Woof" );
+	recorder.recordStart( 200 );
+
+	QVERIFY( QFile::exists( getRotatedLaunchStatsFilePath( filePath ) ) );
+	QVERIFY( QFileInfo( filePath ).size() < oldLine.size() * 2 );
+
+	// the old records are still a part of the statistics
+	const QList< LaunchRecord > records = readLaunchRecords( filePath );
+	QCOMPARE( records.size(), 2 );
+	QCOMPARE( records[1].presetName, QStringLiteral("Preset B") );
+}
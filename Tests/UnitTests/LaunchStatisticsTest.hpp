@@ -0,0 +1,44 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: tests of the evaluation of the recorded launch statistics
+//======================================================================================================================
+
+#ifndef LAUNCH_STATISTICS_TEST_INCLUDED
+#define LAUNCH_STATISTICS_TEST_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QObject>
+
+
+//======================================================================================================================
+
+/// Tests the percentiles and the parsing of the statistics file, including the damaged lines that can appear in it.
+class LaunchStatisticsTest : public QObject {
+
+	Q_OBJECT
+
+ private slots:
+
+	void percentilesOfNoValues();
+	void percentilesOfSingleValue();
+	void percentilesUseNearestRank();
+
+	void missingFileHasNoRecords();
+	void interleavedLinesAreMerged();
+	void damagedLinesAreSkipped();
+
+	void launchesInSameMillisecondAreDistinct();
+	void rotatedFileIsMerged();
+	void largeFileIsRotated();
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // LAUNCH_STATISTICS_TEST_INCLUDED
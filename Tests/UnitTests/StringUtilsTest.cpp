@@ -0,0 +1,45 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: tests of the string helpers
+//======================================================================================================================
+
+#include "StringUtilsTest.hpp"
+
+#include "Utils/StringUtils.hpp"
+
+#include <QTest>
+
+
+//======================================================================================================================
+
+void StringUtilsTest::naturalSortKeyOrder_data()
+{
+	QTest::addColumn< QString >("smaller");
+	QTest::addColumn< QString >("greater");
+
+	QTest::newRow("single digits") << "MAP2" << "MAP3";
+	QTest::newRow("shorter number") << "MAP2" << "MAP10";
+	QTest::newRow("several numbers") << "E1M2" << "E1M10";
+	QTest::newRow("number before a letter") << "map1" << "mapa";
+	QTest::newRow("separator before a number") << "map-1" << "map1";
+	QTest::newRow("10 digits") << "shot999999999" << "shot1000000000";
+	QTest::newRow("timestamps") << "save20251018235959" << "save20251019000000";
+	QTest::newRow("hundreds of digits") << "hash" + QString( 120, '9' ) << "hash1" + QString( 120, '0' );
+	QTest::newRow("equal length") << "hash" + QString( 40, '1' ) << "hash" + QString( 40, '2' );
+}
+
+void StringUtilsTest::naturalSortKeyOrder()
+{
+	QFETCH( QString, smaller );
+	QFETCH( QString, greater );
+
+	QVERIFY( makeNaturalSortKey( smaller ) < makeNaturalSortKey( greater ) );
+}
+
+void StringUtilsTest::naturalSortKeyIgnoresCaseAndLeadingZeros()
+{
+	QCOMPARE( makeNaturalSortKey("Map007"), makeNaturalSortKey("MAP7") );
+	QVERIFY( makeNaturalSortKey("map0") < makeNaturalSortKey("map1") );  // a lone zero is a number too
+}
@@ -0,0 +1,37 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: tests of the string helpers
+//======================================================================================================================
+
+#ifndef STRING_UTILS_TEST_INCLUDED
+#define STRING_UTILS_TEST_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QObject>
+
+
+//======================================================================================================================
+
+/// Tests that the natural sort keys order the strings the same way as comparing the numbers by their values.
+class StringUtilsTest : public QObject {
+
+	Q_OBJECT
+
+ private slots:
+
+	void naturalSortKeyOrder_data();
+	void naturalSortKeyOrder();
+
+	void naturalSortKeyIgnoresCaseAndLeadingZeros();
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // STRING_UTILS_TEST_INCLUDED
@@ -0,0 +1,88 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: tests of the search index
+//======================================================================================================================
+
+#include "TrigramIndexTest.hpp"
+
+#include "Utils/TrigramIndex.hpp"
+#include "CommonTypes.hpp"  // qsize_t
+
+#include <QTest>
+#include <QStringList>
+
+
+//======================================================================================================================
+
+static const QStringList mapPackPaths = {
+	"Sigil/SIGIL_v1_21.wad",
+	"Sigil/SIGIL_II_V1_0.WAD",
+	"Plutonia/plutonia2.wad",
+	"sunlust/sunlust.wad",
+	"Scythe/scythe2.wad",
+	"Ancient Aliens/aaliens.wad",
+};
+
+static TrigramIndex makeIndex()
+{
+	TrigramIndex index;
+	for (const QString & path : mapPackPaths)
+		index.addEntry( path );
+	return index;
+}
+
+static QStringList searchTexts( TrigramIndex & index, const QString & phrase )
+{
+	QStringList texts;
+	for (const TrigramIndex::Match & match : index.search( phrase ))
+		texts.append( index.entryText( match.id ) );
+	return texts;
+}
+
+
+//======================================================================================================================
+
+void TrigramIndexTest::exactMatchesRankFirst()
+{
+	TrigramIndex index;
+	index.addEntry("mapset/monument.wad");   // contains the characters of "mom" only scattered
+	index.addEntry("mountain/moment.wad");
+
+	QCOMPARE( searchTexts( index, "mom" ), QStringList({ "mountain/moment.wad", "mapset/monument.wad" }) );
+}
+
+void TrigramIndexTest::fuzzyMatchNeedsCharactersInOrder()
+{
+	TrigramIndex index = makeIndex();
+
+	QCOMPARE( searchTexts( index, "snlst" ), QStringList{ "sunlust/sunlust.wad" } );
+	QCOMPARE( searchTexts( index, "scy2" ), QStringList{ "Scythe/scythe2.wad" } );
+	QVERIFY( searchTexts( index, "tsulns" ).isEmpty() );  // the same characters in a different order
+}
+
+void TrigramIndexTest::narrowingFindsSameAsNewSearch()
+{
+	const QString phrase = "sgl ii";
+
+	TrigramIndex typingIndex = makeIndex();
+	QStringList typedResults;
+	for (qsize_t length = 1; length <= phrase.size(); ++length)
+		typedResults = searchTexts( typingIndex, phrase.left( length ) );
+
+	TrigramIndex freshIndex = makeIndex();
+	QCOMPARE( typedResults, searchTexts( freshIndex, phrase ) );
+	QCOMPARE( typedResults, QStringList({ "Sigil/SIGIL_II_V1_0.WAD", "Sigil/SIGIL_v1_21.wad" }) );
+}
+
+void TrigramIndexTest::removedEntriesAreNotFound()
+{
+	TrigramIndex index = makeIndex();
+	QCOMPARE( searchTexts( index, "sunlust" ).size(), 1 );
+
+	index.removeEntry( 3 );  // sunlust
+
+	QVERIFY( searchTexts( index, "sunlust" ).isEmpty() );
+	QVERIFY( searchTexts( index, "snlst" ).isEmpty() );
+}
@@ -0,0 +1,37 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: tests of the search index
+//======================================================================================================================
+
+#ifndef TRIGRAM_INDEX_TEST_INCLUDED
+#define TRIGRAM_INDEX_TEST_INCLUDED
+
+
+#include "Essential.hpp"
+
+#include <QObject>
+
+
+//======================================================================================================================
+
+/// Tests the exact and the fuzzy matching, and that narrowing the previous results finds the same as a new search.
+class TrigramIndexTest : public QObject {
+
+	Q_OBJECT
+
+ private slots:
+
+	void exactMatchesRankFirst();
+	void fuzzyMatchNeedsCharactersInOrder();
+	void narrowingFindsSameAsNewSearch();
+	void removedEntriesAreNotFound();
+
+};
+
+
+//======================================================================================================================
+
+
+#endif // TRIGRAM_INDEX_TEST_INCLUDED
@@ -0,0 +1,36 @@
+#-------------------------------------------------
+#
+# Unit tests of the application code, run them with "make check"
+#
+#-------------------------------------------------
+
+TARGET = UnitTests
+
+TEMPLATE = app
+CONFIG += testcase
+
+# the tested code doesn't need the GUI
+TEST_LIBS = CoreLib
+include(../TestCommon.pri)
+
+HEADERS += \
+	LaunchCommandTest.hpp \
+	LaunchStatisticsTest.hpp \
+	StringUtilsTest.hpp \
+	TrigramIndexTest.hpp \
+
+SOURCES += \
+	LaunchCommandTest.cpp \
+	LaunchStatisticsTest.cpp \
+	StringUtilsTest.cpp \
+	TrigramIndexTest.cpp \
+	main.cpp \
+
+# expected launch commands of each engine family, see LaunchCommandTest.hpp
+DISTFILES += \
+	golden/ZDoom.txt \
+	golden/ChocolateDoom.txt \
+	golden/PrBoom.txt \
+	golden/MBF.txt \
+	golden/EDGE.txt \
+	golden/KEX.txt \
@@ -0,0 +1,37 @@
+//======================================================================================================================
+// Project: DoomRunner
+//----------------------------------------------------------------------------------------------------------------------
+// Author:      Jan Broz (Youda008)
+// Description: runs all the unit tests
+//======================================================================================================================
+
+#include "LaunchCommandTest.hpp"
+#include "LaunchStatisticsTest.hpp"
+#include "StringUtilsTest.hpp"
+#include "TrigramIndexTest.hpp"
+
+#include <QCoreApplication>
+#include <QTest>
+
+
+//======================================================================================================================
+
+template< typename TestClass >
+static int runTest( int argc, char * argv [] )
+{
+	TestClass test;
+	return QTest::qExec( &test, argc, argv );
+}
+
+int main( int argc, char * argv [] )
+{
+	QCoreApplication app( argc, argv );  // the tested code doesn't need the GUI, so the tests can run on a headless machine
+
+	int failedCount = 0;
+	failedCount += runTest< LaunchCommandTest >( argc, argv );
+	failedCount += runTest< LaunchStatisticsTest >( argc, argv );
+	failedCount += runTest< StringUtilsTest >( argc, argv );
+	failedCount += runTest< TrigramIndexTest >( argc, argv );
+
+	return failedCount != 0 ? 1 : 0;
+}